@@ -182,6 +182,35 @@ namespace ElectionGuard.Encryption.Tests
             Assert.That(result.IsValid);
         }
 
+        [Test]
+        public void Test_Encrypt_Ballots_Batch_Chains_Ballot_Codes_In_Order()
+        {
+            // Arrange
+            var random = new Random(1);
+            var data = ElectionGenerator.GenerateFakeElectionData();
+            var ballots = Enumerable.Range(0, 4)
+                .Select(_ => BallotGenerator.GetFakeBallot(data.InternalManifest))
+                .ToList();
+            var seed = random.NextElementModQ();
+
+            // Act
+            var ciphertexts = Encrypt.Ballots(
+                ballots, data.InternalManifest, data.Context, seed);
+
+            // Assert
+            Assert.That(ciphertexts.Count == ballots.Count);
+            for (var i = 0; i < ballots.Count; i++)
+            {
+                Assert.That(ciphertexts[i].ObjectId == ballots[i].ObjectId);
+                var expectedSeed = i == 0 ? seed : ciphertexts[i - 1].BallotCode;
+                Assert.That(ciphertexts[i].BallotCodeSeed.ToHex() == expectedSeed.ToHex());
+                Assert.That(ciphertexts[i].IsValidEncryption(
+                    data.Context.ManifestHash,
+                    data.Context.ElGamalPublicKey,
+                    data.Context.CryptoExtendedBaseHash));
+            }
+        }
+
         [Test]
         public void Test_Encrypt_Ballot_Undervote_Succeeds()
         {
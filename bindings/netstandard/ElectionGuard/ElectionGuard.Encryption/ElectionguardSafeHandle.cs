@@ -45,6 +45,16 @@ namespace ElectionGuard
             SetHandle((IntPtr)handle);
         }
 
+        // Take ownership of a pointer that was returned in an array
+        // since arrays of safe handles cannot be marshaled
+        internal static THandle FromOwnedPtr<THandle>(IntPtr ptr)
+            where THandle : ElectionGuardSafeHandle<T>, new()
+        {
+            var safeHandle = new THandle();
+            safeHandle.SetHandle(ptr);
+            return safeHandle;
+        }
+
         public unsafe T* TypedPtr => (T*)handle;
 
         public IntPtr Ptr => handle;
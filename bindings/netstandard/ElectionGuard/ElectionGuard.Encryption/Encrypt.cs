@@ -1,4 +1,8 @@
-﻿namespace ElectionGuard
+﻿using System;
+using System.Collections.Generic;
+using System.Linq;
+
+namespace ElectionGuard
 {
     /// <summary>
     /// Metadata for encryption
@@ -149,6 +153,48 @@
             }
         }
 
+        /// <summary>
+        /// Encrypt a batch of `Ballot`s in the context of a specific `CiphertextElectionContext`
+        ///
+        /// Each ballot is encrypted as with `Ballot` using a random nonce. The whole batch is passed
+        /// to the native library in a single call, encrypted concurrently on all cores and returned
+        /// in the order of the input. The first ballot is chained to the `ballotCodeSeed` and each
+        /// following ballot is chained to the ballot code of the one before it.
+        /// </summary>
+        /// <param name="ballots">the ballots in the valid input form</param>
+        /// <param name="internalManifest">the `InternalManifest` which defines the ballots' structure</param>
+        /// <param name="context">all the cryptographic context for the election</param>
+        /// <param name="ballotCodeSeed">Hash from previous ballot or hash from device</param>
+        /// <param name="shouldVerifyProofs">specify if the proofs should be verified prior to returning (default True)</param>
+        /// <param name="usePrecomputedValues">specify if precomputed values should be used (default False)</param>
+        /// <returns>A `CiphertextBallot` for each ballot in the order of the input</returns>
+        public static List<CiphertextBallot> Ballots(
+            IList<PlaintextBallot> ballots,
+            InternalManifest internalManifest,
+            CiphertextElectionContext context,
+            ElementModQ ballotCodeSeed,
+            bool shouldVerifyProofs = true,
+            bool usePrecomputedValues = false)
+        {
+            var plaintextPointers = ballots.Select(b => b.Handle.Ptr).ToArray();
+            var ciphertextPointers = new IntPtr[plaintextPointers.Length];
+            var status = NativeInterface.Encrypt.Ballots(
+                plaintextPointers,
+                (ulong)plaintextPointers.Length,
+                internalManifest.Handle,
+                context.Handle,
+                ballotCodeSeed.Handle,
+                shouldVerifyProofs,
+                usePrecomputedValues,
+                ciphertextPointers);
+            // the raw pointers do not keep the ballots' safe handles alive
+            GC.KeepAlive(ballots);
+            status.ThrowIfError();
+            return ciphertextPointers.Select(ptr => new CiphertextBallot(
+                CiphertextBallot.External.CiphertextBallotHandle.FromOwnedPtr<
+                    CiphertextBallot.External.CiphertextBallotHandle>(ptr))).ToList();
+        }
+
         /// <summary>
         /// Encrypt a specific `Ballot` in the context of a specific `CiphertextElectionContext`
         ///
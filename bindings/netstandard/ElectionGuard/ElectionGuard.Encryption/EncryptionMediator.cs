@@ -1,4 +1,8 @@
-﻿namespace ElectionGuard
+﻿using System;
+using System.Collections.Generic;
+using System.Linq;
+
+namespace ElectionGuard
 {
     /// <summary>
     /// An object for caching election and encryption state.
@@ -57,6 +61,29 @@
 
         }
 
+        /// <summary>
+        /// Encrypt a batch of ballots using the cached election context.
+        ///
+        /// The ballots are encrypted concurrently by the native library in a single call
+        /// and returned in the order of the input. The ballot codes are chained in that order.
+        /// </summary>
+        public List<CiphertextBallot> Encrypt(
+            IList<PlaintextBallot> plaintexts, bool verifyProofs = false, bool usePrecomputedValues = false)
+        {
+            var plaintextPointers = plaintexts.Select(p => p.Handle.Ptr).ToArray();
+            var ciphertextPointers = new IntPtr[plaintextPointers.Length];
+            var status = NativeInterface.EncryptionMediator.EncryptBallots(
+                Handle, plaintextPointers, (ulong)plaintextPointers.Length,
+                verifyProofs, usePrecomputedValues, ciphertextPointers);
+            // the raw pointers do not keep the ballots' safe handles alive
+            GC.KeepAlive(plaintexts);
+            GC.KeepAlive(this);
+            status.ThrowIfError();
+            return ciphertextPointers.Select(ptr => new CiphertextBallot(
+                CiphertextBallot.External.CiphertextBallotHandle.FromOwnedPtr<
+                    CiphertextBallot.External.CiphertextBallotHandle>(ptr))).ToList();
+        }
+
         /// <summary>
         /// Encrypt the specified ballot into its compact form using the cached election context.
         /// </summary>
@@ -2863,6 +2863,16 @@ namespace ElectionGuard
                 ElectionGuard.PlaintextBallot.External.PlaintextBallotHandle plaintext,
                 bool usePrecomputedValues,
                 out ElectionGuard.CiphertextBallot.External.CiphertextBallotHandle ciphertext);
+
+            [DllImport(DllName, EntryPoint = "eg_encryption_mediator_encrypt_ballots",
+                CallingConvention = CallingConvention.Cdecl, SetLastError = true)]
+            internal static extern Status EncryptBallots(
+                EncryptionMediatorHandle handle,
+                [MarshalAs(UnmanagedType.LPArray)] IntPtr[] plaintexts,
+                ulong plaintextsSize,
+                bool shouldVerifyProofs,
+                bool usePrecomputedValues,
+                [MarshalAs(UnmanagedType.LPArray), Out] IntPtr[] ciphertexts);
         }
 
         internal static class Encrypt
@@ -2914,6 +2924,18 @@ namespace ElectionGuard
                 bool shouldVerifyProofs,
                 out ElectionGuard.CiphertextBallot.External.CiphertextBallotHandle handle);
 
+            [DllImport(DllName, EntryPoint = "eg_encrypt_ballots",
+                CallingConvention = CallingConvention.Cdecl, SetLastError = true)]
+            internal static extern Status Ballots(
+                [MarshalAs(UnmanagedType.LPArray)] IntPtr[] plaintexts,
+                ulong plaintextsSize,
+                InternalManifest.InternalManifestHandle internal_manifest,
+                CiphertextElectionContext.CiphertextElectionContextHandle context,
+                ElementModQ.ElementModQHandle ballot_code_seed,
+                bool shouldVerifyProofs,
+                bool usePrecomputedValues,
+                [MarshalAs(UnmanagedType.LPArray), Out] IntPtr[] handles);
+
             [DllImport(DllName, EntryPoint = "eg_encrypt_compact_ballot",
                 CallingConvention = CallingConvention.Cdecl, SetLastError = true)]
             internal static extern Status CompactBallot(
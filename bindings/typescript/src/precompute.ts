@@ -2,23 +2,37 @@ import { ElementModP } from "./group";
 import { getInstance } from "./wasm";
 
 export class PrecomputeBufferContext {
-  static async clear(): Promise<void> {
-    (await getInstance()).PrecomputeBufferContext.clear();
+  static async clear(publicKey?: ElementModP): Promise<void> {
+    if (publicKey) {
+      (await getInstance()).PrecomputeBufferContext.clear(publicKey._handle);
+    } else {
+      (await getInstance()).PrecomputeBufferContext.clear();
+    }
   }
   static async initialize(
     publicKey: ElementModP,
-    maxQueueSize: number = 1000
+    maxQueueSize: number = 1000,
+    shouldAutoPopulate: boolean = false
   ): Promise<void> {
     (await getInstance()).PrecomputeBufferContext.initialize(
       publicKey._handle,
-      maxQueueSize
+      maxQueueSize,
+      shouldAutoPopulate
     );
   }
-  static async start(): Promise<void> {
-    (await getInstance()).PrecomputeBufferContext.start();
+  static async start(publicKey?: ElementModP): Promise<void> {
+    if (publicKey) {
+      (await getInstance()).PrecomputeBufferContext.start(publicKey._handle);
+    } else {
+      (await getInstance()).PrecomputeBufferContext.start();
+    }
   }
-  static async stop(): Promise<void> {
-    var result = (await getInstance()).PrecomputeBufferContext.stop();
+  static async stop(publicKey?: ElementModP): Promise<void> {
+    if (publicKey) {
+      (await getInstance()).PrecomputeBufferContext.stop(publicKey._handle);
+    } else {
+      (await getInstance()).PrecomputeBufferContext.stop();
+    }
   }
   static async getMaxQueueSize(): Promise<number> {
     var result = (
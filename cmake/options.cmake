@@ -11,6 +11,7 @@ option(TEST_USE_SAMPLE "the sample to use, full, hamilton-general, minimal, smal
 option(CODE_COVERAGE "Use code coverage" OFF)
 option(OPTION_GENERATE_DOCS "Generate documentation" OFF)
 option(USE_DYNAMIC_ANALYSIS "Enable Dynamic tools" OFF)
+set(LUT_WINDOW_SIZE 8 CACHE STRING "The fixed base lookup table window size in bits (4 to 12)")
 
 # Set a DEBUG definition
 if(CMAKE_BUILD_TYPE MATCHES Debug)
@@ -39,6 +40,11 @@ if(USE_32BIT_MATH)
     add_compile_definitions(USE_32BIT_MATH)
 endif()
 
+if(NOT LUT_WINDOW_SIZE EQUAL 8)
+    message("++ Using a ${LUT_WINDOW_SIZE}-bit fixed base lookup table window")
+    add_compile_definitions(EG_LUT_WINDOW_SIZE=${LUT_WINDOW_SIZE})
+endif()
+
 if(USE_TEST_PRIMES)
     message("++ Using Test Primes. Do not use in production.")
     add_compile_definitions(USE_TEST_PRIMES)
@@ -3,14 +3,21 @@
 
 #include "electionguard/export.h"
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
 #include <functional>
 #include <future>
 #include <memory>
 #include <mutex>
 #include <queue>
+#include <stdexcept>
+#include <thread>
+#include <vector>
 
 using std::atomic;
 using std::condition_variable;
@@ -82,20 +89,6 @@ namespace electionguard
         }
     }
 
-    template <typename T>
-    EG_INTERNAL_API vector<unique_ptr<T>> wait_all(vector<future<unique_ptr<T>>> &tasks)
-    {
-        vector<unique_ptr<T>> results;
-        do {
-            for (auto &task : tasks) {
-                if (isReady(task)) {
-                    results.push_back(std::move(task.get()));
-                }
-            }
-        } while (results.size() < tasks.size());
-        return results;
-    }
-
     /// <summary>
     /// A simple asynchronous thread safe queue using locks.
     /// </summary>
@@ -191,6 +184,139 @@ namespace electionguard
         }
     };
 
+    /// <summary>
+    /// A bounded lock-free multi-producer multi-consumer queue.
+    ///
+    /// Items are stored inline in a fixed ring of cells allocated once at
+    /// construction. Each cell carries a sequence number that tells producers
+    /// and consumers whether it is free to write or ready to read, so push and
+    /// pop only contend on a single atomic increment. T should be trivially
+    /// copyable since items are copied in and out of the ring.
+    ///
+    /// The sequence numbers cannot distinguish a full ring from an empty one
+    /// with a single cell, so the capacity is always at least two.
+    /// </summary>
+    template <typename T> class EG_INTERNAL_API AsyncRingBuffer
+    {
+      public:
+        explicit AsyncRingBuffer(size_t capacity)
+            : _capacity(std::max<size_t>(capacity, 2)), _cells(_makeCells(capacity))
+        {
+        }
+        AsyncRingBuffer(const AsyncRingBuffer &other) = delete;
+        AsyncRingBuffer(const AsyncRingBuffer &&other) = delete;
+
+        AsyncRingBuffer &operator=(AsyncRingBuffer other) = delete;
+        AsyncRingBuffer &operator=(AsyncRingBuffer &&other) = delete;
+
+        size_t capacity() const { return _capacity; }
+
+        /// <summary>
+        /// The approximate number of items in the ring.
+        /// Exact when there are no concurrent pushes or pops.
+        /// </summary>
+        size_t size() const
+        {
+            auto tail = _dequeuePosition.load(std::memory_order_acquire);
+            auto head = _enqueuePosition.load(std::memory_order_acquire);
+            return head > tail ? static_cast<size_t>(head - tail) : 0;
+        }
+
+        bool empty() const { return size() == 0; }
+
+        /// <summary>
+        /// Push a copy of the value onto the ring.
+        /// <returns>false if the ring is full</returns>
+        /// </summary>
+        bool push(const T &value)
+        {
+            auto position = _enqueuePosition.load(std::memory_order_relaxed);
+            Cell *cell;
+            for (;;) {
+                cell = &_cells[position % _capacity];
+                auto sequence = cell->sequence.load(std::memory_order_acquire);
+                auto diff = static_cast<int64_t>(sequence) - static_cast<int64_t>(position);
+                if (diff == 0) {
+                    if (_enqueuePosition.compare_exchange_weak(position, position + 1,
+                                                               std::memory_order_relaxed)) {
+                        break;
+                    }
+                } else if (diff < 0) {
+                    return false;
+                } else {
+                    position = _enqueuePosition.load(std::memory_order_relaxed);
+                }
+            }
+            cell->data = value;
+            cell->sequence.store(position + 1, std::memory_order_release);
+            return true;
+        }
+
+        /// <summary>
+        /// Pop the next value off of the ring into the provided value.
+        /// <returns>false if the ring is empty</returns>
+        /// </summary>
+        bool pop(T &value)
+        {
+            return pop(value, [](T &) {});
+        }
+
+        /// <summary>
+        /// Pop the next value off of the ring into the provided value and call
+        /// `clear` on the cell before it is handed back to the producers,
+        /// so values such as secret nonces do not stay in the ring after use.
+        /// <returns>false if the ring is empty</returns>
+        /// </summary>
+        template <typename Clear> bool pop(T &value, Clear &&clear)
+        {
+            auto position = _dequeuePosition.load(std::memory_order_relaxed);
+            Cell *cell;
+            for (;;) {
+                cell = &_cells[position % _capacity];
+                auto sequence = cell->sequence.load(std::memory_order_acquire);
+                auto diff = static_cast<int64_t>(sequence) - static_cast<int64_t>(position + 1);
+                if (diff == 0) {
+                    if (_dequeuePosition.compare_exchange_weak(position, position + 1,
+                                                               std::memory_order_relaxed)) {
+                        break;
+                    }
+                } else if (diff < 0) {
+                    return false;
+                } else {
+                    position = _dequeuePosition.load(std::memory_order_relaxed);
+                }
+            }
+            value = cell->data;
+            clear(cell->data);
+            cell->sequence.store(position + _capacity, std::memory_order_release);
+            return true;
+        }
+
+      private:
+        struct alignas(64) Cell {
+            std::atomic<uint64_t> sequence;
+            T data;
+        };
+
+        static std::unique_ptr<Cell[]> _makeCells(size_t capacity)
+        {
+            if (capacity == 0) {
+                throw std::invalid_argument("AsyncRingBuffer:: capacity must be greater than 0");
+            }
+            capacity = std::max<size_t>(capacity, 2);
+            auto cells = std::unique_ptr<Cell[]>(new Cell[capacity]);
+            for (size_t i = 0; i < capacity; i++) {
+                cells[i].sequence.store(i, std::memory_order_relaxed);
+            }
+            return cells;
+        }
+
+        const size_t _capacity;
+        std::unique_ptr<Cell[]> _cells;
+        alignas(64) std::atomic<uint64_t> _enqueuePosition = 0;
+        alignas(64) std::atomic<uint64_t> _dequeuePosition = 0;
+    };
+
     /// <summary>
     /// A generic wrapper around a callable type such as a function.
     /// </summary>
@@ -234,20 +360,37 @@ namespace electionguard
     };
 
     /// <summary>
-    /// A simple thread pool that uses a common work queue for all threads
+    /// A work stealing thread pool.
+    ///
+    /// Each worker owns a deque of tasks. Tasks submitted from a worker are pushed
+    /// onto that worker's deque and tasks submitted from other threads are spread
+    /// across the deques. A worker runs tasks from the back of its own deque and
+    /// when it is empty steals from the front of the other deques. Workers with
+    /// nothing to do are parked on a condition variable and do not use any cpu
+    /// until a task is submitted.
+    ///
+    /// Waiting on a future from inside a task with `wait` runs the tasks queued on
+    /// the worker since that task started, which includes every task it submitted,
+    /// until the future is ready. Tasks can wait on the tasks they submit without
+    /// exhausting the workers, and a waiting task never picks up unrelated work
+    /// that could hold it long after its own tasks are done.
     /// </summary>
     class EG_INTERNAL_API ThreadPool
     {
       public:
         ThreadPool(const std::uint_fast32_t &thread_count = std::thread::hardware_concurrency())
-            : _thread_count(thread_count)
+            : _thread_count(std::max<std::uint_fast32_t>(thread_count, 1))
         {
+            for (unsigned i = 0; i < _thread_count; ++i) {
+                _workers.push_back(std::make_unique<Worker>());
+            }
             try {
                 for (unsigned i = 0; i < _thread_count; ++i) {
-                    _threads.push_back(std::thread(&ThreadPool::worker, this));
+                    _workers[i]->thread = std::thread(&ThreadPool::worker, this, i);
+                    _workers[i]->id = _workers[i]->thread.get_id();
                 }
             } catch (...) {
-                _running = false;
+                shutdown();
                 throw;
             }
         }
@@ -255,53 +398,191 @@ namespace electionguard
         ThreadPool(const ThreadPool &other) = delete;
         ThreadPool(const ThreadPool &&other) = delete;
 
-        ~ThreadPool()
-        {
-            wait();
-            _running = false;
-            for (auto &thread : _threads) {
-                thread.join();
-            }
-        }
+        ~ThreadPool() { shutdown(); }
 
         ThreadPool &operator=(ThreadPool other) = delete;
         ThreadPool &operator=(ThreadPool &&other) = delete;
 
+        std::uint_fast32_t getThreadCount() const { return _thread_count; }
+
+        /// <summary>
+        /// Whether the calling thread is one of the pool's workers
+        /// </summary>
+        bool isWorkerThread() const { return currentWorkerIndex() >= 0; }
+
         template <typename F> std::future<typename std::result_of<F()>::type> submit(F callable)
         {
             typedef typename std::result_of<F()>::type result_type;
 
             std::packaged_task<result_type()> task(std::move(callable));
             std::future<result_type> result(task.get_future());
-            _taskQueue.push(std::move(task));
+
+            auto index = currentWorkerIndex();
+            if (index < 0) {
+                index = static_cast<int>(_nextWorker.fetch_add(1) % _thread_count);
+            }
+
+            // count the task before it is visible so the count never underflows
+            _pendingCount.fetch_add(1);
+            {
+                auto &worker = *_workers[index];
+                std::lock_guard<std::mutex> lock(worker.mutex);
+                worker.tasks.push_back({CallableWrapper(std::move(task)), worker.pushedCount++});
+            }
+            {
+                // synchronize with workers that are about to park
+                std::lock_guard<std::mutex> lock(_park_mutex);
+            }
+            _park_condition.notify_one();
             return result;
         }
 
+        /// <summary>
+        /// Block until the future is ready.
+        ///
+        /// When called from one of the pool's workers, the tasks queued on the
+        /// worker since the current task started are run on the calling thread
+        /// while waiting. Tasks queued before it, or on other workers, are left
+        /// for the other workers.
+        /// </summary>
+        template <typename T> void wait(const std::future<T> &task)
+        {
+            auto index = currentWorkerIndex();
+            if (index >= 0) {
+                while (!isReady(task)) {
+                    if (!tryRunOwnTask(index)) {
+                        // everything left is already running on other workers
+                        break;
+                    }
+                }
+            }
+            task.wait();
+        }
+
       private:
+        struct Task {
+            CallableWrapper callable;
+            // the number of tasks queued on the worker before this one
+            uint64_t sequence;
+        };
+
+        struct Worker {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+            std::thread thread;
+            std::thread::id id;
+            uint64_t pushedCount = 0;
+            // the pushed count when the task running on the worker started,
+            // only read and written by the worker's own thread
+            uint64_t runningSince = 0;
+        };
+
         std::uint_fast32_t _thread_count;
         std::atomic<bool> _running = true;
-        AsyncQueue<CallableWrapper> _taskQueue;
-        std::mutex queue_mutex = {};
-        std::vector<std::thread> _threads;
+        std::atomic<size_t> _pendingCount = 0;
+        std::atomic<size_t> _nextWorker = 0;
+        std::vector<std::unique_ptr<Worker>> _workers;
+        std::mutex _park_mutex;
+        std::condition_variable _park_condition;
 
-        void wait()
+        int currentWorkerIndex() const
         {
-            while (_running) {
-                if (_taskQueue.empty() == true) {
-                    break;
+            auto id = std::this_thread::get_id();
+            for (size_t i = 0; i < _workers.size(); i++) {
+                if (_workers[i]->id == id) {
+                    return static_cast<int>(i);
                 }
-                std::this_thread::yield();
             }
+            return -1;
         }
 
-        void worker()
+        bool tryRunPendingTask(size_t index)
         {
-            while (_running) {
-                CallableWrapper task;
-                if (_taskQueue.pop(task)) {
-                    task();
-                } else {
-                    std::this_thread::yield();
+            CallableWrapper task;
+            bool found = false;
+            {
+                auto &own = *_workers[index];
+                std::lock_guard<std::mutex> lock(own.mutex);
+                if (!own.tasks.empty()) {
+                    task = std::move(own.tasks.back().callable);
+                    own.tasks.pop_back();
+                    found = true;
+                }
+            }
+            for (size_t i = 1; !found && i < _workers.size(); i++) {
+                auto &victim = *_workers[(index + i) % _workers.size()];
+                std::lock_guard<std::mutex> lock(victim.mutex);
+                if (!victim.tasks.empty()) {
+                    task = std::move(victim.tasks.front().callable);
+                    victim.tasks.pop_front();
+                    found = true;
+                }
+            }
+            if (!found) {
+                return false;
+            }
+            run(index, task);
+            return true;
+        }
+
+        /// <summary>
+        /// Run the newest task queued on the worker if it was queued
+        /// after the task that is currently running on the worker started.
+        /// </summary>
+        bool tryRunOwnTask(size_t index)
+        {
+            CallableWrapper task;
+            {
+                auto &own = *_workers[index];
+                std::lock_guard<std::mutex> lock(own.mutex);
+                if (own.tasks.empty() || own.tasks.back().sequence < own.runningSince) {
+                    return false;
+                }
+                task = std::move(own.tasks.back().callable);
+                own.tasks.pop_back();
+            }
+            run(index, task);
+            return true;
+        }
+
+        void run(size_t index, CallableWrapper &task)
+        {
+            auto &own = *_workers[index];
+            auto previous = own.runningSince;
+            {
+                std::lock_guard<std::mutex> lock(own.mutex);
+                own.runningSince = own.pushedCount;
+            }
+            _pendingCount.fetch_sub(1);
+            task();
+            own.runningSince = previous;
+        }
+
+        void shutdown()
+        {
+            {
+                std::lock_guard<std::mutex> lock(_park_mutex);
+                _running = false;
+            }
+            _park_condition.notify_all();
+            for (auto &worker : _workers) {
+                if (worker->thread.joinable()) {
+                    worker->thread.join();
+                }
+            }
+        }
+
+        void worker(size_t index)
+        {
+            for (;;) {
+                if (tryRunPendingTask(index)) {
+                    continue;
+                }
+                std::unique_lock<std::mutex> lock(_park_mutex);
+                _park_condition.wait(lock, [this] { return _pendingCount > 0 || !_running; });
+                // finish the submitted tasks before exiting
+                if (!_running && _pendingCount == 0) {
+                    return;
                 }
             }
         }
@@ -322,16 +603,90 @@ namespace electionguard
             return instance;
         }
 
+        static std::uint_fast32_t getThreadCount() { return getInstance()._pool.getThreadCount(); }
+
+        /// <summary>
+        /// Whether the calling thread is running a scheduled task
+        /// </summary>
+        static bool isWorkerThread() { return getInstance()._pool.isWorkerThread(); }
+
         template <typename F> static std::future<typename std::result_of<F()>::type> submit(F task)
         {
             return getInstance()._pool.submit(task);
         }
 
+        /// <summary>
+        /// Block until the future is ready, running other scheduled
+        /// tasks if called from inside a scheduled task.
+        /// </summary>
+        template <typename T> static void wait(const std::future<T> &task)
+        {
+            getInstance()._pool.wait(task);
+        }
+
       private:
         Scheduler() {}
         ThreadPool _pool;
     };
 
+    /// <summary>
+    /// Block until all of the tasks complete and return their results in the
+    /// order of the tasks. If a task throws, the first exception is rethrown
+    /// once every task has completed.
+    /// </summary>
+    template <typename T> EG_INTERNAL_API vector<T> when_all(vector<future<T>> &tasks)
+    {
+        for (auto &task : tasks) {
+            Scheduler::wait(task);
+        }
+        vector<T> results;
+        results.reserve(tasks.size());
+        std::exception_ptr error = nullptr;
+        for (auto &task : tasks) {
+            try {
+                results.push_back(task.get());
+            } catch (...) {
+                if (error == nullptr) {
+                    error = std::current_exception();
+                }
+            }
+        }
+        if (error != nullptr) {
+            std::rethrow_exception(error);
+        }
+        return results;
+    }
+
+    /// <summary>
+    /// Block until all of the tasks complete. If a task throws, the first
+    /// exception is rethrown once every task has completed.
+    /// </summary>
+    inline void when_all(vector<future<void>> &tasks)
+    {
+        for (auto &task : tasks) {
+            Scheduler::wait(task);
+        }
+        std::exception_ptr error = nullptr;
+        for (auto &task : tasks) {
+            try {
+                task.get();
+            } catch (...) {
+                if (error == nullptr) {
+                    error = std::current_exception();
+                }
+            }
+        }
+        if (error != nullptr) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    template <typename T>
+    EG_INTERNAL_API vector<unique_ptr<T>> wait_all(vector<future<unique_ptr<T>>> &tasks)
+    {
+        return when_all(tasks);
+    }
+
 } // namespace electionguard
 
 #endif // __ELECTIONGUARD_CPP_ASYNC_HPP_INCLUDED__
@@ -253,6 +253,76 @@ EG_API bool eg_constant_chaum_pedersen_proof_is_valid(eg_constant_chaum_pedersen
 
 #endif
 
+#ifndef ChaumPedersenProof
+
+struct eg_chaum_pedersen_proof_s;
+
+/**
+* The Generic Chaum PedersenProof is a Non-Interactive Zero-Knowledge Proof
+* that represents the proof of knowing a secret value.
+*
+* The proof is used during decryption to prove that a guardian's share of the
+* decryption 𝑀 = 𝐴^𝑠 mod 𝑝 was computed with the secret matching its public key 𝐾 = 𝑔^𝑠 mod 𝑝.
+*
+* This object should not be made directly.  Use `eg_compute_decryption_shares`
+*/
+typedef struct eg_chaum_pedersen_proof_s eg_chaum_pedersen_proof_t;
+
+// No constructor provided.  Use `eg_compute_decryption_shares`
+
+EG_API eg_electionguard_status_t eg_chaum_pedersen_proof_free(eg_chaum_pedersen_proof_t *handle);
+
+/**
+ * a in the spec
+ * 
+ * @param[out] out_element_ref An opaque pointer to the ElementModP pad.  
+ *                           The value is a reference and is not owned by the caller
+ */
+EG_API eg_electionguard_status_t eg_chaum_pedersen_proof_get_pad(
+  eg_chaum_pedersen_proof_t *handle, eg_element_mod_p_t **out_element_ref);
+
+/**
+ * b in the spec
+ * 
+ * @param[out] out_element_ref An opaque pointer to the ElementModP data.  
+ *                           The value is a reference and is not owned by the caller
+ */
+EG_API eg_electionguard_status_t eg_chaum_pedersen_proof_get_data(
+  eg_chaum_pedersen_proof_t *handle, eg_element_mod_p_t **out_element_ref);
+
+/**
+ * c in the spec
+ * 
+ * @param[out] out_element_ref An opaque pointer to the ElementModQ challenge.  
+ *                           The value is a reference and is not owned by the caller
+ */
+EG_API eg_electionguard_status_t eg_chaum_pedersen_proof_get_challenge(
+  eg_chaum_pedersen_proof_t *handle, eg_element_mod_q_t **out_element_ref);
+
+/**
+ * v in the spec
+ * 
+ * @param[out] out_element_ref An opaque pointer to the ElementModQ response.  
+ *                           The value is a reference and is not owned by the caller
+ */
+EG_API eg_electionguard_status_t eg_chaum_pedersen_proof_get_response(
+  eg_chaum_pedersen_proof_t *handle, eg_element_mod_q_t **out_element_ref);
+
+/**
+ * Validates a Chaum-Pedersen proof of a share of a decryption.
+ *
+ * @param[in] in_message The ciphertext message
+ * @param[in] in_k The public key of the guardian
+ * @param[in] in_m The share of the decryption
+ * @param[in] in_q The extended base hash of the election
+ */
+EG_API bool eg_chaum_pedersen_proof_is_valid(eg_chaum_pedersen_proof_t *handle,
+                                             eg_elgamal_ciphertext_t *in_message,
+                                             eg_element_mod_p_t *in_k, eg_element_mod_p_t *in_m,
+                                             eg_element_mod_q_t *in_q);
+
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -6,7 +6,9 @@
 #include "group.hpp"
 #include "precompute_buffers.hpp"
 
+#include <functional>
 #include <memory>
+#include <vector>
 
 namespace electionguard
 {
@@ -145,9 +147,37 @@ namespace electionguard
         /// </Summary>
         bool isValid(const ElGamalCiphertext &message, const ElementModP &k, const ElementModQ &q);
 
+        /// <Summary>
+        /// Validates a batch of "disjunctive" Chaum-Pedersen (zero or one) proofs
+        /// that were all generated for the same public key and extended base hash.
+        ///
+        /// The verification equations of every proof are combined using small random
+        /// exponents and checked together. If the combined check fails, each proof
+        /// is validated on its own to identify the invalid ones.
+        ///
+        /// <param name="messages"> The ciphertext messages</param>
+        /// <param name="proofs"> The proofs, in the same order as the messages</param>
+        /// <param name="k"> The public key of the election</param>
+        /// <param name="q"> The extended base hash of the election</param>
+        /// <returns> The validity of each proof, in the same order as the proofs </returns>
+        /// </Summary>
+        static std::vector<bool>
+        isValidBatch(const std::vector<std::reference_wrapper<const ElGamalCiphertext>> &messages,
+                     const std::vector<std::reference_wrapper<DisjunctiveChaumPedersenProof>> &proofs,
+                     const ElementModP &k, const ElementModQ &q);
+
         std::unique_ptr<DisjunctiveChaumPedersenProof> clone() const;
 
       protected:
+        /// <Summary>
+        /// Check the verification equations of every proof combined with random exponents.
+        /// The residue, bounds and challenge checks must already have passed for each proof.
+        /// </Summary>
+        static bool
+        isValidCombined(const std::vector<std::reference_wrapper<const ElGamalCiphertext>> &messages,
+                        const std::vector<std::reference_wrapper<DisjunctiveChaumPedersenProof>> &proofs,
+                        const ElementModP &k);
+
         static std::unique_ptr<DisjunctiveChaumPedersenProof>
         make_zero(const ElGamalCiphertext &message, const ElementModQ &r, const ElementModP &k,
                   const ElementModQ &q);
@@ -11,10 +11,18 @@ enum MAX_IDENIFIER_LENGTH { MAX_IDENIFIER_LENGTH = 256 };
 enum MAX_P_LEN { MAX_P_LEN = 64, MAX_P_LEN_32 = 128 };
 enum MAX_Q_LEN { MAX_Q_LEN = 4, MAX_Q_LEN_32 = 8 };
 
-// values used for fixed-base exponentiation tables
-static const uint64_t LUT_WINDOW_SIZE = 8;
-static const uint64_t LUT_ORDER_BITS = 256;
-static const uint64_t LUT_TABLE_LENGTH = 32;
+// values used for fixed-base exponentiation tables.
+// the window size can be set at compile time with EG_LUT_WINDOW_SIZE (4 to 12 bits)
+#ifndef EG_LUT_WINDOW_SIZE
+#define EG_LUT_WINDOW_SIZE 8
+#endif
+// the table length is derived from the order bits with the preprocessor
+// because a static const is not a constant expression in C
+#define EG_LUT_ORDER_BITS 256
+static const uint64_t LUT_WINDOW_SIZE = EG_LUT_WINDOW_SIZE;
+static const uint64_t LUT_ORDER_BITS = EG_LUT_ORDER_BITS;
+static const uint64_t LUT_TABLE_LENGTH =
+  (EG_LUT_ORDER_BITS + EG_LUT_WINDOW_SIZE - 1) / EG_LUT_WINDOW_SIZE;
 
 static const uint8_t MAX_P_LEN_DOUBLE = 128;
 static const uint8_t MAX_Q_LEN_DOUBLE = 8;
@@ -23,6 +31,8 @@ static const uint32_t DEFAULT_PRECOMPUTE_SIZE = 5000;
 static const uint64_t DEFAULT_MAX_BALLOTS = 1000000;
 
 static const uint64_t DLOG_MAX_SIZE = 1000000;
+// the largest discrete log bound, which keeps the baby step table near 2^20 entries
+static const uint64_t DLOG_MAX_SIZE_LIMIT = 1ULL << 40;
 
 static const uint32_t MAX_P_SIZE = MAX_P_LEN * sizeof(uint64_t);
 static const uint32_t MAX_Q_SIZE = MAX_Q_LEN * sizeof(uint64_t);
@@ -0,0 +1,174 @@
+/// @file decrypt.h
+#ifndef __ELECTIONGUARD_CPP_DECRYPT_H_INCLUDED__
+#define __ELECTIONGUARD_CPP_DECRYPT_H_INCLUDED__
+
+#include "chaum_pedersen.h"
+#include "elgamal.h"
+#include "export.h"
+#include "group.h"
+#include "status.h"
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef DecryptionShare
+
+struct eg_decryption_share_s;
+
+/**
+* A guardian's share of the decryption of a ciphertext and the proof
+* that the share was computed with the guardian's secret key.
+*
+* This object should not be made directly.  Use `eg_compute_decryption_shares`
+*/
+typedef struct eg_decryption_share_s eg_decryption_share_t;
+
+// No constructor provided.  Use `eg_compute_decryption_shares`
+
+EG_API eg_electionguard_status_t eg_decryption_share_free(eg_decryption_share_t *handle);
+
+/**
+ * The partial decryption M = A^s mod p
+ * 
+ * @param[out] out_element_ref An opaque pointer to the ElementModP share.  
+ *                           The value is a reference and is not owned by the caller
+ */
+EG_API eg_electionguard_status_t eg_decryption_share_get_share(
+  eg_decryption_share_t *handle, eg_element_mod_p_t **out_element_ref);
+
+/**
+ * The proof that the share was computed with the guardian's secret key
+ * 
+ * @param[out] out_proof_ref An opaque pointer to the proof.  
+ *                           The value is a reference and is not owned by the caller
+ */
+EG_API eg_electionguard_status_t eg_decryption_share_get_proof(
+  eg_decryption_share_t *handle, eg_chaum_pedersen_proof_t **out_proof_ref);
+
+#endif
+
+/**
+* Compute a guardian's partial decryption of a batch of ciphertext pads on all cores.
+* The pads of elgamal and hashed elgamal ciphertexts can be mixed.
+*
+* @param[in] in_pads the pads of the ciphertexts
+* @param[in] in_pads_size the number of pads
+* @param[in] in_secret_key the guardian's secret key share
+* @param[out] out_handles a caller allocated array of `in_pads_size` handles that is filled
+*                         with an `eg_element_mod_p_t` for each pad.
+*                         Caller is responsible for the lifecycle of each handle.
+*/
+EG_API eg_electionguard_status_t eg_compute_partial_decryptions(
+  eg_element_mod_p_t *in_pads[], uint64_t in_pads_size, eg_element_mod_q_t *in_secret_key,
+  eg_element_mod_p_t *out_handles[]);
+
+/**
+* Compute a guardian's share of the decryption of a batch of ciphertexts, such as every
+* selection of a tally or of a set of spoiled ballots, along with the proof of each share.
+* The ciphertexts are decrypted on all cores.
+*
+* @param[in] in_ciphertexts the ciphertexts to decrypt
+* @param[in] in_ciphertexts_size the number of ciphertexts
+* @param[in] in_secret_key the guardian's secret key share
+* @param[in] in_seed the seed the nonce of each proof is derived from
+* @param[in] in_crypto_extended_base_hash the extended base hash of the election
+* @param[out] out_handles a caller allocated array of `in_ciphertexts_size` handles that is filled
+*                         with an `eg_decryption_share_t` for each ciphertext.
+*                         Caller is responsible for the lifecycle of each handle.
+*/
+EG_API eg_electionguard_status_t eg_compute_decryption_shares(
+  eg_elgamal_ciphertext_t *in_ciphertexts[], uint64_t in_ciphertexts_size,
+  eg_element_mod_q_t *in_secret_key, eg_element_mod_q_t *in_seed,
+  eg_element_mod_q_t *in_crypto_extended_base_hash, eg_decryption_share_t *out_handles[]);
+
+/**
+* Compute an available guardian's compensated shares of the decryption of a batch of
+* ciphertexts on behalf of each missing guardian, along with the proof of each share.
+* The ciphertexts are decrypted on all cores.
+*
+* @param[in] in_ciphertexts the ciphertexts to decrypt
+* @param[in] in_ciphertexts_size the number of ciphertexts
+* @param[in] in_backups the backup of each missing guardian for the available guardian
+* @param[in] in_backups_size the number of missing guardians
+* @param[in] in_seed the seed the nonce of each proof is derived from
+* @param[in] in_crypto_extended_base_hash the extended base hash of the election
+* @param[out] out_handles a caller allocated array of `in_backups_size` * `in_ciphertexts_size`
+*                         handles that is filled with an `eg_decryption_share_t` for every
+*                         ciphertext of the first missing guardian, followed by those of the next.
+*                         Caller is responsible for the lifecycle of each handle.
+*/
+EG_API eg_electionguard_status_t eg_compute_compensated_decryption_shares(
+  eg_elgamal_ciphertext_t *in_ciphertexts[], uint64_t in_ciphertexts_size,
+  eg_element_mod_q_t *in_backups[], uint64_t in_backups_size, eg_element_mod_q_t *in_seed,
+  eg_element_mod_q_t *in_crypto_extended_base_hash, eg_decryption_share_t *out_handles[]);
+
+/**
+* Compute the recovery public key of each missing guardian for each available guardian
+* from the commitments to the missing guardians' polynomials. The pairs are evaluated on all cores.
+*
+* @param[in] in_commitments the `in_quorum` commitments of the first missing guardian,
+*                           followed by those of the next
+* @param[in] in_missing_size the number of missing guardians
+* @param[in] in_quorum the number of commitments of each missing guardian
+* @param[in] in_sequence_orders the sequence orders of the available guardians
+* @param[in] in_sequence_orders_size the number of available guardians
+* @param[out] out_handles a caller allocated array of `in_missing_size` *
+*                         `in_sequence_orders_size` handles that is filled with an
+*                         `eg_element_mod_p_t` for every available guardian of the first
+*                         missing guardian, followed by those of the next.
+*                         Caller is responsible for the lifecycle of each handle.
+*/
+EG_API eg_electionguard_status_t eg_compute_recovery_public_keys(
+  eg_element_mod_p_t *in_commitments[], uint64_t in_missing_size, uint64_t in_quorum,
+  uint64_t *in_sequence_orders, uint64_t in_sequence_orders_size,
+  eg_element_mod_p_t *out_handles[]);
+
+#ifndef LagrangeCoefficients
+
+/**
+* Get the lagrange coefficient of each available guardian. The coefficients of a set of
+* guardians are computed once and cached for the next time the same set decrypts.
+*
+* @param[in] in_sequence_orders the sequence orders of the available guardians
+* @param[in] in_sequence_orders_size the number of available guardians
+* @param[out] out_handles a caller allocated array of `in_sequence_orders_size` handles that is
+*                         filled with an `eg_element_mod_q_t` for each guardian in the same order.
+*                         Caller is responsible for the lifecycle of each handle.
+*/
+EG_API eg_electionguard_status_t eg_lagrange_coefficients_get(uint64_t *in_sequence_orders,
+                                                              uint64_t in_sequence_orders_size,
+                                                              eg_element_mod_q_t *out_handles[]);
+
+/**
+* Forget the lagrange coefficients of every guardian set
+*/
+EG_API eg_electionguard_status_t eg_lagrange_coefficients_clear();
+
+#endif
+
+/**
+* Combine the decryption shares of the available guardians into the decryption of every
+* ciphertext in a batch, such as every selection of a tally. The ciphertexts are combined
+* on all cores and each result can be passed to `eg_elgamal_ciphertext_decrypt_known_product`.
+*
+* @param[in] in_sequence_orders the sequence orders of the available guardians
+* @param[in] in_guardians_size the number of available guardians
+* @param[in] in_shares the shares of every ciphertext from the first guardian, followed by
+*                      those of the next guardian, for `in_guardians_size` *
+*                      `in_ciphertexts_size` shares in all
+* @param[in] in_ciphertexts_size the number of ciphertexts
+* @param[out] out_handles a caller allocated array of `in_ciphertexts_size` handles that is filled
+*                         with an `eg_element_mod_p_t` for each ciphertext.
+*                         Caller is responsible for the lifecycle of each handle.
+*/
+EG_API eg_electionguard_status_t eg_combine_decryption_shares(
+  uint64_t *in_sequence_orders, uint64_t in_guardians_size, eg_element_mod_p_t *in_shares[],
+  uint64_t in_ciphertexts_size, eg_element_mod_p_t *out_handles[]);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* __ELECTIONGUARD_CPP_DECRYPT_H_INCLUDED__ */
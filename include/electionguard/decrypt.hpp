@@ -0,0 +1,210 @@
+#ifndef __ELECTIONGUARD_CPP_DECRYPT_HPP_INCLUDED__
+#define __ELECTIONGUARD_CPP_DECRYPT_HPP_INCLUDED__
+
+#include "chaum_pedersen.hpp"
+#include "elgamal.hpp"
+#include "export.h"
+#include "group.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <shared_mutex>
+#include <vector>
+
+namespace electionguard
+{
+    /// <summary>
+    /// A guardian's share of the decryption of a ciphertext and the proof
+    /// that the share was computed with the guardian's secret key.
+    ///
+    /// computes: 𝑀𝑖 = 𝐴^𝑠𝑖 mod 𝑝 proven against 𝐾𝑖 = 𝑔^𝑠𝑖 mod 𝑝
+    ///
+    /// This object should not be made directly.  Use `computeDecryptionShares`
+    /// </summary>
+    class EG_API DecryptionShare
+    {
+      public:
+        DecryptionShare(const DecryptionShare &other);
+        DecryptionShare(DecryptionShare &&other);
+        DecryptionShare(std::unique_ptr<ElementModP> share,
+                        std::unique_ptr<ChaumPedersenProof> proof);
+        ~DecryptionShare();
+
+        DecryptionShare &operator=(DecryptionShare other);
+        DecryptionShare &operator=(DecryptionShare &&other);
+
+        /// <summary>
+        /// The partial decryption 𝑀𝑖 = 𝐴^𝑠𝑖 mod 𝑝
+        /// </summary>
+        ElementModP *getShare() const;
+
+        /// <summary>
+        /// The proof that the share was computed with the guardian's secret key
+        /// </summary>
+        ChaumPedersenProof *getProof() const;
+
+      private:
+        class Impl;
+#pragma warning(suppress : 4251)
+        std::unique_ptr<Impl> pimpl;
+    };
+
+    /// <summary>
+    /// Compute a guardian's partial decryption 𝐴^𝑠𝑖 mod 𝑝 of a batch of ciphertext pads.
+    ///
+    /// The secret key is recoded into fixed width windows once and the recoding is reused
+    /// for every pad, and the pads are split across the library scheduler.
+    /// The pads of `ElGamalCiphertext` and `HashedElGamalCiphertext` can be mixed.
+    ///
+    /// <param name="pads">the pads of the ciphertexts to partially decrypt</param>
+    /// <param name="secretKey">the guardian's secret key share</param>
+    /// <returns>the partial decryptions in the order of the input</returns>
+    /// </summary>
+    EG_API std::vector<std::unique_ptr<ElementModP>>
+    computePartialDecryptions(const std::vector<std::reference_wrapper<const ElementModP>> &pads,
+                              const ElementModQ &secretKey);
+
+    /// <summary>
+    /// Compute a guardian's share of the decryption of a batch of ciphertexts,
+    /// such as every selection of a tally or of a set of spoiled ballots,
+    /// along with the proof of each share.
+    ///
+    /// The secret key is recoded into fixed width windows once and the recoding is reused
+    /// for every ciphertext. Each pad builds a single table of its powers that is used for
+    /// both the share and the commitment of its proof, and the ciphertexts are split
+    /// across the library scheduler.
+    ///
+    /// The proof of the ciphertext at index 𝑖 is the same as `ChaumPedersenProof::make`
+    /// called with the seed `Nonces(seed).get(𝑖)`.
+    ///
+    /// <param name="ciphertexts">the ciphertexts to decrypt</param>
+    /// <param name="secretKey">the guardian's secret key share</param>
+    /// <param name="seed">the seed the nonce of each proof is derived from</param>
+    /// <param name="cryptoExtendedBaseHash">the extended base hash of the election (𝑄')</param>
+    /// <returns>the shares in the order of the input</returns>
+    /// </summary>
+    EG_API std::vector<std::unique_ptr<DecryptionShare>> computeDecryptionShares(
+      const std::vector<std::reference_wrapper<const ElGamalCiphertext>> &ciphertexts,
+      const ElementModQ &secretKey, const ElementModQ &seed,
+      const ElementModQ &cryptoExtendedBaseHash);
+
+    /// <summary>
+    /// Compute an available guardian's compensated shares of the decryption of a batch of
+    /// ciphertexts on behalf of each missing guardian, along with the proof of each share.
+    ///
+    /// The backup of a missing guardian is its secret polynomial evaluated at the available
+    /// guardian's sequence order 𝑃𝑚(𝑎), and the compensated share is 𝑀𝑚𝑎 = 𝐴^𝑃𝑚(𝑎) mod 𝑝.
+    /// The proof of a compensated share is checked against the recovery public key from
+    /// `computeRecoveryPublicKeys`. Each pad builds a single table of its powers that is
+    /// used for every missing guardian, and the ciphertexts are split across the library
+    /// scheduler.
+    ///
+    /// The shares of the missing guardian at index 𝑚 are the same as `computeDecryptionShares`
+    /// called with its backup and the seed `Nonces(seed).get(𝑚)`. Combine the compensated
+    /// shares of the available guardians with `combineDecryptionShares` to recover the
+    /// shares of the missing guardian.
+    ///
+    /// <param name="ciphertexts">the ciphertexts to decrypt</param>
+    /// <param name="backups">the backup 𝑃𝑚(𝑎) of each missing guardian</param>
+    /// <param name="seed">the seed the nonce of each proof is derived from</param>
+    /// <param name="cryptoExtendedBaseHash">the extended base hash of the election (𝑄')</param>
+    /// <returns>for each missing guardian, the shares in the order of the ciphertexts</returns>
+    /// </summary>
+    EG_API std::vector<std::vector<std::unique_ptr<DecryptionShare>>>
+    computeCompensatedDecryptionShares(
+      const std::vector<std::reference_wrapper<const ElGamalCiphertext>> &ciphertexts,
+      const std::vector<std::reference_wrapper<const ElementModQ>> &backups,
+      const ElementModQ &seed, const ElementModQ &cryptoExtendedBaseHash);
+
+    /// <summary>
+    /// Compute the recovery public key 𝐾𝑚𝑎 = Π 𝐾𝑚𝑗^(𝑎^𝑗) mod 𝑝 of each missing guardian
+    /// for each available guardian from the commitments 𝐾𝑚𝑗 to the missing guardian's
+    /// polynomial. The recovery key is the public key of the backup 𝑃𝑚(𝑎).
+    ///
+    /// Each commitment builds a single table of its powers that is used for every available
+    /// guardian, the powers 𝑎^𝑗 are computed once for every missing guardian and the
+    /// commitment polynomial is evaluated once per pair with a single simultaneous
+    /// exponentiation. The pairs are split across the library scheduler.
+    ///
+    /// <param name="commitments">for each missing guardian, the commitments to the
+    ///                           coefficients of its polynomial in order</param>
+    /// <param name="sequenceOrders">the sequence orders of the available guardians</param>
+    /// <returns>for each missing guardian, the recovery public key of each available guardian
+    ///          in the order of the sequence orders</returns>
+    /// </summary>
+    EG_API std::vector<std::vector<std::unique_ptr<ElementModP>>> computeRecoveryPublicKeys(
+      const std::vector<std::vector<std::reference_wrapper<const ElementModP>>> &commitments,
+      const std::vector<uint64_t> &sequenceOrders);
+
+    /// <summary>
+    /// The lagrange coefficients of the guardians available to decrypt.
+    ///
+    /// The coefficient 𝑤𝑖 = Π 𝑗 / (𝑗 - 𝑖) over the other available guardians 𝑗 only depends
+    /// on the sequence orders of the set, so the coefficients of a set are computed once,
+    /// with a single modular inverse shared by every guardian, and cached for the next time
+    /// the same set decrypts.
+    /// </summary>
+    class EG_API LagrangeCoefficients
+    {
+      public:
+        LagrangeCoefficients(const LagrangeCoefficients &) = delete;
+        LagrangeCoefficients(LagrangeCoefficients &&) = delete;
+        LagrangeCoefficients &operator=(const LagrangeCoefficients &) = delete;
+        LagrangeCoefficients &operator=(LagrangeCoefficients &&other) = delete;
+
+      private:
+        LagrangeCoefficients() {}
+        ~LagrangeCoefficients() {}
+
+      public:
+        static LagrangeCoefficients &getInstance()
+        {
+            static LagrangeCoefficients instance;
+            return instance;
+        }
+
+        /// <summary>
+        /// Get the lagrange coefficient of each available guardian, in the order of the input.
+        /// Safe to call from multiple threads.
+        /// Throws invalid_argument if a sequence order is zero or appears more than once.
+        ///
+        /// <param name="sequenceOrders">the sequence orders of the available guardians</param>
+        /// </summary>
+        static std::vector<ElementModQ> get(const std::vector<uint64_t> &sequenceOrders);
+
+        /// <summary>
+        /// Forget the coefficients of every guardian set
+        /// </summary>
+        static void clear();
+
+      protected:
+        static std::vector<ElementModQ> compute(const std::vector<uint64_t> &sortedOrders);
+
+      private:
+        std::shared_mutex mutex;
+#pragma warning(suppress : 4251)
+        std::map<std::vector<uint64_t>, std::vector<ElementModQ>> cache;
+    };
+
+    /// <summary>
+    /// Combine the decryption shares of the available guardians into the decryption
+    /// 𝑀 = Π 𝑀𝑖^𝑤𝑖 mod 𝑝 of every ciphertext in a batch, such as every selection of a tally.
+    ///
+    /// The lagrange coefficients come from `LagrangeCoefficients`, the shares of each
+    /// ciphertext are combined with a single `multi_pow_mod_p` and the ciphertexts are
+    /// split across the library scheduler. Pass the result to `ElGamalCiphertext::decrypt`.
+    ///
+    /// <param name="sequenceOrders">the sequence orders of the available guardians</param>
+    /// <param name="shares">for each available guardian in the same order, its share
+    ///                      of every ciphertext of the batch</param>
+    /// <returns>the decryption of each ciphertext in the order of the shares</returns>
+    /// </summary>
+    EG_API std::vector<std::unique_ptr<ElementModP>> combineDecryptionShares(
+      const std::vector<uint64_t> &sequenceOrders,
+      const std::vector<std::vector<std::reference_wrapper<const ElementModP>>> &shares);
+
+} // namespace electionguard
+
+#endif /* __ELECTIONGUARD_CPP_DECRYPT_HPP_INCLUDED__ */
@@ -22,6 +22,14 @@ extern "C" {
 EG_API eg_electionguard_status_t eg_discrete_log_get_async(eg_element_mod_p_t *in_element,
                                                            uint64_t *out_result);
 
+/**
+ * @brief Set the largest exponent that the discrete log will search for
+ * 
+ * @param[in] in_max_exponent the largest exponent to search for
+ * @return EG_API eg_electionguard_status_t indicating success or failure
+ */
+EG_API eg_electionguard_status_t eg_discrete_log_set_max_exponent(uint64_t in_max_exponent);
+
 #ifdef __cplusplus
 }
 #endif
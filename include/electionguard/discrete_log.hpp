@@ -9,6 +9,7 @@
 #include <array>
 #include <cstdint>
 #include <memory>
+#include <shared_mutex>
 #include <string>
 #include <unordered_map>
 
@@ -41,12 +42,19 @@ namespace electionguard
     };
 
     /// <Summary>
-    /// A cache of discrete log values for the group G_q
+    /// A cache of solved discrete log values for the group G_q
     /// </Summary>
     using DiscreteLogTable = std::unordered_map<ElementModP, uint64_t, KeyHash, KeyEqual>;
 
     /// <Summary>
-    /// A cache of discrete log values for the group G_q
+    /// Computes discrete logs in the group G_q using baby-step giant-step.
+    ///
+    /// The baby steps g^0 .. g^(m-1) are stored once as 64-bit fingerprints,
+    /// where m is the square root of the largest supported exponent, so any
+    /// exponent up to the bound is found with at most m giant steps.
+    /// A fingerprint match is confirmed by exponentiating before it is returned.
+    /// The table is immutable once built and shared between threads, and
+    /// solved elements are remembered so repeated values are a single lookup.
     /// </Summary>
     class EG_API DiscreteLog
     {
@@ -68,16 +76,36 @@ namespace electionguard
         }
 
         /// <Summary>
-        /// Get the discrete log value for the given element
+        /// Get the discrete log value for the given element.
+        /// Safe to call from multiple threads.
+        /// Throws out_of_range if the exponent is larger than the max exponent.
         /// </Summary>
         static uint64_t getAsync(const ElementModP &element);
 
+        /// <Summary>
+        /// Set the largest exponent that getAsync will search for.
+        /// The table is rebuilt for the new bound the next time it is used.
+        /// Defaults to DLOG_MAX_SIZE and throws out_of_range above DLOG_MAX_SIZE_LIMIT,
+        /// since the table grows with the square root of the bound.
+        /// </Summary>
+        static void setMaxExponent(uint64_t maxExponent);
+
+        /// <Summary>
+        /// Get the largest exponent that getAsync will search for
+        /// </Summary>
+        static uint64_t getMaxExponent();
+
       protected:
-        uint64_t computeCache(const ElementModP &element);
+        struct BabySteps;
+
+        std::shared_ptr<const BabySteps> getBabySteps();
+        uint64_t compute(const ElementModP &element);
 
       private:
-        AsyncSemaphore task_lock;
-        DiscreteLogTable cache = DiscreteLogTable(DLOG_MAX_SIZE);
+        std::shared_mutex mutex;
+        uint64_t maxExponent = DLOG_MAX_SIZE;
+        std::shared_ptr<const BabySteps> babySteps;
+        DiscreteLogTable cache;
     };
 
 } // namespace electionguard
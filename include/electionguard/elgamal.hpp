@@ -215,7 +215,8 @@ namespace electionguard
     /// <returns>A ciphertext tuple.</returns>
     /// </summary>
     EG_API std::unique_ptr<ElGamalCiphertext>
-    elgamalEncrypt_with_precomputed(uint64_t m, ElementModP &gToRho, ElementModP &pubkeyToRho);
+    elgamalEncrypt_with_precomputed(uint64_t m, const ElementModP &gToRho,
+                                    const ElementModP &pubkeyToRho);
 
     /// <summary>
     /// Homomorphically accumulates one or more ElGamal ciphertexts by pairwise multiplication.
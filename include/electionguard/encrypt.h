@@ -135,6 +135,25 @@ EG_API eg_electionguard_status_t eg_encryption_mediator_encrypt_ballot_verify_pr
   eg_encryption_mediator_t *handle, eg_plaintext_ballot_t *in_plaintext,
   eg_ciphertext_ballot_t **out_ciphertext_handle);
 
+/**
+* Encrypt a batch of ballots using the cached election context.
+*
+* The ballots are encrypted concurrently and returned in the order of the input.
+* The ballot codes are chained in that order.
+*
+* @param[in] in_plaintexts The plaintext representations of the ballots
+* @param[in] in_plaintexts_size The number of ballots
+* @param[in] in_should_verify_proofs specify if the proofs should be verified prior to returning
+* @param[in] in_use_precomputed_values True if the mediator should use the precomputed values
+* @param[out] out_ciphertext_handles a caller allocated array of `in_plaintexts_size` handles that
+*                                    is filled with a `CiphertextBallot` handle for each ballot.
+*                                    Caller is responsible for the lifecycle of each handle.
+**/
+EG_API eg_electionguard_status_t eg_encryption_mediator_encrypt_ballots(
+  eg_encryption_mediator_t *handle, eg_plaintext_ballot_t *in_plaintexts[],
+  uint64_t in_plaintexts_size, bool in_should_verify_proofs, bool in_use_precomputed_values,
+  eg_ciphertext_ballot_t *out_ciphertext_handles[]);
+
 #endif
 
 #ifndef Encryption Functions
@@ -248,6 +267,31 @@ EG_API eg_electionguard_status_t eg_encrypt_ballot_with_nonce(
   eg_element_mod_q_t *in_nonce, uint64_t timestamp, bool in_should_verify_proofs,
   eg_ciphertext_ballot_t **out_handle);
 
+/**
+* Encrypt a batch of `Ballot`s in the context of a specific `CiphertextElectionContext`.
+*
+* Each ballot is encrypted as with `eg_encrypt_ballot`. The ballots of the batch are
+* encrypted concurrently on all cores and returned in the order of the input. The first
+* ballot is chained to the ballot code seed and each following ballot is chained to the
+* ballot code of the one before it.
+*
+* @param[in] in_plaintexts: the ballots in the valid input form
+* @param[in] in_plaintexts_size: the number of ballots
+* @param[in] in_manifest: the `InternalManifest` which defines the ballots' structure
+* @param[in] in_context: all the cryptographic context for the election
+* @param[in] in_ballot_code_seed: Hash from previous ballot or starting hash from device
+* @param[in] in_should_verify_proofs: specify if the proofs should be verified prior to returning (default True)
+* @param[in] in_use_precomputed_values: specify if the ballot generation should use precomputed values
+* @param[out] out_handles a caller allocated array of `in_plaintexts_size` handles that is filled
+*                         with an `eg_ciphertext_ballot_t` for each ballot.
+*                         Caller is responsible for the lifecycle of each handle.
+*/
+EG_API eg_electionguard_status_t eg_encrypt_ballots(
+  eg_plaintext_ballot_t *in_plaintexts[], uint64_t in_plaintexts_size,
+  eg_internal_manifest_t *in_manifest, eg_ciphertext_election_context_t *in_context,
+  eg_element_mod_q_t *in_ballot_code_seed, bool in_should_verify_proofs,
+  bool in_use_precomputed_values, eg_ciphertext_ballot_t *out_handles[]);
+
 /**
 * Encrypt a specific `Ballot` in the context of a specific `CiphertextElectionContext`.
 *
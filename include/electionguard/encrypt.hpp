@@ -9,6 +9,7 @@
 #include "manifest.hpp"
 #include "nonces.hpp"
 
+#include <functional>
 #include <memory>
 
 using std::string;
@@ -120,6 +121,17 @@ namespace electionguard
                                                   bool shouldVerifyProofs = true,
                                                   bool usePrecomputedValues = false) const;
 
+        /// <summary>
+        /// Encrypt a batch of ballots using the cached election context.
+        ///
+        /// The ballots are encrypted concurrently on the library scheduler and returned in the
+        /// order of the input. The ballot codes are chained in that order, continuing the chain
+        /// of any ballot previously encrypted by this mediator. See `encryptBallots`.
+        /// </summary>
+        std::vector<std::unique_ptr<CiphertextBallot>>
+        encrypt(const std::vector<std::reference_wrapper<const PlaintextBallot>> &ballots,
+                bool shouldVerifyProofs = true, bool usePrecomputedValues = false) const;
+
         /// <summary>
         /// Encrypt the specified ballot into its compact form using the cached election context.
         /// </summary>
@@ -171,6 +183,7 @@ namespace electionguard
     ///                          Ballot nonce, but no relationship is required</param>
     /// <param name="shouldVerifyProofs">specify if the proofs should be verified prior to returning (default True)</param>
     /// <param name="shouldUsePrecomputedValues">specify if the encryption generation should use precomputed values (default False)</param>
+    /// <param name="shouldEncryptInParallel">specify if the selections should be encrypted in parallel on the scheduler (default False)</param>
     /// <returns>A `CiphertextBallotContest`</returns>
     /// </summary>
     EG_API std::unique_ptr<CiphertextBallotContest>
@@ -178,7 +191,7 @@ namespace electionguard
                    const ContestDescriptionWithPlaceholders &description,
                    const ElementModP &elgamalPublicKey, const ElementModQ &cryptoExtendedBaseHash,
                    const ElementModQ &nonceSeed, bool shouldVerifyProofs = true,
-                   bool shouldUsePrecomputedValues = false);
+                   bool shouldUsePrecomputedValues = false, bool shouldEncryptInParallel = false);
 
     /// <summary>
     /// Encrypt the contests of a specific `Ballot` in the context of a specific `CiphertextElectionContext`
@@ -197,12 +210,14 @@ namespace electionguard
     /// <param name="nonceSeed">the random value used to seed the `Nonce` for all contests on the ballot</param>
     /// <param name="shouldVerifyProofs">specify if the proofs should be verified prior to returning (default True)</param>
     /// <param name="shouldUsePrecomputedValues">specify if the encryption generation should use precomputed values (default False)</param>
+    /// <param name="shouldEncryptInParallel">specify if the contests and their selections should be encrypted in parallel on the scheduler (default False)</param>
     /// <returns>A collection of `CiphertextBallotContest`</returns>
     /// </summary>
     EG_API std::vector<std::unique_ptr<CiphertextBallotContest>>
     encryptContests(const PlaintextBallot &ballot, const InternalManifest &internalManifest,
                     const CiphertextElectionContext &context, const ElementModQ &nonceSeed,
-                    bool shouldVerifyProofs = true, bool shouldUsePrecomputedValues = false);
+                    bool shouldVerifyProofs = true, bool shouldUsePrecomputedValues = false,
+                    bool shouldEncryptInParallel = false);
 
     /// <summary>
     /// Encrypt a specific `Ballot` in the context of a specific `CiphertextElectionContext`
@@ -227,6 +242,9 @@ namespace electionguard
     /// Because PrecomputeBuffers require a random nonce, calling this function with `shouldUsePrecomputedValues`
     /// set to `true` while also providing a nonce will result in an error.
     ///
+    /// Setting `shouldEncryptInParallel` encrypts the contests and selections on the library scheduler.
+    /// Every selection derives its nonce deterministically, so the result is identical to the serial encryption.
+    ///
     /// <param name="ballot">the selection in the valid input form</param>
     /// <param name="internalManifest">the `InternalManifest` which defines this ballot's structure</param>
     /// <param name="context">all the cryptographic context for the election</param>
@@ -235,13 +253,42 @@ namespace electionguard
     ///                     if this value is not provided, the secret generating mechanism of the OS provides its own</param>
     /// <param name="shouldVerifyProofs">specify if the proofs should be verified prior to returning (default True)</param>
     /// <param name="shouldUsePrecomputedValues">specify if precomputed values should be used (default True)</param>
+    /// <param name="shouldEncryptInParallel">specify if the contests and selections should be encrypted in parallel (default False)</param>
     /// <returns>A `CiphertextBallot`</returns>
     /// </summary>
     EG_API std::unique_ptr<CiphertextBallot>
     encryptBallot(const PlaintextBallot &ballot, const InternalManifest &internalManifest,
                   const CiphertextElectionContext &context, const ElementModQ &ballotCodeSeed,
                   std::unique_ptr<ElementModQ> nonce = nullptr, uint64_t timestamp = 0,
-                  bool shouldVerifyProofs = true, bool shouldUsePrecomputedValues = false);
+                  bool shouldVerifyProofs = true, bool shouldUsePrecomputedValues = false,
+                  bool shouldEncryptInParallel = false);
+
+    /// <summary>
+    /// Encrypt a batch of `Ballot`s in the context of a specific `CiphertextElectionContext`
+    ///
+    /// Each ballot is encrypted as with `encryptBallot` using a random nonce. The ballots of the batch
+    /// are normalized, encrypted and proven concurrently on the library scheduler, and each ballot is
+    /// verified as soon as it is complete while the rest of the batch is still encrypting.
+    ///
+    /// The results are returned in the order of the input. The first ballot is chained to the
+    /// `ballotCodeSeed` and each following ballot is chained to the ballot code of the one before it,
+    /// the same as encrypting the ballots one after another with an `EncryptionMediator`.
+    ///
+    /// <param name="ballots">the ballots in the valid input form</param>
+    /// <param name="internalManifest">the `InternalManifest` which defines the ballots' structure</param>
+    /// <param name="context">all the cryptographic context for the election</param>
+    /// <param name="ballotCodeSeed">Hash from previous ballot or hash from device</param>
+    /// <param name="timestamp">the timestamp of every ballot, or 0 to use the time each ballot is completed</param>
+    /// <param name="shouldVerifyProofs">specify if the proofs should be verified prior to returning (default True)</param>
+    /// <param name="shouldUsePrecomputedValues">specify if precomputed values should be used (default False)</param>
+    /// <returns>A collection of `CiphertextBallot` in the order of the input</returns>
+    /// </summary>
+    EG_API std::vector<std::unique_ptr<CiphertextBallot>>
+    encryptBallots(const std::vector<std::reference_wrapper<const PlaintextBallot>> &ballots,
+                   const InternalManifest &internalManifest,
+                   const CiphertextElectionContext &context, const ElementModQ &ballotCodeSeed,
+                   uint64_t timestamp = 0, bool shouldVerifyProofs = true,
+                   bool shouldUsePrecomputedValues = false);
 
     /// <summary>
     /// Encrypt a specific `Ballot` in the context of a specific `CiphertextElectionContext`
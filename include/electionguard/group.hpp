@@ -4,7 +4,9 @@
 #include "constants.h"
 #include "export.h"
 
+#include <atomic>
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
 #include <variant>
@@ -15,10 +17,16 @@ namespace electionguard
     typedef uint64_t array4096[MAX_P_LEN];
     /// <summary>
     /// An element of the larger `mod p` space, i.e., in [0, P), where P is a 4096-bit prime.
+    ///
+    /// The limbs are stored inline so an element on the stack never allocates.
     /// </summary>
     class EG_API ElementModP
     {
       public:
+        /// <summary>
+        /// Create the zero element, typically as the destination of an `_into` operation
+        /// </summary>
+        ElementModP();
         ElementModP(const ElementModP &other);
         ElementModP(ElementModP &&other);
         ElementModP(const std::vector<uint64_t> &elem, bool unchecked = false,
@@ -27,14 +35,11 @@ namespace electionguard
                     bool fixedBase = false);
         ~ElementModP();
 
-        ElementModP &operator=(ElementModP other);
+        ElementModP &operator=(const ElementModP &other);
         ElementModP &operator=(ElementModP &&other);
-        bool operator==(const ElementModP &other);
         bool operator==(const ElementModP &other) const;
-        bool operator!=(const ElementModP &other);
         bool operator!=(const ElementModP &other) const;
 
-        bool operator<(const ElementModP &other);
         bool operator<(const ElementModP &other) const;
 
         // TODO: ISSUE #130: math operators
@@ -44,13 +49,21 @@ namespace electionguard
         /// Note the Element is stored in HACL format
         /// <returns> a pointer to the first limb. </returns>
         /// </Summary>
-        uint64_t *get() const;
+        const uint64_t *get() const;
+
+        /// <Summary>
+        /// Get the integer representation of the element to write to.
+        /// The value may change through the pointer, so the element forgets
+        /// that it is a validated residue and a fixed base.
+        /// <returns> a pointer to the first limb. </returns>
+        /// </Summary>
+        uint64_t *getMutable();
 
         /// <Summary>
         /// Get the integer representation of the element as a reference
         /// Note the Element is stored in HACL format
         /// <Summary>
-        uint64_t (&ref() const)[MAX_P_LEN];
+        const uint64_t (&ref() const)[MAX_P_LEN];
 
         ///<Summary>
         /// Get the length of the element
@@ -67,9 +80,21 @@ namespace electionguard
 
         /// <Summary>
         /// Validates that this element is in Z^r_p.
+        /// A valid element is flagged so checking it or a copy of it again is free.
         /// </Summary>
         bool isValidResidue() const;
 
+        /// <Summary>
+        /// Validates that each element is in Z^r_p.
+        ///
+        /// The elements are raised to random exponents and the product is checked
+        /// with a single exponentiation by Q. When the product is not in Z^r_p each
+        /// element is checked on its own. Valid elements are flagged like `isValidResidue`.
+        /// <returns>a flag for each element</returns>
+        /// </Summary>
+        static std::vector<bool>
+        isValidResidueBatch(const std::vector<std::reference_wrapper<const ElementModP>> &elements);
+
         /// <Summary>
         /// exports a bytes representation of the integer value in Big Endian format
         /// </Summary>
@@ -103,31 +128,37 @@ namespace electionguard
                                                        bool unchecked = false);
 
       private:
-        class Impl;
+        mutable uint64_t data[MAX_P_LEN];
+        // the flags are cached by const methods on elements that may be shared across threads
 #pragma warning(suppress : 4251)
-        std::unique_ptr<Impl> pimpl;
+        mutable std::atomic<bool> fixedBase;
+#pragma warning(suppress : 4251)
+        mutable std::atomic<bool> verifiedResidue;
     };
 
     /// <summary>
     /// An element of the smaller `mod q` space, i.e., in [0, Q), where Q is a 256-bit prime.
+    ///
+    /// The limbs are stored inline so an element on the stack never allocates.
     /// </summary>
     class EG_API ElementModQ
     {
       public:
+        /// <summary>
+        /// Create the zero element, typically as the destination of an `_into` operation
+        /// </summary>
+        ElementModQ();
         ElementModQ(const ElementModQ &other);
         ElementModQ(ElementModQ &&other);
         ElementModQ(const std::vector<uint64_t> &elem, bool unchecked = false);
         ElementModQ(const uint64_t (&elem)[MAX_Q_LEN], bool unchecked = false);
         ~ElementModQ();
 
-        ElementModQ &operator=(ElementModQ other);
+        ElementModQ &operator=(const ElementModQ &other);
         ElementModQ &operator=(ElementModQ &&other);
-        bool operator==(const ElementModQ &other);
         bool operator==(const ElementModQ &other) const;
-        bool operator!=(const ElementModQ &other);
         bool operator!=(const ElementModQ &other) const;
 
-        bool operator<(const ElementModQ &other);
         bool operator<(const ElementModQ &other) const;
 
         // TODO: ISSUE #130: overload math operators and redirect to functions
@@ -184,9 +215,54 @@ namespace electionguard
         std::unique_ptr<ElementModP> toElementModP() const;
 
       private:
-        class Impl;
-#pragma warning(suppress : 4251)
-        std::unique_ptr<Impl> pimpl;
+        mutable uint64_t data[MAX_Q_LEN];
+    };
+
+    /// <summary>
+    /// An element of the `mod p` space held in montgomery form.
+    ///
+    /// Each multiplication is a single montgomery multiplication instead of a
+    /// full width product followed by a reduction, so long chains such as
+    /// homomorphic accumulation only pay for the conversions at their ends.
+    /// The value is stored inline and never allocates.
+    /// </summary>
+    class EG_API MontgomeryElementModP
+    {
+      public:
+        /// <summary>
+        /// Create the multiplicative identity
+        /// </summary>
+        MontgomeryElementModP();
+        explicit MontgomeryElementModP(const ElementModP &element);
+        MontgomeryElementModP(const MontgomeryElementModP &other);
+        ~MontgomeryElementModP();
+
+        MontgomeryElementModP &operator=(const MontgomeryElementModP &other);
+        bool operator==(const MontgomeryElementModP &other) const;
+        bool operator!=(const MontgomeryElementModP &other) const;
+
+        MontgomeryElementModP &operator*=(const MontgomeryElementModP &other);
+        MontgomeryElementModP &operator*=(const ElementModP &other);
+        MontgomeryElementModP operator*(const MontgomeryElementModP &other) const;
+
+        /// <Summary>
+        /// Get the montgomery representation of the element
+        /// <returns> a pointer to the first limb</returns>
+        /// </Summary>
+        uint64_t *get() const;
+
+        /// <Summary>
+        /// Computes this^e mod p without leaving montgomery form
+        /// </Summary>
+        MontgomeryElementModP pow(const ElementModQ &exponent) const;
+
+        /// <Summary>
+        /// Convert the element back out of montgomery form
+        /// </Summary>
+        std::unique_ptr<ElementModP> toElementModP() const;
+
+      private:
+        uint64_t data[MAX_P_LEN];
     };
 
     // Common constants
@@ -226,6 +302,12 @@ namespace electionguard
     /// </summary>
     EG_API std::unique_ptr<ElementModP> mul_mod_p(const ElementModP &lhs, const ElementModP &rhs);
 
+    /// <summary>
+    /// Multplies together the left hand side and right hand side and writes the product mod P
+    /// to out. The output may be one of the inputs.
+    /// </summary>
+    EG_API void mul_mod_p_into(ElementModP &out, const ElementModP &lhs, const ElementModP &rhs);
+
     using ElementModPOrQ = std::variant<ElementModP *, ElementModQ *>;
 
     /// <summary>
@@ -257,6 +339,57 @@ namespace electionguard
     EG_API std::unique_ptr<ElementModP> pow_mod_p(const ElementModP &base,
                                                   const ElementModQ &exponent);
 
+    /// <summary>
+    /// Computes b^e mod p and writes the result to out. The output may be the base.
+    /// </summary>
+    EG_API void pow_mod_p_into(ElementModP &out, const ElementModP &base,
+                               const ElementModQ &exponent);
+
+    /// <summary>
+    /// Generate the fixed base lookup table for the base and flag it as a fixed base.
+    ///
+    /// The table is shared by every element with the same value and is kept
+    /// until each registration is released.
+    /// </summary>
+    EG_API void registerFixedBase(const ElementModP &base);
+
+    /// <summary>
+    /// Release a registration of the fixed base lookup table for the base.
+    /// The table is removed and the fixed base flag cleared once the last
+    /// registration is released. Tables that were never registered are left alone.
+    /// <returns>true if the table was removed</returns>
+    /// </summary>
+    EG_API bool releaseFixedBase(const ElementModP &base);
+
+    /// <summary>
+    /// Write the fixed base lookup table for the base to a file,
+    /// generating the table if one does not exist.
+    ///
+    /// The file can be loaded with `loadFixedBase` to skip generating the table
+    /// when a process starts. The values are stored in host byte order.
+    /// </summary>
+    EG_API void saveFixedBase(const ElementModP &base, const std::string &path);
+
+    /// <summary>
+    /// Memory map a fixed base lookup table written by `saveFixedBase`,
+    /// register it and flag the base as a fixed base.
+    ///
+    /// Throws if the file was not written for this base, window size and prime.
+    /// The registration is released with `releaseFixedBase`.
+    /// </summary>
+    EG_API void loadFixedBase(const ElementModP &base, const std::string &path);
+
+    /// <summary>
+    /// Computes the product of b_i^e_i mod p for each base and exponent.
+    ///
+    /// The exponentiations share their squarings so the product of two powers
+    /// costs little more than a single pow_mod_p. Bases with a fixed base
+    /// lookup table use the table instead.
+    /// </summary>
+    EG_API std::unique_ptr<ElementModP>
+    multi_pow_mod_p(const std::vector<std::reference_wrapper<const ElementModP>> &bases,
+                    const std::vector<std::reference_wrapper<const ElementModQ>> &exponents);
+
     /// <summary>
     /// Computes g^e mod p.
     /// </summary>
@@ -267,11 +400,22 @@ namespace electionguard
     /// </summary>
     EG_API std::unique_ptr<ElementModP> g_pow_p(const ElementModQ &exponent);
 
+    /// <summary>
+    /// Computes g^e mod p and writes the result to out.
+    /// </summary>
+    EG_API void g_pow_p_into(ElementModP &out, const ElementModQ &exponent);
+
     /// <summary>
     /// Adds together the left hand side and right hand side and returns the sum mod Q
     /// </summary>
     EG_API std::unique_ptr<ElementModQ> add_mod_q(const ElementModQ &lhs, const ElementModQ &rhs);
 
+    /// <summary>
+    /// Adds together the left hand side and right hand side and writes the sum mod Q to out.
+    /// The output may be one of the inputs.
+    /// </summary>
+    EG_API void add_mod_q_into(ElementModQ &out, const ElementModQ &lhs, const ElementModQ &rhs);
+
     /// <summary>
     /// Adds together the collection and returns the sum mod Q
     /// </summary>
@@ -283,11 +427,22 @@ namespace electionguard
     /// </summary>
     EG_API std::unique_ptr<ElementModQ> sub_mod_q(const ElementModQ &a, const ElementModQ &b);
 
+    /// <summary>
+    /// Computes (a-b) mod q and writes the result to out. The output may be one of the inputs.
+    /// </summary>
+    EG_API void sub_mod_q_into(ElementModQ &out, const ElementModQ &a, const ElementModQ &b);
+
     /// <summary>
     /// Computes (a * b) mod q.
     /// </summary>
     EG_API std::unique_ptr<ElementModQ> mul_mod_q(const ElementModQ &lhs, const ElementModQ &rhs);
 
+    /// <summary>
+    /// Multiplies together the left hand side and right hand side and writes the product mod Q
+    /// to out. The output may be one of the inputs.
+    /// </summary>
+    EG_API void mul_mod_q_into(ElementModQ &out, const ElementModQ &lhs, const ElementModQ &rhs);
+
     /// <summary>
     /// Multplies together the collection and returns the product mod Q
     /// </summary>
@@ -317,6 +472,12 @@ namespace electionguard
     EG_API std::unique_ptr<ElementModQ> a_plus_bc_mod_q(const ElementModQ &a, const ElementModQ &b,
                                                         const ElementModQ &c);
 
+    /// <summary>
+    /// Computes (a + b * c) mod q and writes the result to out. The output may be one of the inputs.
+    /// </summary>
+    EG_API void a_plus_bc_mod_q_into(ElementModQ &out, const ElementModQ &a, const ElementModQ &b,
+                                     const ElementModQ &c);
+
     /// <summary>
     /// Generate random number between 0 and P
     /// </summary>
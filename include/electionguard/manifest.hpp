@@ -1017,6 +1017,16 @@ namespace electionguard
         std::vector<std::reference_wrapper<ContestDescriptionWithPlaceholders>>
         getContestsFor(const std::string &ballotStyleId) const;
 
+        /// <summary>
+        /// Get a contest for a given contest id
+        /// </summary>
+        ContestDescriptionWithPlaceholders *getContest(const std::string &contestId) const;
+
+        /// <summary>
+        /// Get a candidate for a given candidate id
+        /// </summary>
+        Candidate *getCandidate(const std::string &candidateId) const;
+
         /// <summary>
         /// Export the ballot representation as BSON
         /// </summary>
@@ -62,9 +62,9 @@ eg_precompute_buffer_context_initialize(eg_element_mod_p_t *in_public_key, uint3
 EG_API eg_electionguard_status_t eg_precompute_buffer_context_start();
 
 /**
- * @brief Start a new precompute buffer context.  This is useful for when you want to
- * precompute buffers for multiple elections.  This will clear the existing context
- * and start a new one.
+ * @brief Start a precompute buffer for a public key.  This is useful for when you want to
+ * precompute buffers for multiple elections.  Buffers for other public keys are kept
+ * and encryption only uses values precomputed for the public key of its election.
  * 
  * @param in_public_key  the public key to use for precomputing
  */
@@ -4,18 +4,59 @@
 #include "electionguard/group.hpp"
 
 #include <array>
+#include <atomic>
 #include <cstdint>
 #include <electionguard/constants.h>
 #include <electionguard/export.h>
+#include <future>
 #include <iomanip>
 #include <iostream>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <optional>
 #include <queue>
+#include <shared_mutex>
+#include <string>
+#include <vector>
 
 namespace electionguard
 {
+    template <typename T> class AsyncRingBuffer;
+    class CiphertextElectionContext;
+    class PrecomputeFile;
+
+    /// <summary>
+    /// A fixed size record of the raw limbs of a Triple.
+    /// Used as inline storage in the precompute buffer.
+    /// </summary>
+    struct PrecomputedTripleRecord {
+        uint64_t exp[MAX_Q_LEN];
+        uint64_t g_to_exp[MAX_P_LEN];
+        uint64_t pubkey_to_exp[MAX_P_LEN];
+    };
+
+    /// <summary>
+    /// A fixed size record of the raw limbs of a Quadruple.
+    /// Used as inline storage in the precompute buffer.
+    /// </summary>
+    struct PrecomputedQuadrupleRecord {
+        uint64_t exp1[MAX_Q_LEN];
+        uint64_t exp2[MAX_Q_LEN];
+        uint64_t g_to_exp1[MAX_P_LEN];
+        uint64_t g_to_exp2_mult_by_pubkey_to_exp1[MAX_P_LEN];
+    };
+
+    /// <summary>
+    /// A fixed size record of the raw limbs of a TwoTriplesAndAQuadruple.
+    /// Used as inline storage in the precompute buffer.
+    /// </summary>
+    struct PrecomputedSelectionRecord {
+        PrecomputedTripleRecord triple1;
+        PrecomputedTripleRecord triple2;
+        PrecomputedQuadrupleRecord quad;
+    };
+
     /// <summary>
     /// This object holds the Triple for the entries in the precomputed triple_queue
     /// The three items contained in this object are a random exponent (exp),
@@ -41,14 +82,34 @@ namespace electionguard
         Triple &operator=(const Triple &triple);
         Triple &operator=(Triple &&);
 
-        std::unique_ptr<ElementModQ> get_exp() { return exp->clone(); }
+        std::unique_ptr<ElementModQ> get_exp() const { return exp->clone(); }
 
-        std::unique_ptr<ElementModP> get_g_to_exp() { return g_to_exp->clone(); }
+        std::unique_ptr<ElementModP> get_g_to_exp() const { return g_to_exp->clone(); }
+
+        std::unique_ptr<ElementModP> get_pubkey_to_exp() const { return pubkey_to_exp->clone(); }
+
+        /// <summary>
+        /// Borrow the values without copying them. The references are valid
+        /// for the lifetime of the triple.
+        /// </summary>
+        const ElementModQ &exp_ref() const { return *exp; }
 
-        std::unique_ptr<ElementModP> get_pubkey_to_exp() { return pubkey_to_exp->clone(); }
+        const ElementModP &g_to_exp_ref() const { return *g_to_exp; }
+
+        const ElementModP &pubkey_to_exp_ref() const { return *pubkey_to_exp; }
 
         std::unique_ptr<Triple> clone();
 
+        /// <summary>
+        /// Create a triple from the raw limbs of a precomputed record
+        /// </summary>
+        static std::unique_ptr<Triple> fromRecord(const PrecomputedTripleRecord &record);
+
+        /// <summary>
+        /// Copy the raw limbs of this triple into a precomputed record
+        /// </summary>
+        void toRecord(PrecomputedTripleRecord &record) const;
+
       protected:
         void generateTriple(const ElementModP &publicKey);
     };
@@ -80,19 +141,44 @@ namespace electionguard
         Quadruple &operator=(const Quadruple &quadruple);
         Quadruple &operator=(Quadruple &&);
 
-        std::unique_ptr<ElementModQ> get_exp1() { return exp1->clone(); }
+        std::unique_ptr<ElementModQ> get_exp1() const { return exp1->clone(); }
 
-        std::unique_ptr<ElementModQ> get_exp2() { return exp2->clone(); }
+        std::unique_ptr<ElementModQ> get_exp2() const { return exp2->clone(); }
 
-        std::unique_ptr<ElementModP> get_g_to_exp1() { return g_to_exp1->clone(); }
+        std::unique_ptr<ElementModP> get_g_to_exp1() const { return g_to_exp1->clone(); }
 
-        std::unique_ptr<ElementModP> get_g_to_exp2_mult_by_pubkey_to_exp1()
+        std::unique_ptr<ElementModP> get_g_to_exp2_mult_by_pubkey_to_exp1() const
         {
             return g_to_exp2_mult_by_pubkey_to_exp1->clone();
         }
 
+        /// <summary>
+        /// Borrow the values without copying them. The references are valid
+        /// for the lifetime of the quadruple.
+        /// </summary>
+        const ElementModQ &exp1_ref() const { return *exp1; }
+
+        const ElementModQ &exp2_ref() const { return *exp2; }
+
+        const ElementModP &g_to_exp1_ref() const { return *g_to_exp1; }
+
+        const ElementModP &g_to_exp2_mult_by_pubkey_to_exp1_ref() const
+        {
+            return *g_to_exp2_mult_by_pubkey_to_exp1;
+        }
+
         std::unique_ptr<Quadruple> clone();
 
+        /// <summary>
+        /// Create a quadruple from the raw limbs of a precomputed record
+        /// </summary>
+        static std::unique_ptr<Quadruple> fromRecord(const PrecomputedQuadrupleRecord &record);
+
+        /// <summary>
+        /// Copy the raw limbs of this quadruple into a precomputed record
+        /// </summary>
+        void toRecord(PrecomputedQuadrupleRecord &record) const;
+
       protected:
         void generateQuadruple(const ElementModP &publicKey);
     };
@@ -128,7 +214,28 @@ namespace electionguard
 
         std::unique_ptr<Quadruple> get_quad() { return quad->clone(); }
 
+        /// <summary>
+        /// Borrow the values without copying them. The references are valid
+        /// for the lifetime of this object.
+        /// </summary>
+        const Triple &triple1_ref() const { return *triple1; }
+
+        const Triple &triple2_ref() const { return *triple2; }
+
+        const Quadruple &quad_ref() const { return *quad; }
+
         std::unique_ptr<TwoTriplesAndAQuadruple> clone();
+
+        /// <summary>
+        /// Create the two triples and a quadruple from the raw limbs of a precomputed record
+        /// </summary>
+        static std::unique_ptr<TwoTriplesAndAQuadruple>
+        fromRecord(const PrecomputedSelectionRecord &record);
+
+        /// <summary>
+        /// Copy the raw limbs of the two triples and a quadruple into a precomputed record
+        /// </summary>
+        void toRecord(PrecomputedSelectionRecord &record) const;
     };
 
     /// <summary>
@@ -138,11 +245,26 @@ namespace electionguard
     /// as the computation of the Chaum Pedersen proof.
     ///
     /// The precompute buffer is a queue of TwoTriplesAndAQuadruple objects.
-    /// The queue is filled by a background thread. The background thread
-    /// will fill the queue until it reaches the max queue size. The max
+    /// The queue is filled either on the calling thread (start) or by a set
+    /// of producer tasks running on a dedicated pool of threads (startAsync),
+    /// so they never delay the tasks submitted to the shared Scheduler. The
+    /// producers will fill the queue until it reaches the max queue size. The max
     /// queue size is set by the caller and defaults to 5000. The queue
     /// size is set by the caller in the init method.
     ///
+    /// Values are generated outside of the queues and stored as fixed size
+    /// records of raw limbs in bounded lock-free rings that are allocated
+    /// once when the buffer is constructed, so many encryption threads can
+    /// pop concurrently without contending on a lock.
+    ///
+    /// Each queue has a low and a high watermark. Producers fill the queues up
+    /// to the high watermark and, when the buffer is set to auto populate,
+    /// generation is restarted in the background as soon as either queue
+    /// drops below its low watermark. The watermarks of the triple queue
+    /// follow the quadruple watermarks scaled by the observed ratio of
+    /// triples to quadruples consumed by hashedElgamalEncrypt and
+    /// encryptSelection, so the producers generate what is actually used.
+    ///
     /// This class is initialized against a specific public key and is thread safe.
     /// </summary>
     class EG_API PrecomputeBuffer
@@ -160,7 +282,8 @@ namespace electionguard
         /// <param name="shouldAutoPopulate">controls whether the
         ///                                           precompute buffer should
         ///                                           automatically populate
-        ///                                           itself</param>
+        ///                                           itself when a queue drops
+        ///                                           below its low watermark</param>
         /// </summary>
         PrecomputeBuffer(const ElementModP &publicKey, uint32_t maxQueueSize = 0,
                          bool shouldAutoPopulate = false);
@@ -193,6 +316,9 @@ namespace electionguard
         /// stop. Pre-computed values are currently computed by generating
         /// two triples and a quad. We do this because two triples and a quad
         /// are need for an encryptSelection.
+        ///
+        /// One producer is scheduled for each hardware thread. Calling this
+        /// while the producers are already running has no effect.
         /// <returns>immediately and schedules work in the background</returns>
         /// </summary>
         void startAsync();
@@ -200,6 +326,9 @@ namespace electionguard
         /// <summary>
         /// The stopPopulating method stops the population of the
         /// precomputations queues started by the populate method.
+        ///
+        /// Any background producers are cancelled and this method
+        /// returns once they have finished their current generation.
         /// </summary>
         void stop();
 
@@ -216,8 +345,73 @@ namespace electionguard
         /// </summary>
         uint32_t getCurrentQueueSize();
 
+        /// <summary>
+        /// Get the current number of triples in the triple_queue.
+        /// </summary>
+        uint32_t getCurrentTripleQueueSize();
+
+        /// <summary>
+        /// Set the low and high watermarks of the quadruple queue.
+        ///
+        /// Producers stop once the queue reaches the high watermark. When the
+        /// buffer auto populates, generation restarts once the queue drops
+        /// below the low watermark.
+        ///
+        /// <param name="lowWatermark">the size below which generation restarts</param>
+        /// <param name="highWatermark">the size the producers fill the queue to,
+        ///                             must not be larger than the max queue size</param>
+        /// </summary>
+        void setWatermarks(uint32_t lowWatermark, uint32_t highWatermark);
+
+        /// <summary>
+        /// Get the low watermark of the quadruple queue
+        /// </summary>
+        uint32_t getLowWatermark();
+
+        /// <summary>
+        /// Get the high watermark of the quadruple queue
+        /// </summary>
+        uint32_t getHighWatermark();
+
+        /// <summary>
+        /// Get the low watermark of the triple queue, which is the quadruple
+        /// low watermark scaled by the observed triple to quadruple ratio
+        /// </summary>
+        uint32_t getTripleLowWatermark();
+
+        /// <summary>
+        /// Get the high watermark of the triple queue, which is the quadruple
+        /// high watermark scaled by the observed triple to quadruple ratio
+        /// </summary>
+        uint32_t getTripleHighWatermark();
+
         ElementModP *getPublicKey();
 
+        /// <summary>
+        /// Save the precomputed values to a binary pool file keyed by the public key.
+        ///
+        /// The values are moved out of the buffer, including any values left in
+        /// a pool file loaded into this buffer, so they are never used by both
+        /// this process and the process that loads the file. The buffer must be
+        /// stopped before saving.
+        ///
+        /// <param name="path">the file to write, replacing any existing file</param>
+        /// </summary>
+        void save(const std::string &path);
+
+        /// <summary>
+        /// Load a pool file written by save for the same public key.
+        ///
+        /// The file is memory mapped and the queues are filled from it up to their
+        /// high watermarks without any exponentiation. The producers take the
+        /// rest of the file before generating new values. Each value in the
+        /// file is used at most once, the consumption cursor is persisted in
+        /// the file. The buffer must be stopped before loading.
+        ///
+        /// <param name="path">the pool file to load</param>
+        /// </summary>
+        void load(const std::string &path);
+
         /// <summary>
         /// Get the next triple from the triple queue.
         /// If no triple exists, one is created.
@@ -255,27 +449,77 @@ namespace electionguard
         static std::unique_ptr<TwoTriplesAndAQuadruple>
         createTwoTriplesAndAQuadruple(const ElementModP &publicKey);
 
+      private:
+        /// <summary>
+        /// Generate values until the queues reach their high watermarks
+        /// or the buffer is stopped. Safe to run concurrently from multiple threads.
+        /// </summary>
+        void populate();
+
+        /// <summary>
+        /// Schedule the background producers. Must be called holding the producer_lock.
+        /// </summary>
+        void scheduleProducers();
+
+        /// <summary>
+        /// Whether any producer is populating or scheduled to populate.
+        /// Must be called holding the producer_lock.
+        /// </summary>
+        bool hasActiveProducers();
+
+        /// <summary>
+        /// Restart the background producers if auto populate is enabled and
+        /// either queue dropped below its low watermark.
+        /// </summary>
+        void refillIfNeeded();
+
+        uint32_t scaleByTripleRatio(uint32_t quadCount);
+
+        /// <summary>
+        /// Fill the queues up to their high watermarks from the loaded pool file
+        /// </summary>
+        void fillFromFile();
+
       private:
         uint32_t maxQueueSize = DEFAULT_PRECOMPUTE_SIZE;
-        bool isRunning = false;
+        std::atomic<bool> isRunning = false;
         bool shouldAutoPopulate = false;
-        std::mutex triple_queue_lock;
-        std::mutex quad_queue_lock;
+        std::atomic<uint32_t> lowWatermark = 0;
+        std::atomic<uint32_t> highWatermark = 0;
+        std::mutex producer_lock;
+        // number of values currently being generated by the producers
+        std::atomic<uint32_t> pendingQuadCount = 0;
+        std::atomic<uint32_t> pendingTripleCount = 0;
+        std::atomic<uint32_t> activeProducerCount = 0;
+        // observed demand used to balance triple and quadruple generation
+        std::atomic<uint64_t> triplesRequested = 0;
+        std::atomic<uint64_t> quadsRequested = 0;
+        std::atomic<bool> hasWarnedEmpty = false;
+        std::vector<std::future<void>> producers;
         std::unique_ptr<ElementModP> publicKey;
-        std::queue<std::unique_ptr<Triple>> triple_queue;
-        std::queue<std::unique_ptr<TwoTriplesAndAQuadruple>> twoTriplesAndAQuadruple_queue;
+#pragma warning(suppress : 4251)
+        std::unique_ptr<AsyncRingBuffer<PrecomputedTripleRecord>> triple_queue;
+#pragma warning(suppress : 4251)
+        std::unique_ptr<AsyncRingBuffer<PrecomputedSelectionRecord>> twoTriplesAndAQuadruple_queue;
+#pragma warning(suppress : 4251)
+        std::unique_ptr<PrecomputeFile> file;
     };
 
     /// <summary>
-    /// A singleton context for a collection of precomputed triples and quadruples.
+    /// A singleton registry of precompute buffers keyed by the elgamal public key.
     ///
-    /// When initializing the context, the caller can specify the maximum number of
+    /// When initializing a buffer, the caller can specify the maximum number of
     /// quadruples to precompute. The number of triples in the triple queue will be
     /// twice this.
     ///
-    /// The context is initialized against a specific public key. There can only be one context
-    /// initialized at a time. If the caller attempts to initialize the context with a different
-    /// public key, then the context will be cleared and re-initialized.
+    /// Each buffer is initialized against a specific public key and several buffers,
+    /// one per election public key, can be registered at the same time. Encryption
+    /// pops values from the buffer registered for the public key of the election it
+    /// is encrypting for, so values are never used across elections, and a buffer
+    /// stays registered until it is explicitly cleared.
+    ///
+    /// The methods that do not take a public key operate on the most recently
+    /// initialized or started buffer.
     ///
     /// The context is thread safe.
     /// </summary>
@@ -288,8 +532,8 @@ namespace electionguard
         PrecomputeBufferContext &operator=(PrecomputeBufferContext &&) = delete;
 
       private:
-        PrecomputeBufferContext() {}
-        ~PrecomputeBufferContext() {}
+        PrecomputeBufferContext();
+        ~PrecomputeBufferContext();
 
       private:
         static PrecomputeBufferContext &getInstance()
@@ -300,21 +544,34 @@ namespace electionguard
 
       public:
         /// <summary>
-        /// clear the precomputations queues
+        /// clear the precomputations queues of every buffer and remove them from the context
         /// </summary>
         static void clear();
 
+        /// <summary>
+        /// clear the precomputations queues of the buffer for the public key
+        /// and remove it from the context
+        /// </summary>
+        static void clear(const ElementModP &publicKey);
+
         /// <summary>
         /// The init method initializes the precompute and allows the queue
         /// size to be set.
         ///
+        /// Any buffer already registered for the public key is cleared and replaced,
+        /// buffers registered for other public keys are left untouched.
+        ///
         /// <param name="publicKey">the elgamal public key for the election</param>
         /// <param name="maxQueueSize">by default the quad queue size is 5000, so
         ///                             10000 triples, if the caller wants the
         ///                             queue size to be different then this
         ///                             parameter is used</param>
+        /// <param name="shouldAutoPopulate">restart generation in the background
+        ///                                  when the queues drop below their
+        ///                                  low watermarks</param>
         /// </summary>
-        static void initialize(const ElementModP &publicKey, uint32_t maxQueueSize = 0);
+        static void initialize(const ElementModP &publicKey, uint32_t maxQueueSize = 0,
+                               bool shouldAutoPopulate = false);
 
         /// <summary>
         /// The start method populates the precomputations queues with
@@ -333,8 +590,8 @@ namespace electionguard
         /// two triples and a quad. We do this because two triples and a quad
         /// are need for an encryptSelection.
         ///
-        /// calling this override will re-initialize the context with the
-        /// provided public key.
+        /// calling this override will register a buffer for the provided public key
+        /// if there is none and make it the current buffer.
         ///
         /// <param name="publicKey">the elgamal public key for the election</param>
         /// <returns>once the queue is populated</returns>
@@ -347,17 +604,26 @@ namespace electionguard
         /// stop. Pre-computed values are currently computed by generating
         /// two triples and a quad. We do this because two triples and a quad
         /// are need for an encryptSelection.
+        ///
+        /// calling this override will register a buffer for the provided public key
+        /// if there is none and make it the current buffer.
         /// <returns>immediately and schedules work in the background</returns>
         /// </summary>
         static void startAsync(const ElementModP &publicKey);
 
         /// <summary>
         /// The stopPopulating method stops the population of the
-        /// precomputations queues started by the populate method.
+        /// precomputations queues of every registered buffer.
         /// <returns>void</returns>
         /// </summary>
         static void stop();
 
+        /// <summary>
+        /// Stop the population of the precomputations queues of the
+        /// buffer for the public key.
+        /// </summary>
+        static void stop(const ElementModP &publicKey);
+
         /// <summary>
         /// Get the currently set maximum queue size for the number
         /// of quadruples to generate. The number of triples in
@@ -372,6 +638,31 @@ namespace electionguard
         /// </summary>
         static uint32_t getCurrentQueueSize();
 
+        /// <summary>
+        /// Get the buffer registered for the public key.
+        /// <returns>the buffer or nullptr if no buffer is registered for the key</returns>
+        /// </summary>
+        static std::shared_ptr<PrecomputeBuffer> getBuffer(const ElementModP &publicKey);
+
+        /// <summary>
+        /// Get the buffer registered for the elgamal public key of the election context.
+        /// <returns>the buffer or nullptr if no buffer is registered for the election</returns>
+        /// </summary>
+        static std::shared_ptr<PrecomputeBuffer>
+        getBuffer(const CiphertextElectionContext &context);
+
+        /// <summary>
+        /// Save the precomputed values of the context to a binary pool file.
+        /// See PrecomputeBuffer::save
+        /// </summary>
+        static void save(const std::string &path);
+
+        /// <summary>
+        /// Load a pool file into the context, it must have been initialized
+        /// with the same public key. See PrecomputeBuffer::load
+        /// </summary>
+        static void load(const std::string &path);
+
         /// <summary>
         /// Get the next triple from the triple queue.
         /// This method is called by hashedElgamalEncrypt in order to get
@@ -385,6 +676,15 @@ namespace electionguard
         /// </summary>
         static std::optional<std::unique_ptr<Triple>> popTriple();
 
+        /// <summary>
+        /// Pop the next triple from the triple queue of the buffer for the public key.
+        /// If no buffer is registered for the key or no triple exists, then nullopt is returned.
+        ///
+        /// This method is called by hashedElgamalEncrypt and the constant chaum pedersen
+        /// proof in order to get the precomputed values for the election they are for.
+        /// </summary>
+        static std::optional<std::unique_ptr<Triple>> popTriple(const ElementModP &publicKey);
+
         /// <summary>
         /// Get the next two triples and a quadruple from the queues.
         /// This method is called by encryptSelection in order to get
@@ -400,9 +700,28 @@ namespace electionguard
         /// </summary>
         static std::optional<std::unique_ptr<TwoTriplesAndAQuadruple>> popTwoTriplesAndAQuadruple();
 
+        /// <summary>
+        /// Pop the next quadruple set from the queues of the buffer for the public key.
+        /// If no buffer is registered for the key or no quadruple exists, then nullopt
+        /// is returned.
+        ///
+        /// This method is called by encryptSelection in order to get the precomputed
+        /// values for the election it is encrypting for.
+        /// </summary>
+        static std::optional<std::unique_ptr<TwoTriplesAndAQuadruple>>
+        popTwoTriplesAndAQuadruple(const ElementModP &publicKey);
+
       private:
-        std::mutex _mutex;
-        std::unique_ptr<PrecomputeBuffer> _instance = nullptr;
+        typedef std::array<uint64_t, MAX_P_LEN> PublicKeyType;
+        static PublicKeyType makeKey(const ElementModP &publicKey);
+        static std::shared_ptr<PrecomputeBuffer> getCurrent();
+        static std::shared_ptr<PrecomputeBuffer> getOrCreate(const ElementModP &publicKey);
+
+        std::shared_mutex _mutex;
+#pragma warning(suppress : 4251)
+        std::map<PublicKeyType, std::shared_ptr<PrecomputeBuffer>> _buffers;
+#pragma warning(suppress : 4251)
+        std::shared_ptr<PrecomputeBuffer> _current = nullptr;
     };
 
 } // namespace electionguard
@@ -0,0 +1,108 @@
+/// @file tally.h
+#ifndef __ELECTIONGUARD_CPP_TALLY_H_INCLUDED__
+#define __ELECTIONGUARD_CPP_TALLY_H_INCLUDED__
+
+#include "ballot.h"
+#include "election.h"
+#include "elgamal.h"
+#include "export.h"
+#include "manifest.h"
+#include "status.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef CiphertextTally
+
+struct eg_ciphertext_tally_s;
+
+/**
+* The encrypted representation of all contests in the election.
+*
+* The tally accepts cast, challenged and spoiled ballots and homomorphically
+* accumulates the selections of the cast ballots on all cores.
+*/
+typedef struct eg_ciphertext_tally_s eg_ciphertext_tally_t;
+
+/**
+* Create an empty tally for an election
+*
+* @param[in] in_object_id the unique identifier for the tally
+* @param[in] in_manifest the `InternalManifest` which defines the ballots' structure
+* @param[in] in_context all the cryptographic context for the election
+* @param[out] out_handle a handle to an `eg_ciphertext_tally_t`.  Caller is responsible for lifecycle.
+*/
+EG_API eg_electionguard_status_t eg_ciphertext_tally_new(
+  char *in_object_id, eg_internal_manifest_t *in_manifest,
+  eg_ciphertext_election_context_t *in_context, eg_ciphertext_tally_t **out_handle);
+
+EG_API eg_electionguard_status_t eg_ciphertext_tally_free(eg_ciphertext_tally_t *handle);
+
+/**
+* Add a batch of ballots to the tally and accumulate the cast ballots in parallel.
+*
+* Ballots that are invalid, have already been added or do not match
+* the manifest are skipped.
+*
+* @param[in] in_ballots the ballots to add
+* @param[in] in_ballots_size the number of ballots
+* @param[in] in_skip_validation skip verifying the encryption of the ballots
+* @param[out] out_accumulated the number of ballots that were added
+*/
+EG_API eg_electionguard_status_t eg_ciphertext_tally_accumulate(
+  eg_ciphertext_tally_t *handle, eg_ciphertext_ballot_t *in_ballots[], uint64_t in_ballots_size,
+  bool in_skip_validation, uint64_t *out_accumulated);
+
+/**
+* Read ballots from a file or from every file in a directory and accumulate the cast
+* ballots, parsing only the fields needed to accumulate them. The ballots are not validated.
+*
+* Files are read in name order by extension: `.json` holds a single ballot, `.jsonl` and
+* `.ndjson` hold newline delimited json ballots and `.msgpack` and `.mpk` hold
+* concatenated msgpack ballots. Other files are ignored.
+*
+* @param[in] in_path a ballot file or a directory of ballot files
+* @param[in] in_max_buffered_bytes the most serialized ballot data to hold in memory
+* @param[out] out_accumulated the number of ballots that were added
+*/
+EG_API eg_electionguard_status_t eg_ciphertext_tally_accumulate_files(
+  eg_ciphertext_tally_t *handle, char *in_path, uint64_t in_max_buffered_bytes,
+  uint64_t *out_accumulated);
+
+/**
+* The number of selections in the tally, which is the size of the
+* array expected by `eg_ciphertext_tally_get_ciphertexts`
+*/
+EG_API uint64_t eg_ciphertext_tally_get_selections_size(eg_ciphertext_tally_t *handle);
+
+/**
+* Get the object id of the selection description at an index of the tally
+*
+* @param[in] in_index the index of the selection
+* @param[out] out_object_id the object id.  Caller is responsible for lifecycle.
+*/
+EG_API eg_electionguard_status_t eg_ciphertext_tally_get_selection_object_id_at(
+  eg_ciphertext_tally_t *handle, uint64_t in_index, char **out_object_id);
+
+/**
+* Get the accumulated ciphertext of every selection in the tally,
+* ordered by contest and then by selection sequence order
+*
+* @param[out] out_ciphertexts a caller allocated array of
+*                             `eg_ciphertext_tally_get_selections_size` handles that is filled
+*                             with an `eg_elgamal_ciphertext_t` for each selection.
+*                             Caller is responsible for the lifecycle of each handle.
+*/
+EG_API eg_electionguard_status_t eg_ciphertext_tally_get_ciphertexts(
+  eg_ciphertext_tally_t *handle, eg_elgamal_ciphertext_t *out_ciphertexts[]);
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* __ELECTIONGUARD_CPP_TALLY_H_INCLUDED__ */
@@ -0,0 +1,205 @@
+#ifndef __ELECTIONGUARD_CPP_TALLY_HPP_INCLUDED__
+#define __ELECTIONGUARD_CPP_TALLY_HPP_INCLUDED__
+
+#include "ballot.hpp"
+#include "election.hpp"
+#include "elgamal.hpp"
+#include "export.h"
+#include "group.hpp"
+#include "manifest.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <istream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace electionguard
+{
+    /// <summary>
+    /// The default limit on serialized ballots held in memory while streaming them into a tally
+    /// </summary>
+    static const uint64_t DEFAULT_TALLY_STREAM_BUFFER_SIZE = 64ULL * 1024ULL * 1024ULL;
+
+    /// <summary>
+    /// The homomorphic accumulation of the encrypted votes
+    /// for a particular selection in a contest.
+    /// </summary>
+    class EG_API CiphertextTallySelection
+    {
+      public:
+        CiphertextTallySelection(const CiphertextTallySelection &other);
+        CiphertextTallySelection(CiphertextTallySelection &&other);
+        CiphertextTallySelection(const std::string &objectId, const std::string &contestId,
+                                 uint64_t sequenceOrder, const ElementModQ &descriptionHash,
+                                 std::unique_ptr<ElGamalCiphertext> ciphertext);
+        ~CiphertextTallySelection();
+
+        CiphertextTallySelection &operator=(CiphertextTallySelection other);
+        CiphertextTallySelection &operator=(CiphertextTallySelection &&other);
+
+        /// <summary>
+        /// The object id of the selection description
+        /// </summary>
+        std::string getObjectId() const;
+
+        /// <summary>
+        /// The object id of the contest description the selection belongs to
+        /// </summary>
+        std::string getContestId() const;
+
+        /// <summary>
+        /// The sequence order of the selection description
+        /// </summary>
+        uint64_t getSequenceOrder() const;
+
+        /// <summary>
+        /// The hash of the selection description
+        /// </summary>
+        ElementModQ *getDescriptionHash() const;
+
+        /// <summary>
+        /// The encrypted representation of the sum of all cast ballots for the selection
+        /// </summary>
+        ElGamalCiphertext *getCiphertext() const;
+
+      private:
+        class Impl;
+#pragma warning(suppress : 4251)
+        std::unique_ptr<Impl> pimpl;
+    };
+
+    /// <summary>
+    /// The encrypted representation of all contests in the election.
+    ///
+    /// A `CiphertextTally` accepts cast, challenged and spoiled ballots and
+    /// homomorphically accumulates the selections of the cast ballots.
+    /// The running totals are kept in montgomery form and a batch of ballots
+    /// is folded into per thread partial totals that are combined with a
+    /// parallel tree reduction, so accumulating never round trips through
+    /// an `ElementModP` per selection.
+    ///
+    /// Accumulating is safe to call from multiple threads.
+    /// </summary>
+    class EG_API CiphertextTally
+    {
+      public:
+        CiphertextTally(const CiphertextTally &other) = delete;
+        CiphertextTally(CiphertextTally &&other);
+        CiphertextTally(const std::string &objectId, const InternalManifest &manifest,
+                        const CiphertextElectionContext &context);
+        ~CiphertextTally();
+
+        CiphertextTally &operator=(const CiphertextTally &other) = delete;
+        CiphertextTally &operator=(CiphertextTally &&other);
+
+        /// <summary>
+        /// The unique identifier for the tally
+        /// </summary>
+        std::string getObjectId() const;
+
+        /// <summary>
+        /// The ids of the cast ballots that were accumulated
+        /// </summary>
+        std::vector<std::string> getCastBallotIds() const;
+
+        /// <summary>
+        /// The ids of the challenged ballots that were added
+        /// </summary>
+        std::vector<std::string> getChallengedBallotIds() const;
+
+        /// <summary>
+        /// The ids of the spoiled ballots that were added
+        /// </summary>
+        std::vector<std::string> getSpoiledBallotIds() const;
+
+        /// <summary>
+        /// Check if a ballot has already been added to the tally
+        /// </summary>
+        bool hasBallot(const std::string &ballotId) const;
+
+        /// <summary>
+        /// Add a ballot to the tally and accumulate it if it is cast.
+        ///
+        /// <param name="ballot">the ballot to add</param>
+        /// <param name="skipValidation">skip verifying the encryption of the ballot</param>
+        /// <returns>true if the ballot was added, false if it is invalid,
+        /// has already been added or does not match the manifest</returns>
+        /// </summary>
+        bool accumulate(const CiphertextBallot &ballot, bool skipValidation = false);
+
+        /// <summary>
+        /// Add a batch of ballots to the tally and accumulate the cast ballots in parallel.
+        ///
+        /// <param name="ballots">the ballots to add</param>
+        /// <param name="skipValidation">skip verifying the encryption of the ballots</param>
+        /// <returns>for each ballot, true if it was added, false if it is invalid,
+        /// has already been added or does not match the manifest</returns>
+        /// </summary>
+        std::vector<bool>
+        accumulate(const std::vector<std::reference_wrapper<const CiphertextBallot>> &ballots,
+                   bool skipValidation = false);
+
+        /// <summary>
+        /// Read ballots from a stream of newline delimited json and accumulate the cast ballots.
+        ///
+        /// Only the fields needed to accumulate a ballot are parsed, so the proofs are not
+        /// read and the ballots are not validated. The stream is read on the calling thread
+        /// while the ballots are parsed and accumulated on all cores, with at most
+        /// `maxBufferedBytes` of serialized ballots held in memory between the two.
+        ///
+        /// <param name="stream">one serialized `CiphertextBallot` or `SubmittedBallot` per line</param>
+        /// <param name="maxBufferedBytes">the most serialized ballot data to hold in memory</param>
+        /// <returns>the number of ballots that were added</returns>
+        /// </summary>
+        uint64_t accumulateJsonLines(std::istream &stream,
+                                     uint64_t maxBufferedBytes = DEFAULT_TALLY_STREAM_BUFFER_SIZE);
+
+        /// <summary>
+        /// Read ballots from a stream of concatenated msgpack values and accumulate the cast
+        /// ballots, in the same way as `accumulateJsonLines`.
+        /// Throws invalid_argument if a value is larger than `maxBufferedBytes`.
+        ///
+        /// <param name="stream">serialized `CiphertextBallot` or `SubmittedBallot` msgpack values</param>
+        /// <param name="maxBufferedBytes">the most serialized ballot data to hold in memory</param>
+        /// <returns>the number of ballots that were added</returns>
+        /// </summary>
+        uint64_t accumulateMsgPack(std::istream &stream,
+                                   uint64_t maxBufferedBytes = DEFAULT_TALLY_STREAM_BUFFER_SIZE);
+
+        /// <summary>
+        /// Read ballots from a file or from every file in a directory and accumulate the
+        /// cast ballots, in the same way as `accumulateJsonLines`.
+        ///
+        /// Files are read in name order by extension: `.json` holds a single ballot,
+        /// `.jsonl` and `.ndjson` hold newline delimited json ballots and `.msgpack` and
+        /// `.mpk` hold concatenated msgpack ballots. Other files are ignored.
+        ///
+        /// <param name="path">a ballot file or a directory of ballot files</param>
+        /// <param name="maxBufferedBytes">the most serialized ballot data to hold in memory</param>
+        /// <returns>the number of ballots that were added</returns>
+        /// </summary>
+        uint64_t accumulateFiles(const std::string &path,
+                                 uint64_t maxBufferedBytes = DEFAULT_TALLY_STREAM_BUFFER_SIZE);
+
+        /// <summary>
+        /// The accumulated ciphertext of every selection in the election,
+        /// ordered by contest and then by selection sequence order.
+        /// Placeholder selections are not included.
+        /// </summary>
+        std::vector<std::unique_ptr<CiphertextTallySelection>> getSelections() const;
+
+        /// <summary>
+        /// The object ids of the selection descriptions in the same order as `getSelections`
+        /// </summary>
+        std::vector<std::string> getSelectionIds() const;
+
+      private:
+        class Impl;
+#pragma warning(suppress : 4251)
+        std::unique_ptr<Impl> pimpl;
+    };
+} // namespace electionguard
+
+#endif /* __ELECTIONGUARD_CPP_TALLY_HPP_INCLUDED__ */
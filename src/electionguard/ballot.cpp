@@ -149,6 +149,35 @@ namespace electionguard
 
 #pragma region CiphertextBallotSelection
 
+    // Check the hashes of the selection and that it has a proof
+    // without validating the proof itself
+    static bool isConsistentSelection(const CiphertextBallotSelection &selection,
+                                      const ElementModQ &encryptionSeed)
+    {
+        auto *descriptionHash = selection.getDescriptionHash();
+        if ((const_cast<ElementModQ &>(encryptionSeed) != *descriptionHash)) {
+            Log::info(": CiphertextBallotSelection mismatching selection hash: ");
+            Log::info(": expected: ", encryptionSeed.toHex());
+            Log::info(": actual: ", descriptionHash->toHex());
+            return false;
+        }
+
+        auto recalculatedCryptoHash = selection.crypto_hash_with(encryptionSeed);
+        auto *cryptoHash = selection.getCryptoHash();
+        if ((*cryptoHash != *recalculatedCryptoHash)) {
+            Log::info(": CiphertextBallotSelection mismatching crypto hash: ");
+            Log::info(": expected: ", recalculatedCryptoHash->toHex());
+            Log::info(": actual: ", cryptoHash->toHex());
+            return false;
+        }
+
+        if (selection.getProof() == nullptr) {
+            Log::info(": No proof exists for: " + selection.getObjectId());
+            return false;
+        }
+        return true;
+    }
+
     struct CiphertextBallotSelection::Impl {
         string objectId;
         uint64_t sequenceOrder;
@@ -356,23 +385,7 @@ namespace electionguard
                                                       const ElementModP &elgamalPublicKey,
                                                       const ElementModQ &cryptoExtendedBaseHash)
     {
-        if ((const_cast<ElementModQ &>(encryptionSeed) != *pimpl->descriptionHash)) {
-            Log::info(": CiphertextBallotSelection mismatching selection hash: ");
-            Log::info(": expected: ", encryptionSeed.toHex());
-            Log::info(": actual: ", pimpl->descriptionHash->toHex());
-            return false;
-        }
-
-        auto recalculatedCryptoHash = crypto_hash_with(encryptionSeed);
-        if ((*pimpl->cryptoHash != *recalculatedCryptoHash)) {
-            Log::info(": CiphertextBallotSelection mismatching crypto hash: ");
-            Log::info(": expected: ", recalculatedCryptoHash->toHex());
-            Log::info(": actual: ", pimpl->cryptoHash->toHex());
-            return false;
-        }
-
-        if (pimpl->proof == nullptr) {
-            Log::info(": No proof exists for: " + pimpl->objectId);
+        if (!isConsistentSelection(*this, encryptionSeed)) {
             return false;
         }
         return pimpl->proof->isValid(*pimpl->ciphertext, elgamalPublicKey, cryptoExtendedBaseHash);
@@ -1081,17 +1094,34 @@ namespace electionguard
 
         // Check the proofs on the ballot
         unordered_map<string, bool> validProofs;
+
+        // the selection proofs share the public key so they are validated as a batch
+        vector<string> batchKeys;
+        vector<reference_wrapper<const ElGamalCiphertext>> batchMessages;
+        vector<reference_wrapper<DisjunctiveChaumPedersenProof>> batchProofs;
         for (const auto &contest : this->getContests()) {
             for (const auto &selection : contest.get().getSelections()) {
                 string key = contest.get().getObjectId() + '-' + selection.get().getObjectId();
-                validProofs[key] = selection.get().isValidEncryption(
-                  *selection.get().getDescriptionHash(), elgamalPublicKey, cryptoExtendedBaseHash);
+                if (!isConsistentSelection(selection.get(),
+                                           *selection.get().getDescriptionHash())) {
+                    validProofs[key] = false;
+                    continue;
+                }
+                batchKeys.push_back(key);
+                batchMessages.push_back(*selection.get().getCiphertext());
+                batchProofs.push_back(*selection.get().getProof());
             }
             string key = contest.get().getObjectId();
             validProofs[key] = contest.get().isValidEncryption(
               *contest.get().getDescriptionHash(), elgamalPublicKey, cryptoExtendedBaseHash);
         }
 
+        auto batchResults = DisjunctiveChaumPedersenProof::isValidBatch(
+          batchMessages, batchProofs, elgamalPublicKey, cryptoExtendedBaseHash);
+        for (size_t i = 0; i < batchKeys.size(); i++) {
+            validProofs[batchKeys[i]] = batchResults[i];
+        }
+
         bool isValid = true;
         for (const auto &[key, value] : validProofs) {
             if (!value) {
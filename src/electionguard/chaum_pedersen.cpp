@@ -3,6 +3,7 @@
 #include "electionguard/nonces.hpp"
 #include "electionguard/precompute_buffers.hpp"
 #include "log.hpp"
+#include "random.hpp"
 
 #include <cstdlib>
 #include <cstring>
@@ -15,8 +16,10 @@ using std::invalid_argument;
 using std::make_unique;
 using std::map;
 using std::move;
+using std::reference_wrapper;
 using std::string;
 using std::unique_ptr;
+using std::vector;
 
 namespace electionguard
 {
@@ -217,12 +220,14 @@ namespace electionguard
         auto v0 = *pimpl->proof_zero_response;
         auto v1 = *pimpl->proof_one_response;
 
-        auto inBounds_alpha = alpha->isValidResidue();
-        auto inBounds_beta = beta->isValidResidue();
-        auto inBounds_a0 = a0.isValidResidue();
-        auto inBounds_b0 = b0.isValidResidue();
-        auto inBounds_a1 = a1.isValidResidue();
-        auto inBounds_b1 = b1.isValidResidue();
+        // the residues are checked on the stored elements so they stay flagged as valid
+        auto residues = ElementModP::isValidResidueBatch({*alpha, *beta, *a0p, *b0p, *a1p, *b1p});
+        auto inBounds_alpha = residues[0];
+        auto inBounds_beta = residues[1];
+        auto inBounds_a0 = residues[2];
+        auto inBounds_b0 = residues[3];
+        auto inBounds_a1 = residues[4];
+        auto inBounds_b1 = residues[5];
         auto inBounds_c0 = c0.isInBounds();
         auto inBounds_c1 = c1.isInBounds();
         auto inBounds_v0 = v0.isInBounds();
@@ -232,18 +237,23 @@ namespace electionguard
           (*add_mod_q(c0, c1) == c) &&
           (c == *hash_elems({&const_cast<ElementModQ &>(q), alpha, beta, a0p, b0p, a1p, b1p}));
 
+        // the equations are evaluated in the form 𝑔^𝑣 ⋅ 𝛼^(𝑞-𝑐) = 𝑎 mod 𝑝
+        // so each side is computed with a single multi exponentiation
+        auto q_min_c0 = sub_from_q(c0);
+        auto q_min_c1 = sub_from_q(c1);
+
         // 𝑔^𝑣 mod 𝑝 = 𝑎 ⋅ 𝛼^𝑐 mod 𝑝
-        auto consistent_gv0 = (*g_pow_p(v0) == *mul_mod_p(a0, *pow_mod_p(*alpha, c0)));
+        auto consistent_gv0 = (*multi_pow_mod_p({G(), *alpha}, {v0, *q_min_c0}) == a0);
 
         // 𝑔^𝑣 mod 𝑝 = 𝑎 ⋅ 𝛼^𝑐 mod 𝑝
-        auto consistent_gv1 = (*g_pow_p(v1) == *mul_mod_p(a1, *pow_mod_p(*alpha, c1)));
+        auto consistent_gv1 = (*multi_pow_mod_p({G(), *alpha}, {v1, *q_min_c1}) == a1);
 
         // 𝐾^𝑣 mod 𝑝 = 𝑏 ⋅ 𝛽^𝑐 mod 𝑝
-        auto consistent_kv0 = (*pow_mod_p(k, v0) == *mul_mod_p(b0, *pow_mod_p(*beta, c0)));
+        auto consistent_kv0 = (*multi_pow_mod_p({k, *beta}, {v0, *q_min_c0}) == b0);
 
         // 𝑔^𝑐 ⋅ 𝐾^𝑣 mod 𝑝 = 𝑏 ⋅ 𝛽^𝑐 mod 𝑝
         auto consistent_gc1kv1 =
-          (*mul_mod_p(*g_pow_p(c1), *pow_mod_p(k, v1)) == *mul_mod_p(b1, *pow_mod_p(*beta, c1)));
+          (*multi_pow_mod_p({G(), k, *beta}, {c1, v1, *q_min_c1}) == b1);
 
         auto success = inBounds_alpha && inBounds_beta && inBounds_a0 && inBounds_b0 &&
                        inBounds_a1 && inBounds_b1 && inBounds_c0 && inBounds_c1 && inBounds_v0 &&
@@ -292,6 +302,89 @@ namespace electionguard
         return success;
     }
 
+    vector<bool> DisjunctiveChaumPedersenProof::isValidBatch(
+      const vector<reference_wrapper<const ElGamalCiphertext>> &messages,
+      const vector<reference_wrapper<DisjunctiveChaumPedersenProof>> &proofs, const ElementModP &k,
+      const ElementModQ &q)
+    {
+        Log::trace("DisjunctiveChaumPedersenProof::isValidBatch: ");
+        if (messages.size() != proofs.size()) {
+            throw invalid_argument(
+              "DisjunctiveChaumPedersenProof::isValidBatch: messages and proofs must match");
+        }
+
+        vector<bool> results(proofs.size(), false);
+
+        // the residues of every proof are checked together
+        vector<reference_wrapper<const ElementModP>> elements;
+        elements.reserve(proofs.size() * 6);
+        for (size_t i = 0; i < proofs.size(); i++) {
+            const auto &proof = *proofs[i].get().pimpl;
+            elements.push_back(*messages[i].get().getPad());
+            elements.push_back(*messages[i].get().getData());
+            elements.push_back(*proof.proof_zero_pad);
+            elements.push_back(*proof.proof_zero_data);
+            elements.push_back(*proof.proof_one_pad);
+            elements.push_back(*proof.proof_one_data);
+        }
+        auto residues = ElementModP::isValidResidueBatch(elements);
+
+        // the bounds and challenge checks cannot be combined
+        // so they are evaluated for each proof before batching the equations
+        vector<size_t> candidates;
+        candidates.reserve(proofs.size());
+        for (size_t i = 0; i < proofs.size(); i++) {
+            const auto &message = messages[i].get();
+            const auto &proof = *proofs[i].get().pimpl;
+            auto *alpha = message.getPad();
+            auto *beta = message.getData();
+            auto &c0 = *proof.proof_zero_challenge;
+            auto &c1 = *proof.proof_one_challenge;
+            auto &c = *proof.challenge;
+
+            auto valid =
+              residues[i * 6] && residues[i * 6 + 1] && residues[i * 6 + 2] &&
+              residues[i * 6 + 3] && residues[i * 6 + 4] && residues[i * 6 + 5] &&
+              c0.isInBounds() && c1.isInBounds() && proof.proof_zero_response->isInBounds() &&
+              proof.proof_one_response->isInBounds() && (*add_mod_q(c0, c1) == c) &&
+              (c == *hash_elems({&const_cast<ElementModQ &>(q), alpha, beta,
+                                 proof.proof_zero_pad.get(), proof.proof_zero_data.get(),
+                                 proof.proof_one_pad.get(), proof.proof_one_data.get()}));
+            if (valid) {
+                candidates.push_back(i);
+            }
+        }
+
+        if (candidates.empty()) {
+            return results;
+        }
+
+        vector<reference_wrapper<const ElGamalCiphertext>> candidateMessages;
+        vector<reference_wrapper<DisjunctiveChaumPedersenProof>> candidateProofs;
+        candidateMessages.reserve(candidates.size());
+        candidateProofs.reserve(candidates.size());
+        for (auto i : candidates) {
+            candidateMessages.push_back(messages[i]);
+            candidateProofs.push_back(proofs[i]);
+        }
+
+        if (isValidCombined(candidateMessages, candidateProofs, k)) {
+            for (auto i : candidates) {
+                results[i] = true;
+            }
+            Log::trace("DisjunctiveChaumPedersenProof::isValidBatch: TRUE!");
+            return results;
+        }
+
+        // fall back to checking each proof to find the invalid ones
+        Log::info("DisjunctiveChaumPedersenProof::isValidBatch: batch is invalid, checking each "
+                  "proof");
+        for (auto i : candidates) {
+            results[i] = proofs[i].get().isValid(messages[i].get(), k, q);
+        }
+        return results;
+    }
+
     std::unique_ptr<DisjunctiveChaumPedersenProof> DisjunctiveChaumPedersenProof::clone() const
     {
         return make_unique<DisjunctiveChaumPedersenProof>(
@@ -304,6 +397,64 @@ namespace electionguard
 
     // Protected Methods
 
+    bool DisjunctiveChaumPedersenProof::isValidCombined(
+      const vector<reference_wrapper<const ElGamalCiphertext>> &messages,
+      const vector<reference_wrapper<DisjunctiveChaumPedersenProof>> &proofs, const ElementModP &k)
+    {
+        // Each proof contributes four equations which are raised to the
+        // random exponents r1, r2, r3, r4 and multiplied together:
+        // 𝑔^Σ(r1⋅𝑣0 + r2⋅𝑣1 + r4⋅𝑐1) ⋅ 𝐾^Σ(r3⋅𝑣0 + r4⋅𝑣1) mod 𝑝 =
+        // Π 𝑎0^r1 ⋅ 𝑎1^r2 ⋅ 𝑏0^r3 ⋅ 𝑏1^r4 ⋅ 𝛼^(r1⋅𝑐0 + r2⋅𝑐1) ⋅ 𝛽^(r3⋅𝑐0 + r4⋅𝑐1) mod 𝑝
+        auto exponents = Random::getBatchExponents(proofs.size() * 4);
+        auto gExponent = ZERO_MOD_Q().clone();
+        auto kExponent = ZERO_MOD_Q().clone();
+        vector<unique_ptr<ElementModQ>> scalars;
+        scalars.reserve(proofs.size() * 6);
+        vector<reference_wrapper<const ElementModP>> bases;
+        vector<reference_wrapper<const ElementModQ>> baseExponents;
+        bases.reserve(proofs.size() * 6);
+        baseExponents.reserve(proofs.size() * 6);
+
+        for (size_t j = 0; j < proofs.size(); j++) {
+            const auto &message = messages[j].get();
+            const auto &proof = *proofs[j].get().pimpl;
+            auto &c0 = *proof.proof_zero_challenge;
+            auto &c1 = *proof.proof_one_challenge;
+            auto &v0 = *proof.proof_zero_response;
+            auto &v1 = *proof.proof_one_response;
+
+            // the random exponents are 64-bit integers and may exceed a test prime q
+            auto *r = &exponents[j * 4];
+            auto r1 = ElementModQ::fromUint64(r[0], true);
+            auto r2 = ElementModQ::fromUint64(r[1], true);
+            auto r3 = ElementModQ::fromUint64(r[2], true);
+            auto r4 = ElementModQ::fromUint64(r[3], true);
+
+            gExponent = a_plus_bc_mod_q(
+              *a_plus_bc_mod_q(*a_plus_bc_mod_q(*gExponent, *r1, v0), *r2, v1), *r4, c1);
+            kExponent = a_plus_bc_mod_q(*a_plus_bc_mod_q(*kExponent, *r3, v0), *r4, v1);
+
+            auto alphaExponent = a_plus_bc_mod_q(*mul_mod_q(*r1, c0), *r2, c1);
+            auto betaExponent = a_plus_bc_mod_q(*mul_mod_q(*r3, c0), *r4, c1);
+
+            bases.insert(bases.end(), {*proof.proof_zero_pad, *proof.proof_one_pad,
+                                       *proof.proof_zero_data, *proof.proof_one_data,
+                                       *message.getPad(), *message.getData()});
+            baseExponents.insert(baseExponents.end(),
+                                 {*r1, *r2, *r3, *r4, *alphaExponent, *betaExponent});
+            scalars.push_back(move(r1));
+            scalars.push_back(move(r2));
+            scalars.push_back(move(r3));
+            scalars.push_back(move(r4));
+            scalars.push_back(move(alphaExponent));
+            scalars.push_back(move(betaExponent));
+        }
+
+        auto product = multi_pow_mod_p(bases, baseExponents);
+        auto combined = multi_pow_mod_p({G(), k}, {*gExponent, *kExponent});
+        return *combined == *product;
+    }
+
     unique_ptr<DisjunctiveChaumPedersenProof>
     DisjunctiveChaumPedersenProof::make_zero(const ElGamalCiphertext &message, const ElementModQ &r,
                                              const ElementModP &k, const ElementModQ &q)
@@ -382,18 +533,18 @@ namespace electionguard
         Log::trace("beta: ", beta->toHex());
 
         // Get our values from the precomputed values.
-        auto triple1 = precomputedTwoTriplesAndAQuad->get_triple1();
-        auto r = triple1->get_exp();
-        auto triple2 = precomputedTwoTriplesAndAQuad->get_triple2();
-        auto quad = precomputedTwoTriplesAndAQuad->get_quad();
-        auto u = triple2->get_exp();
-        auto v = quad->get_exp1();
-        auto w = quad->get_exp2();
-
-        auto a0 = triple2->get_g_to_exp();                      // 𝑔^𝑢 mod 𝑝
-        auto b0 = triple2->get_pubkey_to_exp();                 // 𝐾^𝑢 mod 𝑝
-        auto a1 = quad->get_g_to_exp1();                        // 𝑔^v mod 𝑝
-        auto b1 = quad->get_g_to_exp2_mult_by_pubkey_to_exp1(); // g^w⋅K^v mod p
+        const auto &triple1 = precomputedTwoTriplesAndAQuad->triple1_ref();
+        const auto &triple2 = precomputedTwoTriplesAndAQuad->triple2_ref();
+        const auto &quad = precomputedTwoTriplesAndAQuad->quad_ref();
+        const auto &r = triple1.exp_ref();
+        const auto &u = triple2.exp_ref();
+        const auto &v = quad.exp1_ref();
+        auto w = quad.get_exp2();
+
+        auto a0 = triple2.get_g_to_exp();                      // 𝑔^𝑢 mod 𝑝
+        auto b0 = triple2.get_pubkey_to_exp();                 // 𝐾^𝑢 mod 𝑝
+        auto a1 = quad.get_g_to_exp1();                        // 𝑔^v mod 𝑝
+        auto b1 = quad.get_g_to_exp2_mult_by_pubkey_to_exp1(); // g^w⋅K^v mod p
 
         // Compute the challenge
         auto c = hash_elems(
@@ -401,8 +552,8 @@ namespace electionguard
 
         //c_1 = w so we dont assign a new var for it
         auto c0 = sub_mod_q(*c, *w);            // c_0=(c-w) mod q
-        auto v0 = a_plus_bc_mod_q(*u, *c0, *r); // v_0=(u+c_0⋅R) mod q
-        auto v1 = a_plus_bc_mod_q(*v, *w, *r);  // v_1=(v+c_1⋅R) mod q
+        auto v0 = a_plus_bc_mod_q(u, *c0, r); // v_0=(u+c_0⋅R) mod q
+        auto v1 = a_plus_bc_mod_q(v, *w, r);  // v_1=(v+c_1⋅R) mod q
 
         return make_unique<DisjunctiveChaumPedersenProof>(
           move(a0), move(b0), move(a1), move(b1), move(c0), move(w), move(c), move(v0), move(v1));
@@ -480,27 +631,27 @@ namespace electionguard
         Log::trace("beta: ", beta->toHex());
 
         // Get our values from the precomputed values.
-        auto triple1 = precomputedTwoTriplesAndAQuad->get_triple1();
-        auto r = triple1->get_exp();
-        auto triple2 = precomputedTwoTriplesAndAQuad->get_triple2();
-        auto quad = precomputedTwoTriplesAndAQuad->get_quad();
-        auto u = triple2->get_exp();
-        auto v = quad->get_exp1();
-        auto w = quad->get_exp2();
-
-        auto a0 = quad->get_g_to_exp1();                        // 𝑔^v mod 𝑝
-        auto b0 = quad->get_g_to_exp2_mult_by_pubkey_to_exp1(); // g^w⋅K^v mod p
-        auto a1 = triple2->get_g_to_exp();                      // 𝑔^𝑢 mod 𝑝
-        auto b1 = triple2->get_pubkey_to_exp();                 // 𝐾^𝑢 mod 𝑝
+        const auto &triple1 = precomputedTwoTriplesAndAQuad->triple1_ref();
+        const auto &triple2 = precomputedTwoTriplesAndAQuad->triple2_ref();
+        const auto &quad = precomputedTwoTriplesAndAQuad->quad_ref();
+        const auto &r = triple1.exp_ref();
+        const auto &u = triple2.exp_ref();
+        const auto &v = quad.exp1_ref();
+        const auto &w = quad.exp2_ref();
+
+        auto a0 = quad.get_g_to_exp1();                        // 𝑔^v mod 𝑝
+        auto b0 = quad.get_g_to_exp2_mult_by_pubkey_to_exp1(); // g^w⋅K^v mod p
+        auto a1 = triple2.get_g_to_exp();                      // 𝑔^𝑢 mod 𝑝
+        auto b1 = triple2.get_pubkey_to_exp();                 // 𝐾^𝑢 mod 𝑝
 
         // Compute challenge
         auto c = hash_elems(
           {&const_cast<ElementModQ &>(q), alpha, beta, a0.get(), b0.get(), a1.get(), b1.get()});
 
-        auto c0 = sub_mod_q(Q(), *w);           // c_0=(q-w)  mod q
-        auto c1 = add_mod_q(*c, *w);            // c_1=(c+w)  mod q
-        auto v0 = a_plus_bc_mod_q(*v, *c0, *r); // v_0=(v+c_0⋅R)  mod q
-        auto v1 = a_plus_bc_mod_q(*u, *c1, *r); // v_1=(u+c_1⋅R)  mod q
+        auto c0 = sub_mod_q(Q(), w);          // c_0=(q-w)  mod q
+        auto c1 = add_mod_q(*c, w);           // c_1=(c+w)  mod q
+        auto v0 = a_plus_bc_mod_q(v, *c0, r); // v_0=(v+c_0⋅R)  mod q
+        auto v1 = a_plus_bc_mod_q(u, *c1, r); // v_1=(u+c_1⋅R)  mod q
 
         return make_unique<DisjunctiveChaumPedersenProof>(
           move(a0), move(b0), move(a1), move(b1), move(c0), move(c1), move(c), move(v0), move(v1));
@@ -593,7 +744,7 @@ namespace electionguard
             Log::debug("ConstantChaumPedersenProof:: using precomputed values. Your seed value is "
                        "ignored and is no longer deterministic.");
             // check if the are precompute values rather than doing the exponentiations here
-            auto triple = PrecomputeBufferContext::popTriple();
+            auto triple = PrecomputeBufferContext::popTriple(k);
             if (triple != nullptr && triple.has_value()) {
                 u = triple.value()->get_exp();
                 a = triple.value()->get_g_to_exp();
@@ -629,7 +780,6 @@ namespace electionguard
 
         auto *a_ptr = pimpl->pad.get();
         auto *b_ptr = pimpl->data.get();
-        auto *c_ptr = pimpl->challenge.get();
 
         auto a = *pimpl->pad;
         auto b = *pimpl->data;
@@ -637,10 +787,12 @@ namespace electionguard
         auto v = *pimpl->response;
         auto constant = pimpl->constant;
 
-        auto inBounds_alpha = alpha->isValidResidue();
-        auto inBounds_beta = beta->isValidResidue();
-        auto inBounds_a = a.isValidResidue();
-        auto inBounds_b = b.isValidResidue();
+        // the residues are checked on the stored elements so they stay flagged as valid
+        auto residues = ElementModP::isValidResidueBatch({*alpha, *beta, *a_ptr, *b_ptr});
+        auto inBounds_alpha = residues[0];
+        auto inBounds_beta = residues[1];
+        auto inBounds_a = residues[2];
+        auto inBounds_b = residues[3];
         auto inBounds_c = c.isInBounds();
         auto inBounds_v = v.isInBounds();
 
@@ -649,12 +801,16 @@ namespace electionguard
         auto consistent_c =
           (c == *hash_elems({&const_cast<ElementModQ &>(q), alpha, beta, a_ptr, b_ptr}));
 
+        // the equations are evaluated in the form 𝑔^𝑉 ⋅ 𝐴^(𝑞-𝐶) = 𝑎 mod 𝑝
+        // so each side is computed with a single multi exponentiation
+        auto q_min_c = sub_from_q(c);
+
         // 𝑔^𝑉 = 𝑎 ⋅ 𝐴^𝐶 mod 𝑝
-        auto consistent_gv = (*g_pow_p(v) == *mul_mod_p(a, *pow_mod_p(*alpha, c)));
+        auto consistent_gv = (*multi_pow_mod_p({G(), *alpha}, {v, *q_min_c}) == a);
 
         // 𝑔^𝐿 ⋅ 𝐾^𝑣 = 𝑏 ⋅ 𝐵^𝐶 mod 𝑝
-        auto consistent_kv = (*mul_mod_p(*g_pow_p(*mul_mod_p({c_ptr, constant_q.get()})),
-                                         *pow_mod_p(k, v)) == *mul_mod_p(b, *pow_mod_p(*beta, c)));
+        auto consistent_kv =
+          (*multi_pow_mod_p({G(), k, *beta}, {*mul_mod_q(c, *constant_q), v, *q_min_c}) == b);
 
         auto success = inBounds_alpha && inBounds_beta && inBounds_a && inBounds_b && inBounds_c &&
                        inBounds_v && consistent_c && consistent_gv && consistent_kv;
@@ -686,4 +842,174 @@ namespace electionguard
         return success;
     }
 #pragma endregion
+
+#pragma region ChaumPedersenProof
+
+    struct ChaumPedersenProof::Impl {
+        unique_ptr<ElementModP> pad;
+        unique_ptr<ElementModP> data;
+        unique_ptr<ElementModQ> challenge;
+        unique_ptr<ElementModQ> response;
+
+        Impl(unique_ptr<ElementModP> pad, unique_ptr<ElementModP> data,
+             unique_ptr<ElementModQ> challenge, unique_ptr<ElementModQ> response)
+            : pad(move(pad)), data(move(data)), challenge(move(challenge)), response(move(response))
+        {
+        }
+
+        [[nodiscard]] unique_ptr<ChaumPedersenProof::Impl> clone() const
+        {
+            auto _pad = make_unique<ElementModP>(*pad);
+            auto _data = make_unique<ElementModP>(*data);
+            auto _challenge = make_unique<ElementModQ>(*challenge);
+            auto _response = make_unique<ElementModQ>(*response);
+
+            return make_unique<ChaumPedersenProof::Impl>(move(_pad), move(_data), move(_challenge),
+                                                         move(_response));
+        }
+    };
+
+    // Lifecycle Methods
+
+    ChaumPedersenProof::ChaumPedersenProof(const ChaumPedersenProof &other)
+        : pimpl(other.pimpl->clone())
+    {
+    }
+
+    ChaumPedersenProof::ChaumPedersenProof(const ChaumPedersenProof &&other)
+        : pimpl(other.pimpl->clone())
+    {
+    }
+
+    ChaumPedersenProof::ChaumPedersenProof(unique_ptr<ElementModP> pad,
+                                           unique_ptr<ElementModP> data,
+                                           unique_ptr<ElementModQ> challenge,
+                                           unique_ptr<ElementModQ> response)
+        : pimpl(new Impl(move(pad), move(data), move(challenge), move(response)))
+    {
+    }
+
+    ChaumPedersenProof::~ChaumPedersenProof() = default;
+
+    // Operator Overloads
+
+    ChaumPedersenProof &ChaumPedersenProof::operator=(ChaumPedersenProof other)
+    {
+        swap(pimpl, other.pimpl);
+        return *this;
+    }
+
+    ChaumPedersenProof &ChaumPedersenProof::operator=(ChaumPedersenProof &&other)
+    {
+        swap(pimpl, other.pimpl);
+        return *this;
+    }
+
+    // Property Getters
+
+    ElementModP *ChaumPedersenProof::getPad() const { return pimpl->pad.get(); }
+    ElementModP *ChaumPedersenProof::getData() const { return pimpl->data.get(); }
+    ElementModQ *ChaumPedersenProof::getChallenge() const { return pimpl->challenge.get(); }
+    ElementModQ *ChaumPedersenProof::getResponse() const { return pimpl->response.get(); }
+
+    // Public Static Methods
+
+    unique_ptr<ChaumPedersenProof> ChaumPedersenProof::make(const ElGamalCiphertext &message,
+                                                            const ElementModQ &s,
+                                                            const ElementModP &m,
+                                                            const ElementModQ &seed,
+                                                            const ElementModQ &hash_header)
+    {
+        Log::trace("ChaumPedersenProof:: making proof");
+        auto *alpha = message.getPad();
+        auto *beta = message.getData();
+
+        // Derive nonce from seed and the constant string below
+        auto nonces = make_unique<Nonces>(seed, "constant-chaum-pedersen-proof");
+        auto u = nonces->get(0);
+        auto a = g_pow_p(*u);          // 𝑔^𝑢 mod 𝑝
+        auto b = pow_mod_p(*alpha, *u); // 𝐴^𝑢 mod 𝑝
+
+        // sha256(𝑄', A, B, a, b, 𝑀)
+        auto c = hash_elems({&const_cast<ElementModQ &>(hash_header), alpha, beta, a.get(),
+                             b.get(), &const_cast<ElementModP &>(m)});
+        auto v = a_plus_bc_mod_q(*u, *c, s);
+
+        return make_unique<ChaumPedersenProof>(move(a), move(b), move(c), move(v));
+    }
+
+    // Public Methods
+
+    bool ChaumPedersenProof::isValid(const ElGamalCiphertext &message, const ElementModP &k,
+                                     const ElementModP &m, const ElementModQ &q)
+    {
+        Log::trace("ChaumPedersenProof::isValid: checking validity");
+        auto *alpha = message.getPad();
+        auto *beta = message.getData();
+
+        auto *a_ptr = pimpl->pad.get();
+        auto *b_ptr = pimpl->data.get();
+
+        auto a = *pimpl->pad;
+        auto b = *pimpl->data;
+        auto c = *pimpl->challenge;
+        auto v = *pimpl->response;
+
+        // the residues are checked on the stored elements so they stay flagged as valid
+        auto residues = ElementModP::isValidResidueBatch({*alpha, *beta, *a_ptr, *b_ptr, k, m});
+        auto inBounds_alpha = residues[0];
+        auto inBounds_beta = residues[1];
+        auto inBounds_a = residues[2];
+        auto inBounds_b = residues[3];
+        auto inBounds_k = residues[4];
+        auto inBounds_m = residues[5];
+        auto inBounds_c = c.isInBounds();
+        auto inBounds_v = v.isInBounds();
+
+        auto consistent_c = (c == *hash_elems({&const_cast<ElementModQ &>(q), alpha, beta, a_ptr,
+                                                b_ptr, &const_cast<ElementModP &>(m)}));
+
+        // the equations are evaluated in the form 𝑔^𝑣 ⋅ 𝐾^(𝑞-𝑐) = 𝑎 mod 𝑝
+        // so each side is computed with a single multi exponentiation
+        auto q_min_c = sub_from_q(c);
+
+        // 𝑔^𝑣 = 𝑎 ⋅ 𝐾^𝑐 mod 𝑝
+        auto consistent_gv = (*multi_pow_mod_p({G(), k}, {v, *q_min_c}) == a);
+
+        // 𝐴^𝑣 = 𝑏 ⋅ 𝑀^𝑐 mod 𝑝
+        auto consistent_av = (*multi_pow_mod_p({*alpha, m}, {v, *q_min_c}) == b);
+
+        auto success = inBounds_alpha && inBounds_beta && inBounds_a && inBounds_b && inBounds_k &&
+                       inBounds_m && inBounds_c && inBounds_v && consistent_c && consistent_gv &&
+                       consistent_av;
+
+        if (!success) {
+
+            map<string, bool> printMap{
+              {"inBounds_alpha", inBounds_alpha}, {"inBounds_beta", inBounds_beta},
+              {"inBounds_a", inBounds_a},         {"inBounds_b", inBounds_b},
+              {"inBounds_k", inBounds_k},         {"inBounds_m", inBounds_m},
+              {"inBounds_c", inBounds_c},         {"inBounds_v", inBounds_v},
+              {"consistent_c", consistent_c},     {"consistent_gv", consistent_gv},
+              {"consistent_av", consistent_av},
+            };
+
+            Log::info("found an invalid Chaum-Pedersen proof", printMap);
+
+            Log::debug("k->get", k.toHex());
+            Log::debug("m->get", m.toHex());
+            Log::debug("q->get", q.toHex());
+            Log::debug("alpha->get", alpha->toHex());
+            Log::debug("beta->get", beta->toHex());
+            Log::debug("a->get", a.toHex());
+            Log::debug("b->get", b.toHex());
+            Log::debug("c->get", c.toHex());
+            Log::debug("v->get", v.toHex());
+
+            return false;
+        }
+        Log::trace("ChaumPedersenProof::isValid: TRUE!");
+        return success;
+    }
+#pragma endregion
 } // namespace electionguard
@@ -0,0 +1,594 @@
+#include "electionguard/decrypt.hpp"
+
+#include "electionguard/async.hpp"
+#include "electionguard/hash.hpp"
+#include "electionguard/nonces.hpp"
+#include "facades/bignum4096.hpp"
+#include "log.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <utility>
+
+using electionguard::facades::CONTEXT_P;
+using std::future;
+using std::invalid_argument;
+using std::make_unique;
+using std::move;
+using std::pair;
+using std::reference_wrapper;
+using std::shared_lock;
+using std::shared_mutex;
+using std::to_string;
+using std::unique_lock;
+using std::unique_ptr;
+using std::vector;
+
+namespace electionguard
+{
+    // the width of the windows the exponents are recoded into. Each pad builds a single
+    // table of its powers that is shared by every exponent it is raised to, so the table
+    // is wider than the one used by `multi_pow_mod_p`
+    static constexpr uint32_t DECRYPT_WINDOW_SIZE = 5;
+    static constexpr uint32_t DECRYPT_TABLE_SIZE = 1U << DECRYPT_WINDOW_SIZE;
+
+    // the fewest pads worth handing to a scheduler task
+    static const size_t MIN_PADS_PER_TASK = 4;
+
+    /// <summary>
+    /// Recode an exponent into fixed width windows from the most significant.
+    /// Every exponent has the same number of windows, including the leading zero windows,
+    /// so the secret key and the proof nonces take the same steps whatever their value
+    /// </summary>
+    static vector<uint32_t> recodeExponent(const ElementModQ &exponent)
+    {
+        const auto *limbs = exponent.get();
+        constexpr uint32_t bits = MAX_Q_LEN * 64;
+
+        vector<uint32_t> windows;
+        windows.reserve((bits + DECRYPT_WINDOW_SIZE - 1) / DECRYPT_WINDOW_SIZE);
+        for (uint32_t offset = 0; offset < bits; offset += DECRYPT_WINDOW_SIZE) {
+            auto limb = offset / 64;
+            auto shift = offset % 64;
+            auto window = limbs[limb] >> shift;
+            // the window width does not divide the limb width so a window can straddle two limbs
+            if (shift + DECRYPT_WINDOW_SIZE > 64 && limb + 1 < MAX_Q_LEN) {
+                window |= limbs[limb + 1] << (64 - shift);
+            }
+            windows.push_back(static_cast<uint32_t>(window) & (DECRYPT_TABLE_SIZE - 1));
+        }
+        std::reverse(windows.begin(), windows.end());
+        return windows;
+    }
+
+    /// <summary>
+    /// The powers 𝐴^0 .. 𝐴^(2^w - 1) of a base in montgomery form,
+    /// built once and raised to any number of recoded exponents
+    /// </summary>
+    class PowerTable
+    {
+      public:
+        explicit PowerTable(const ElementModP &base) : entries(DECRYPT_TABLE_SIZE * MAX_P_LEN)
+        {
+            const auto &context = CONTEXT_P();
+            uint64_t one[MAX_P_LEN] = {1};
+            context.to_montgomery_form(static_cast<uint64_t *>(one), entry(0));
+            context.to_montgomery_form(const_cast<uint64_t *>(base.get()), entry(1));
+            for (uint32_t j = 2; j < DECRYPT_TABLE_SIZE; j++) {
+                context.montgomery_mod_mul_stay_in_mont_form(entry(j - 1), entry(1), entry(j));
+            }
+        }
+
+        /// <summary>
+        /// Raise the base to an exponent recoded with `recodeExponent`
+        /// </summary>
+        unique_ptr<ElementModP> pow(const vector<uint32_t> &windows)
+        {
+            const auto &context = CONTEXT_P();
+            uint64_t resultM[MAX_P_LEN] = {};
+            uint64_t selected[MAX_P_LEN] = {};
+            uint64_t temp[MAX_P_LEN] = {};
+
+            memcpy(static_cast<uint64_t *>(resultM), entry(0), MAX_P_SIZE);
+            for (size_t i = 0; i < windows.size(); i++) {
+                if (i > 0) {
+                    for (uint32_t s = 0; s < DECRYPT_WINDOW_SIZE; s++) {
+                        context.montgomery_mod_mul_stay_in_mont_form(
+                          static_cast<uint64_t *>(resultM), static_cast<uint64_t *>(resultM),
+                          static_cast<uint64_t *>(temp));
+                        memcpy(static_cast<uint64_t *>(resultM), static_cast<uint64_t *>(temp),
+                               MAX_P_SIZE);
+                    }
+                }
+                // zero windows multiply by the identity so every window costs the same
+                select(windows[i], static_cast<uint64_t *>(selected));
+                context.montgomery_mod_mul_stay_in_mont_form(static_cast<uint64_t *>(resultM),
+                                                             static_cast<uint64_t *>(selected),
+                                                             static_cast<uint64_t *>(temp));
+                memcpy(static_cast<uint64_t *>(resultM), static_cast<uint64_t *>(temp),
+                       MAX_P_SIZE);
+            }
+
+            uint64_t result[MAX_P_LEN] = {};
+            context.from_montgomery_form(static_cast<uint64_t *>(resultM),
+                                         static_cast<uint64_t *>(result));
+            return make_unique<ElementModP>(result, true);
+        }
+
+        /// <summary>
+        /// The montgomery form of 𝐴^power
+        /// </summary>
+        uint64_t *entry(uint32_t power) { return &entries[power * MAX_P_LEN]; }
+
+      private:
+        /// <summary>
+        /// Copy out an entry by reading the whole table, so the memory that is
+        /// touched does not depend on the window of the secret exponent
+        /// </summary>
+        void select(uint32_t window, uint64_t *out)
+        {
+            memset(out, 0, MAX_P_SIZE);
+            for (uint32_t j = 0; j < DECRYPT_TABLE_SIZE; j++) {
+                auto mask = static_cast<uint64_t>(0) - static_cast<uint64_t>(j == window);
+                const auto *candidate = entry(j);
+                for (uint32_t k = 0; k < MAX_P_LEN; k++) {
+                    out[k] |= candidate[k] & mask;
+                }
+            }
+        }
+
+        vector<uint64_t> entries;
+    };
+
+    /// <summary>
+    /// Split the indices [0, count) into contiguous chunks and run them on the scheduler,
+    /// or on the calling thread when the batch is too small to be worth splitting
+    /// </summary>
+    static void forEachChunk(size_t count, const std::function<void(size_t, size_t)> &work)
+    {
+        auto threads = std::max<size_t>(1, Scheduler::getThreadCount());
+        auto taskCount = std::min(threads, (count + MIN_PADS_PER_TASK - 1) / MIN_PADS_PER_TASK);
+        if (taskCount <= 1) {
+            work(0, count);
+            return;
+        }
+
+        auto chunk = (count + taskCount - 1) / taskCount;
+        vector<future<void>> tasks;
+        tasks.reserve(taskCount);
+        for (size_t begin = 0; begin < count; begin += chunk) {
+            auto end = std::min(begin + chunk, count);
+            tasks.push_back(Scheduler::submit([&work, begin, end]() { work(begin, end); }));
+        }
+        when_all(tasks);
+    }
+
+#pragma region DecryptionShare
+
+    struct DecryptionShare::Impl {
+        unique_ptr<ElementModP> share;
+        unique_ptr<ChaumPedersenProof> proof;
+
+        Impl(unique_ptr<ElementModP> share, unique_ptr<ChaumPedersenProof> proof)
+            : share(move(share)), proof(move(proof))
+        {
+        }
+
+        [[nodiscard]] unique_ptr<DecryptionShare::Impl> clone() const
+        {
+            auto _share = make_unique<ElementModP>(*share);
+            auto _proof = make_unique<ChaumPedersenProof>(*proof);
+            return make_unique<DecryptionShare::Impl>(move(_share), move(_proof));
+        }
+    };
+
+    // Lifecycle Methods
+
+    DecryptionShare::DecryptionShare(const DecryptionShare &other) : pimpl(other.pimpl->clone()) {}
+
+    DecryptionShare::DecryptionShare(DecryptionShare &&other) : pimpl(move(other.pimpl)) {}
+
+    DecryptionShare::DecryptionShare(unique_ptr<ElementModP> share,
+                                     unique_ptr<ChaumPedersenProof> proof)
+        : pimpl(new Impl(move(share), move(proof)))
+    {
+    }
+
+    DecryptionShare::~DecryptionShare() = default;
+
+    // Operator Overloads
+
+    DecryptionShare &DecryptionShare::operator=(DecryptionShare other)
+    {
+        swap(pimpl, other.pimpl);
+        return *this;
+    }
+
+    DecryptionShare &DecryptionShare::operator=(DecryptionShare &&other)
+    {
+        swap(pimpl, other.pimpl);
+        return *this;
+    }
+
+    // Property Getters
+
+    ElementModP *DecryptionShare::getShare() const { return pimpl->share.get(); }
+    ChaumPedersenProof *DecryptionShare::getProof() const { return pimpl->proof.get(); }
+
+#pragma endregion
+
+#pragma region LagrangeCoefficients
+
+    vector<ElementModQ> LagrangeCoefficients::get(const vector<uint64_t> &sequenceOrders)
+    {
+        auto sortedOrders = sequenceOrders;
+        std::sort(sortedOrders.begin(), sortedOrders.end());
+        if (!sortedOrders.empty() && sortedOrders.front() == 0) {
+            throw invalid_argument("LagrangeCoefficients: sequence orders must be non-zero");
+        }
+        if (std::adjacent_find(sortedOrders.begin(), sortedOrders.end()) != sortedOrders.end()) {
+            throw invalid_argument("LagrangeCoefficients: sequence orders must be unique");
+        }
+
+        auto &instance = getInstance();
+        vector<ElementModQ> sortedCoefficients;
+        {
+            shared_lock<shared_mutex> lock(instance.mutex);
+            auto iter = instance.cache.find(sortedOrders);
+            if (iter != instance.cache.end()) {
+                sortedCoefficients = iter->second;
+            }
+        }
+
+        // otherwise, compute the coefficients of the set and remember them
+        if (sortedCoefficients.empty() && !sortedOrders.empty()) {
+            sortedCoefficients = compute(sortedOrders);
+            unique_lock<shared_mutex> lock(instance.mutex);
+            instance.cache.emplace(sortedOrders, sortedCoefficients);
+        }
+
+        vector<ElementModQ> coefficients;
+        coefficients.reserve(sequenceOrders.size());
+        for (auto order : sequenceOrders) {
+            auto index = std::lower_bound(sortedOrders.begin(), sortedOrders.end(), order) -
+                         sortedOrders.begin();
+            coefficients.push_back(sortedCoefficients[static_cast<size_t>(index)]);
+        }
+        return coefficients;
+    }
+
+    void LagrangeCoefficients::clear()
+    {
+        auto &instance = getInstance();
+        unique_lock<shared_mutex> lock(instance.mutex);
+        instance.cache.clear();
+    }
+
+    vector<ElementModQ> LagrangeCoefficients::compute(const vector<uint64_t> &sortedOrders)
+    {
+        Log::trace("LagrangeCoefficients: computing the coefficients of " +
+                   to_string(sortedOrders.size()) + " guardians");
+        auto count = sortedOrders.size();
+        vector<ElementModQ> coordinates;
+        coordinates.reserve(count);
+        for (auto order : sortedOrders) {
+            coordinates.push_back(*ElementModQ::fromUint64(order));
+        }
+
+        // the numerator of each coefficient is the product of the other coordinates,
+        // which is the product of the coordinates before it and of those after it
+        vector<ElementModQ> numerators(count, ONE_MOD_Q());
+        ElementModQ prefix = ONE_MOD_Q();
+        for (size_t i = 0; i < count; i++) {
+            numerators[i] = prefix;
+            mul_mod_q_into(prefix, prefix, coordinates[i]);
+        }
+        ElementModQ suffix = ONE_MOD_Q();
+        for (size_t i = count; i > 0; i--) {
+            mul_mod_q_into(numerators[i - 1], numerators[i - 1], suffix);
+            mul_mod_q_into(suffix, suffix, coordinates[i - 1]);
+        }
+
+        // the denominator is the product of the differences to the other coordinates
+        vector<ElementModQ> denominators(count, ONE_MOD_Q());
+        ElementModQ difference;
+        for (size_t i = 0; i < count; i++) {
+            for (size_t j = 0; j < count; j++) {
+                if (i == j) {
+                    continue;
+                }
+                sub_mod_q_into(difference, coordinates[j], coordinates[i]);
+                mul_mod_q_into(denominators[i], denominators[i], difference);
+            }
+        }
+
+        // invert every denominator with a single modular inverse of their product,
+        // where the running products peel each inverse out of the inverse of the whole
+        vector<ElementModQ> products(count);
+        ElementModQ product = ONE_MOD_Q();
+        for (size_t i = 0; i < count; i++) {
+            mul_mod_q_into(product, product, denominators[i]);
+            products[i] = product;
+        }
+        auto inverse = div_mod_q(ONE_MOD_Q(), product);
+
+        vector<ElementModQ> coefficients(count);
+        ElementModQ denominatorInverse;
+        for (size_t i = count; i > 0; i--) {
+            if (i > 1) {
+                mul_mod_q_into(denominatorInverse, *inverse, products[i - 2]);
+            } else {
+                denominatorInverse = *inverse;
+            }
+            mul_mod_q_into(*inverse, *inverse, denominators[i - 1]);
+            mul_mod_q_into(coefficients[i - 1], numerators[i - 1], denominatorInverse);
+        }
+        return coefficients;
+    }
+
+#pragma endregion
+
+#pragma region Decrypt Functions
+
+    /// <summary>
+    /// Compute the share of a ciphertext and its proof with the table of the pad.
+    /// The proof takes the same steps as `ChaumPedersenProof::make`,
+    /// with 𝐴^𝑢 drawn from the table the share was computed with
+    /// </summary>
+    static unique_ptr<DecryptionShare>
+    makeDecryptionShare(const ElGamalCiphertext &ciphertext, PowerTable &table,
+                        const ElementModQ &secret, const vector<uint32_t> &secretWindows,
+                        const ElementModQ &seed, const ElementModQ &hashHeader)
+    {
+        auto *alpha = ciphertext.getPad();
+        auto *beta = ciphertext.getData();
+
+        // 𝑀𝑖 = 𝐴^𝑠𝑖 mod 𝑝
+        auto share = table.pow(secretWindows);
+
+        auto u = Nonces(seed, "constant-chaum-pedersen-proof").get(0);
+        auto a = g_pow_p(*u);                   // 𝑔^𝑢 mod 𝑝
+        auto b = table.pow(recodeExponent(*u)); // 𝐴^𝑢 mod 𝑝
+
+        // sha256(𝑄', A, B, a, b, 𝑀)
+        auto c = hash_elems({&const_cast<ElementModQ &>(hashHeader), alpha, beta, a.get(),
+                             b.get(), share.get()});
+        auto v = a_plus_bc_mod_q(*u, *c, secret);
+
+        auto proof = make_unique<ChaumPedersenProof>(move(a), move(b), move(c), move(v));
+        return make_unique<DecryptionShare>(move(share), move(proof));
+    }
+
+    /// <summary>
+    /// Computes Π 𝐵𝑗^𝑒𝑗 mod 𝑝 from the tables of the bases, sharing the squarings.
+    /// The exponents are public, so leading zero windows are skipped
+    /// and zero windows are not multiplied in
+    /// </summary>
+    static unique_ptr<ElementModP> multiPow(const vector<unique_ptr<PowerTable>> &tables,
+                                            const vector<vector<uint32_t>> &exponentWindows)
+    {
+        const auto &context = CONTEXT_P();
+        uint64_t resultM[MAX_P_LEN] = {};
+        uint64_t temp[MAX_P_LEN] = {};
+        memcpy(static_cast<uint64_t *>(resultM), tables.front()->entry(0), MAX_P_SIZE);
+
+        auto windowCount = exponentWindows.front().size();
+        bool isOne = true;
+        for (size_t w = 0; w < windowCount; w++) {
+            if (!isOne) {
+                for (uint32_t s = 0; s < DECRYPT_WINDOW_SIZE; s++) {
+                    context.montgomery_mod_mul_stay_in_mont_form(
+                      static_cast<uint64_t *>(resultM), static_cast<uint64_t *>(resultM),
+                      static_cast<uint64_t *>(temp));
+                    memcpy(static_cast<uint64_t *>(resultM), static_cast<uint64_t *>(temp),
+                           MAX_P_SIZE);
+                }
+            }
+            for (size_t j = 0; j < tables.size(); j++) {
+                auto window = exponentWindows[j][w];
+                if (window == 0) {
+                    continue;
+                }
+                context.montgomery_mod_mul_stay_in_mont_form(static_cast<uint64_t *>(resultM),
+                                                             tables[j]->entry(window),
+                                                             static_cast<uint64_t *>(temp));
+                memcpy(static_cast<uint64_t *>(resultM), static_cast<uint64_t *>(temp),
+                       MAX_P_SIZE);
+                isOne = false;
+            }
+        }
+
+        uint64_t result[MAX_P_LEN] = {};
+        context.from_montgomery_form(static_cast<uint64_t *>(resultM),
+                                     static_cast<uint64_t *>(result));
+        return make_unique<ElementModP>(result, true);
+    }
+
+    vector<unique_ptr<ElementModP>>
+    computePartialDecryptions(const vector<reference_wrapper<const ElementModP>> &pads,
+                              const ElementModQ &secretKey)
+    {
+        Log::trace("computePartialDecryptions: decrypting " + std::to_string(pads.size()) +
+                   " pads");
+        auto secretWindows = recodeExponent(secretKey);
+
+        vector<unique_ptr<ElementModP>> results(pads.size());
+        forEachChunk(pads.size(), [&pads, &secretWindows, &results](size_t begin, size_t end) {
+            for (auto i = begin; i < end; i++) {
+                results[i] = PowerTable(pads[i].get()).pow(secretWindows);
+            }
+        });
+        return results;
+    }
+
+    vector<unique_ptr<DecryptionShare>>
+    computeDecryptionShares(const vector<reference_wrapper<const ElGamalCiphertext>> &ciphertexts,
+                            const ElementModQ &secretKey, const ElementModQ &seed,
+                            const ElementModQ &cryptoExtendedBaseHash)
+    {
+        Log::trace("computeDecryptionShares: decrypting " + std::to_string(ciphertexts.size()) +
+                   " ciphertexts");
+        auto secretWindows = recodeExponent(secretKey);
+        Nonces seeds(seed);
+
+        vector<unique_ptr<DecryptionShare>> results(ciphertexts.size());
+        forEachChunk(ciphertexts.size(), [&](size_t begin, size_t end) {
+            for (auto i = begin; i < end; i++) {
+                const auto &ciphertext = ciphertexts[i].get();
+                PowerTable table(*ciphertext.getPad());
+                results[i] = makeDecryptionShare(ciphertext, table, secretKey, secretWindows,
+                                                 *seeds.get(i), cryptoExtendedBaseHash);
+            }
+        });
+        return results;
+    }
+
+    vector<vector<unique_ptr<DecryptionShare>>> computeCompensatedDecryptionShares(
+      const vector<reference_wrapper<const ElGamalCiphertext>> &ciphertexts,
+      const vector<reference_wrapper<const ElementModQ>> &backups, const ElementModQ &seed,
+      const ElementModQ &cryptoExtendedBaseHash)
+    {
+        Log::trace("computeCompensatedDecryptionShares: decrypting " +
+                   std::to_string(ciphertexts.size()) + " ciphertexts for " +
+                   std::to_string(backups.size()) + " missing guardians");
+        vector<vector<uint32_t>> backupWindows;
+        vector<unique_ptr<Nonces>> seeds;
+        Nonces missingSeeds(seed);
+        for (size_t m = 0; m < backups.size(); m++) {
+            backupWindows.push_back(recodeExponent(backups[m].get()));
+            seeds.push_back(make_unique<Nonces>(*missingSeeds.get(m)));
+        }
+
+        vector<vector<unique_ptr<DecryptionShare>>> results(backups.size());
+        for (auto &missingResults : results) {
+            missingResults.resize(ciphertexts.size());
+        }
+
+        // every missing guardian is compensated from the same table of each pad
+        forEachChunk(ciphertexts.size(), [&](size_t begin, size_t end) {
+            for (auto i = begin; i < end; i++) {
+                const auto &ciphertext = ciphertexts[i].get();
+                PowerTable table(*ciphertext.getPad());
+                for (size_t m = 0; m < backups.size(); m++) {
+                    results[m][i] =
+                      makeDecryptionShare(ciphertext, table, backups[m].get(), backupWindows[m],
+                                          *seeds[m]->get(i), cryptoExtendedBaseHash);
+                }
+            }
+        });
+        return results;
+    }
+
+    vector<vector<unique_ptr<ElementModP>>> computeRecoveryPublicKeys(
+      const vector<vector<reference_wrapper<const ElementModP>>> &commitments,
+      const vector<uint64_t> &sequenceOrders)
+    {
+        Log::trace("computeRecoveryPublicKeys: recovering " + std::to_string(commitments.size()) +
+                   " missing guardians for " + std::to_string(sequenceOrders.size()) +
+                   " available guardians");
+
+        size_t quorum = 0;
+        for (const auto &missingCommitments : commitments) {
+            if (missingCommitments.empty()) {
+                throw invalid_argument(
+                  "computeRecoveryPublicKeys: every missing guardian needs its commitments");
+            }
+            quorum = std::max(quorum, missingCommitments.size());
+        }
+        if (std::find(sequenceOrders.begin(), sequenceOrders.end(), 0) != sequenceOrders.end()) {
+            throw invalid_argument("computeRecoveryPublicKeys: sequence orders must be non-zero");
+        }
+
+        // the powers 𝑎^𝑗 of each available guardian are shared by every missing guardian
+        vector<vector<vector<uint32_t>>> powerWindows;
+        powerWindows.reserve(sequenceOrders.size());
+        for (auto order : sequenceOrders) {
+            auto coordinate = ElementModQ::fromUint64(order);
+            ElementModQ power = ONE_MOD_Q();
+            vector<vector<uint32_t>> windows;
+            windows.reserve(quorum);
+            for (size_t j = 0; j < quorum; j++) {
+                windows.push_back(recodeExponent(power));
+                mul_mod_q_into(power, power, *coordinate);
+            }
+            powerWindows.push_back(move(windows));
+        }
+
+        // each commitment builds its table once for every available guardian
+        vector<pair<size_t, size_t>> commitmentIndices;
+        for (size_t m = 0; m < commitments.size(); m++) {
+            for (size_t j = 0; j < commitments[m].size(); j++) {
+                commitmentIndices.emplace_back(m, j);
+            }
+        }
+        vector<vector<unique_ptr<PowerTable>>> tables(commitments.size());
+        for (size_t m = 0; m < commitments.size(); m++) {
+            tables[m].resize(commitments[m].size());
+        }
+        forEachChunk(commitmentIndices.size(), [&](size_t begin, size_t end) {
+            for (auto k = begin; k < end; k++) {
+                auto [m, j] = commitmentIndices[k];
+                tables[m][j] = make_unique<PowerTable>(commitments[m][j].get());
+            }
+        });
+
+        vector<vector<unique_ptr<ElementModP>>> results(commitments.size());
+        for (auto &missingResults : results) {
+            missingResults.resize(sequenceOrders.size());
+        }
+        auto pairs = commitments.size() * sequenceOrders.size();
+        forEachChunk(pairs, [&](size_t begin, size_t end) {
+            for (auto k = begin; k < end; k++) {
+                auto m = k / sequenceOrders.size();
+                auto a = k % sequenceOrders.size();
+                // 𝐾𝑚𝑎 = Π 𝐾𝑚𝑗^(𝑎^𝑗) mod 𝑝
+                results[m][a] = multiPow(tables[m], powerWindows[a]);
+            }
+        });
+        return results;
+    }
+
+    vector<unique_ptr<ElementModP>>
+    combineDecryptionShares(const vector<uint64_t> &sequenceOrders,
+                            const vector<vector<reference_wrapper<const ElementModP>>> &shares)
+    {
+        if (shares.size() != sequenceOrders.size()) {
+            throw invalid_argument("combineDecryptionShares: expected the shares of " +
+                                   to_string(sequenceOrders.size()) + " guardians");
+        }
+        auto count = shares.empty() ? 0 : shares.front().size();
+        for (const auto &guardianShares : shares) {
+            if (guardianShares.size() != count) {
+                throw invalid_argument(
+                  "combineDecryptionShares: every guardian must share every ciphertext");
+            }
+        }
+
+        auto coefficients = LagrangeCoefficients::get(sequenceOrders);
+        vector<reference_wrapper<const ElementModQ>> exponents(coefficients.begin(),
+                                                               coefficients.end());
+
+        vector<unique_ptr<ElementModP>> results(count);
+        forEachChunk(count, [&shares, &exponents, &results](size_t begin, size_t end) {
+            vector<reference_wrapper<const ElementModP>> bases;
+            bases.reserve(shares.size());
+            for (auto i = begin; i < end; i++) {
+                bases.clear();
+                for (const auto &guardianShares : shares) {
+                    bases.push_back(guardianShares[i]);
+                }
+                // 𝑀 = Π 𝑀𝑖^𝑤𝑖 mod 𝑝
+                results[i] = multi_pow_mod_p(bases, exponents);
+            }
+        });
+        return results;
+    }
+
+#pragma endregion
+
+} // namespace electionguard
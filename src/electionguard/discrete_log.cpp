@@ -3,82 +3,157 @@
 #include "electionguard/constants.h"
 #include "electionguard/group.hpp"
 #include "log.hpp"
+#include "utils.hpp"
 
-#include <array>
+#include <algorithm>
 #include <cmath>
 #include <cstdint>
-#include <iomanip>
-#include <iostream>
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <string>
-#include <unordered_map>
+#include <utility>
 #include <vector>
 
-using std::array;
-using std::make_unique;
-using std::move;
+using std::make_shared;
 using std::out_of_range;
-using std::string;
+using std::pair;
+using std::shared_lock;
+using std::shared_mutex;
+using std::shared_ptr;
 using std::to_string;
+using std::unique_lock;
+using std::vector;
 
 namespace electionguard
 {
+    struct DiscreteLog::BabySteps {
+        uint64_t maxExponent;
+        // the number of baby steps, which is also the size of a giant step
+        uint64_t stride;
+        // g^-stride in montgomery form
+        MontgomeryElementModP giantStep;
+        // the fingerprint of g^j paired with j, sorted by fingerprint
+        vector<pair<uint64_t, uint64_t>> fingerprints;
+
+        explicit BabySteps(uint64_t maxExponent)
+            : maxExponent(maxExponent),
+              stride(static_cast<uint64_t>(
+                std::ceil(std::sqrt(static_cast<double>(maxExponent) + 1.0))))
+        {
+            fingerprints.reserve(stride);
+            MontgomeryElementModP g(G());
+            MontgomeryElementModP current;
+            for (uint64_t j = 0; j < stride; j++) {
+                fingerprints.emplace_back(digestLimbs(current.get()), j);
+                current *= g;
+            }
+            sort(fingerprints.begin(), fingerprints.end());
+
+            auto inverseStride = sub_mod_q(ZERO_MOD_Q(), *ElementModQ::fromUint64(stride));
+            giantStep = MontgomeryElementModP(*g_pow_p(*inverseStride));
+        }
+    };
+
     uint64_t DiscreteLog::getAsync(const ElementModP &element)
     {
-        // TODO: Issue #217: implement multithreading
+        auto &instance = getInstance();
 
         // search for the existing element and return it if found
-        auto iter = getInstance().cache.find(element);
-        if (iter != getInstance().cache.end()) {
-            return iter->second;
-        }
-
         {
-            // otherwise, calculate the discrete log value
-            auto cached = getInstance().computeCache(element);
-            return cached;
+            shared_lock<shared_mutex> lock(instance.mutex);
+            auto iter = instance.cache.find(element);
+            if (iter != instance.cache.end()) {
+                return iter->second;
+            }
         }
+
+        // otherwise, calculate the discrete log value
+        auto exponent = instance.compute(element);
+
+        unique_lock<shared_mutex> lock(instance.mutex);
+        instance.cache.emplace(element, exponent);
+        return exponent;
     }
 
-    uint64_t DiscreteLog::computeCache(const ElementModP &element)
+    void DiscreteLog::setMaxExponent(uint64_t maxExponent)
     {
-        // initialize the cache with the first element
-        if (cache.empty()) {
-            cache[ONE_MOD_P()] = 0;
+        if (maxExponent > DLOG_MAX_SIZE_LIMIT) {
+            throw out_of_range("DiscreteLog: max exponent " + to_string(maxExponent) +
+                               " is larger than the limit " + to_string(DLOG_MAX_SIZE_LIMIT));
         }
 
-        // find the element with the largest exponent
-        // using a naive iteration over the cache
-        const auto *lastElementPtr = &cache.begin()->first;
-        uint64_t exponent = cache.begin()->second;
-        for (const auto &pair : cache) {
-            if (pair.second > exponent) {
-                lastElementPtr = &pair.first;
-                exponent = pair.second;
-            }
+        auto &instance = getInstance();
+        unique_lock<shared_mutex> lock(instance.mutex);
+        if (instance.maxExponent == maxExponent) {
+            return;
         }
 
-        auto lastElement = *lastElementPtr;
+        instance.maxExponent = maxExponent;
+        instance.babySteps = nullptr;
 
-        // loop until we find the element or we reach the max size
-        auto g = G();
-        while (element != lastElement) {
-            // increment the exponent
-            exponent++;
+        // solved values above the new bound are no longer reachable
+        for (auto iter = instance.cache.begin(); iter != instance.cache.end();) {
+            if (iter->second > maxExponent) {
+                iter = instance.cache.erase(iter);
+            } else {
+                iter++;
+            }
+        }
+    }
+
+    uint64_t DiscreteLog::getMaxExponent()
+    {
+        auto &instance = getInstance();
+        shared_lock<shared_mutex> lock(instance.mutex);
+        return instance.maxExponent;
+    }
 
-            // check if the exponent is larger than the max
-            if (exponent > DLOG_MAX_SIZE) {
-                throw std::out_of_range("computeCache: size is larger than max.");
+    shared_ptr<const DiscreteLog::BabySteps> DiscreteLog::getBabySteps()
+    {
+        {
+            shared_lock<shared_mutex> lock(mutex);
+            if (babySteps != nullptr) {
+                return babySteps;
             }
+        }
 
-            // multiply the last element by g
-            lastElement = *mul_mod_p(g, lastElement);
+        unique_lock<shared_mutex> lock(mutex);
+        if (babySteps == nullptr) {
+            babySteps = make_shared<const BabySteps>(maxExponent);
+        }
+        return babySteps;
+    }
+
+    uint64_t DiscreteLog::compute(const ElementModP &element)
+    {
+        auto table = getBabySteps();
+        const auto &fingerprints = table->fingerprints;
 
-            // add the new element to the cache
-            cache[lastElement] = exponent;
+        // walk element * g^(-stride * i) until it lands on a baby step g^j,
+        // at which point the exponent is stride * i + j
+        // stride * stride is larger than the max exponent so stride giant steps cover it
+        MontgomeryElementModP current(element);
+        for (uint64_t i = 0; i < table->stride; i++) {
+            auto base = i * table->stride;
+            auto key = digestLimbs(current.get());
+            auto match = std::lower_bound(fingerprints.begin(), fingerprints.end(),
+                                          pair<uint64_t, uint64_t>(key, 0));
+            for (; match != fingerprints.end() && match->first == key; match++) {
+                auto exponent = base + match->second;
+                if (exponent > table->maxExponent) {
+                    continue;
+                }
+
+                // confirm the match since fingerprints can collide
+                if (*g_pow_p(*ElementModQ::fromUint64(exponent)) == element) {
+                    return exponent;
+                }
+            }
+            current *= table->giantStep;
         }
 
-        // return the exponent since we already have the value
-        return exponent;
+        throw out_of_range("DiscreteLog: exponent is larger than max " +
+                           to_string(table->maxExponent));
     }
-} // namespace electionguard
\ No newline at end of file
+} // namespace electionguard
@@ -178,15 +178,14 @@ namespace electionguard
     std::unique_ptr<ElGamalCiphertext> ElGamalCiphertext::elgamalAdd(
       const std::vector<std::reference_wrapper<ElGamalCiphertext>> &ciphertexts)
     {
-        auto resultPad = make_unique<ElementModP>(*pimpl->pad);
-        auto resultData = make_unique<ElementModP>(*pimpl->data);
+        MontgomeryElementModP resultPad(*pimpl->pad);
+        MontgomeryElementModP resultData(*pimpl->data);
         for (auto &ciphertext : ciphertexts) {
-            auto pad = mul_mod_p(*resultPad, *ciphertext.get().pimpl->pad);
-            resultPad.swap(pad);
-            auto data = mul_mod_p(*resultData, *ciphertext.get().pimpl->data);
-            resultData.swap(data);
+            resultPad *= *ciphertext.get().pimpl->pad;
+            resultData *= *ciphertext.get().pimpl->data;
         }
-        return make_unique<ElGamalCiphertext>(move(resultPad), move(resultData));
+        return make_unique<ElGamalCiphertext>(resultPad.toElementModP(),
+                                              resultData.toElementModP());
     }
 
     uint64_t ElGamalCiphertext::decrypt(const ElementModP &product)
@@ -267,14 +266,14 @@ namespace electionguard
         return make_unique<ElGamalCiphertext>(move(pad), move(data));
     }
 
-    unique_ptr<ElGamalCiphertext> elgamalEncrypt_with_precomputed(uint64_t m, ElementModP &g_to_rho,
-                                                                  ElementModP &pubkey_to_rho)
+    unique_ptr<ElGamalCiphertext> elgamalEncrypt_with_precomputed(uint64_t m,
+                                                                  const ElementModP &g_to_rho,
+                                                                  const ElementModP &pubkey_to_rho)
     {
         ElementModP data = pubkey_to_rho;
 
         if (m == 1) {
-            unique_ptr<ElementModP> temp = mul_mod_p(G(), pubkey_to_rho);
-            data = *temp;
+            mul_mod_p_into(data, G(), pubkey_to_rho);
         }
 
         Log::trace("Generated Encryption with Precomputed Values");
@@ -292,15 +291,14 @@ namespace electionguard
             throw invalid_argument("must have one or more ciphertexts");
         }
 
-        auto resultPad = ElementModP::fromUint64(1UL);
-        auto resultData = ElementModP::fromUint64(1UL);
+        MontgomeryElementModP resultPad;
+        MontgomeryElementModP resultData;
         for (auto ciphertext : ciphertexts) {
-            auto pad = mul_mod_p(*resultPad, *ciphertext.get().getPad());
-            resultPad.swap(pad);
-            auto data = mul_mod_p(*resultData, *ciphertext.get().getData());
-            resultData.swap(data);
+            resultPad *= *ciphertext.get().getPad();
+            resultData *= *ciphertext.get().getData();
         }
-        return make_unique<ElGamalCiphertext>(move(resultPad), move(resultData));
+        return make_unique<ElGamalCiphertext>(resultPad.toElementModP(),
+                                              resultData.toElementModP());
     }
 
     unique_ptr<ElGamalCiphertext> elgamalAdd(const ElGamalCiphertext &a, const ElGamalCiphertext &b)
@@ -581,7 +579,7 @@ namespace electionguard
 
         if (shouldUsePrecomputedValues) {
             // check if the are precompute values rather than doing the exponentiations here
-            auto triple = PrecomputeBufferContext::popTriple();
+            auto triple = PrecomputeBufferContext::popTriple(publicKey);
             if (triple != nullptr && triple.has_value()) {
                 g_to_r = triple.value()->get_g_to_exp();
                 publicKey_to_r = triple.value()->get_pubkey_to_exp();
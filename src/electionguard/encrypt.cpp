@@ -17,14 +17,17 @@
 #include <iostream>
 #include <nlohmann/json.hpp>
 #include <optional>
+#include <unordered_map>
 
 using std::invalid_argument;
 using std::make_unique;
 using std::move;
 using std::optional;
+using std::reference_wrapper;
 using std::runtime_error;
 using std::to_string;
 using std::unique_ptr;
+using std::unordered_map;
 using std::vector;
 
 using electionguard::getSystemTimestamp;
@@ -159,6 +162,33 @@ namespace electionguard
         return encryptedBallot;
     }
 
+    vector<unique_ptr<CiphertextBallot>>
+    EncryptionMediator::encrypt(const vector<reference_wrapper<const PlaintextBallot>> &ballots,
+                                bool shouldVerifyProofs /* = true */,
+                                bool usePrecomputedValues /* = false */) const
+    {
+        Log::trace("encrypt: batch of " + to_string(ballots.size()) + " ballots");
+
+        // the ballots of the batch continue the chain of ballot codes
+        if (!pimpl->ballotCodeSeed) {
+            auto deviceHash = pimpl->encryptionDevice.getHash();
+            pimpl->ballotCodeSeed.swap(deviceHash);
+            Log::trace("encrypt: instantiated ballotCodeSeed:", pimpl->ballotCodeSeed->toHex());
+        }
+
+        auto encryptedBallots =
+          encryptBallots(ballots, pimpl->internalManifest, pimpl->context, *pimpl->ballotCodeSeed,
+                         pimpl->encryptionDevice.getTimestamp(), shouldVerifyProofs,
+                         usePrecomputedValues);
+
+        Log::trace("encrypt: batch encrypted");
+        if (!encryptedBallots.empty()) {
+            pimpl->ballotCodeSeed =
+              make_unique<ElementModQ>(*encryptedBallots.back()->getBallotCode());
+        }
+        return encryptedBallots;
+    }
+
     unique_ptr<CompactCiphertextBallot>
     EncryptionMediator::compactEncrypt(const PlaintextBallot &ballot,
                                        bool shouldVerifyProofs /* = true */) const
@@ -241,34 +271,28 @@ namespace electionguard
         }
 
         json writeins;
-        auto candidates = manifest.getCandidates();
-        std::vector<std::reference_wrapper<SelectionDescription>> ballotSelections;
-
-        // find the contest in the manifest
-        for (const auto &manifestContest : manifest.getContests()) {
-            if (contest.getObjectId() == manifestContest.get().getObjectId()) {
-                ballotSelections = manifestContest.get().getSelections();
+        const auto *manifestContest = manifest.getContest(contest.getObjectId());
+        unordered_map<string, const SelectionDescription *> ballotSelections;
+        if (manifestContest != nullptr) {
+            for (const auto &ballotSelection : manifestContest->getSelections()) {
+                ballotSelections.emplace(ballotSelection.get().getObjectId(),
+                                         &ballotSelection.get());
             }
         }
 
         // run through the selections in this contest and see if any of them are writeins
-        // the number of selections should be short, the number of ballot selections
-        // and candidates will be longer but shouldn't be too long
         for (const auto &selection : selections) {
             if (selection.get().getVote() == 1) {
-                for (const auto ballotSelection : ballotSelections) {
-                    if (selection.get().getObjectId() == ballotSelection.get().getObjectId()) {
-                        for (const auto &candidate : candidates) {
-                            // check if the candidate is the correct one and if it is the writein option
-                            if (ballotSelection.get().getCandidateId() ==
-                                candidate.get().getObjectId()) {
-                                if (candidate.get().isWriteIn()) {
-                                    writeins[selection.get().getObjectId()] =
-                                      selection.get().getWriteIn();
-                                }
-                            }
-                        }
-                    }
+                auto ballotSelection = ballotSelections.find(selection.get().getObjectId());
+                if (ballotSelection == ballotSelections.end()) {
+                    continue;
+                }
+
+                // check if the candidate is the writein option
+                const auto *candidate =
+                  manifest.getCandidate(ballotSelection->second->getCandidateId());
+                if (candidate != nullptr && candidate->isWriteIn()) {
+                    writeins[selection.get().getObjectId()] = selection.get().getWriteIn();
                 }
             }
         }
@@ -288,21 +312,20 @@ namespace electionguard
     unique_ptr<PlaintextBallotContest> emplaceMissingValues(const PlaintextBallotContest &contest,
                                                             const ContestDescription &description)
     {
+        // index the provided selections, the first selection with a given id wins
+        unordered_map<string, const PlaintextBallotSelection *> existing;
+        for (const auto &selection : contest.getSelections()) {
+            existing.emplace(selection.get().getObjectId(), &selection.get());
+        }
+
         vector<unique_ptr<PlaintextBallotSelection>> selections;
         // loop through the selections for the contest
         for (const auto &selectionDescription : description.getSelections()) {
-            bool hasSelection = false;
-            // loop through all the existing contests to find an existing value
-            for (const auto &selection : contest.getSelections()) {
-                if (selection.get().getObjectId() == selectionDescription.get().getObjectId()) {
-                    hasSelection = true;
-                    selections.push_back(selection.get().clone());
-                    break;
-                }
-            }
-
-            // no selections provided for the contest, so create a placeholder selection
-            if (!hasSelection) {
+            auto selection = existing.find(selectionDescription.get().getObjectId());
+            if (selection != existing.end()) {
+                selections.push_back(selection->second->clone());
+            } else {
+                // no selections provided for the contest, so create a placeholder selection
                 selections.push_back(selectionFrom(selectionDescription));
             }
         }
@@ -315,20 +338,20 @@ namespace electionguard
     {
         auto *style = manifest.getBallotStyle(ballot.getStyleId());
 
+        // index the provided contests, the first contest with a given id wins
+        unordered_map<string, const PlaintextBallotContest *> existing;
+        for (const auto &contest : ballot.getContests()) {
+            existing.emplace(contest.get().getObjectId(), &contest.get());
+        }
+
         vector<unique_ptr<PlaintextBallotContest>> contests;
         // loop through the contests for the ballot style
         for (const auto &description : manifest.getContestsFor(style->getObjectId())) {
-            bool hasContest = false;
-            // loop through all the existing contests to find an existing value
-            for (const auto &contest : ballot.getContests()) {
-                if (contest.get().getObjectId() == description.get().getObjectId()) {
-                    hasContest = true;
-                    contests.push_back(emplaceMissingValues(contest.get(), description.get()));
-                    break;
-                }
-            }
-            // no selections provided for the contest, so create a placeholder contest
-            if (!hasContest) {
+            auto contest = existing.find(description.get().getObjectId());
+            if (contest != existing.end()) {
+                contests.push_back(emplaceMissingValues(*contest->second, description.get()));
+            } else {
+                // no selections provided for the contest, so create a placeholder contest
                 contests.push_back(contestFrom(description));
             }
         }
@@ -366,12 +389,11 @@ namespace electionguard
         Log::trace("encryptSelection: precompute for " + objectId + " hash: ",
                    descriptionHash.toHex());
 
-        auto triple1 = precomputedTwoTriplesAndAQuad->get_triple1();
-        auto g_to_exp = triple1->get_g_to_exp();
-        auto pubkey_to_exp = triple1->get_pubkey_to_exp();
+        const auto &triple1 = precomputedTwoTriplesAndAQuad->triple1_ref();
 
         // Generate the encryption using precomputed values
-        auto ciphertext = elgamalEncrypt_with_precomputed(vote, *g_to_exp, *pubkey_to_exp);
+        auto ciphertext = elgamalEncrypt_with_precomputed(vote, triple1.g_to_exp_ref(),
+                                                          triple1.pubkey_to_exp_ref());
         if (ciphertext == nullptr) {
             throw runtime_error("encryptSelection:: Error generating ciphertext");
         }
@@ -450,10 +472,9 @@ namespace electionguard
 
         // check if we should use precomputed values
         if (shouldUsePrecomputedValues) {
-            // TODO: Issue #216 ensure that the PrecomputeBufferContext is the correct context
-            // associated with the elgamalPublicKey of this election.
+            // only use values precomputed for the elgamalPublicKey of this election
             auto precomputedTwoTriplesAndAQuad =
-              PrecomputeBufferContext::popTwoTriplesAndAQuadruple();
+              PrecomputeBufferContext::popTwoTriplesAndAQuadruple(elgamalPublicKey);
             if (precomputedTwoTriplesAndAQuad != nullptr &&
                 precomputedTwoTriplesAndAQuad.has_value()) {
                 encrypted =
@@ -492,7 +513,8 @@ namespace electionguard
                    const ContestDescriptionWithPlaceholders &description,
                    const ElementModP &elgamalPublicKey, const ElementModQ &cryptoExtendedBaseHash,
                    const ElementModQ &nonceSeed, bool shouldVerifyProofs /* = true */,
-                   bool shouldUsePrecomputedValues /* = true */)
+                   bool shouldUsePrecomputedValues /* = true */,
+                   bool shouldEncryptInParallel /* = false */)
 
     {
         // Validate Input
@@ -516,64 +538,57 @@ namespace electionguard
         auto chaumPedersenNonce = nonceSequence->next();
         std::shared_ptr<ElementModQ> sharedNonce(move(contestNonce));
 
-        vector<unique_ptr<CiphertextBallotSelection>> encryptedSelections;
-
         // get the writein data if there is any
         auto extendedData = getOvervoteAndWriteIns(contest, internalManifest, is_valid_contest);
 
-        // TODO: ISSUE #36: this code could be inefficient if we had a contest
-        // with a lot of choices, although the O(n^2) iteration here is small
-        // compared to the huge cost of doing the cryptography.
         uint64_t selectionCount = 0;
 
-        unique_ptr<PlaintextBallotSelection> duplicate_selection;
+        // the plaintext for each selection and placeholder to encrypt, in the order
+        // of the description. the vote values depend on the running selection count
+        // so they are always resolved serially before any encryption happens
+        vector<std::pair<const PlaintextBallotSelection *, const SelectionDescription *>> plaintexts;
+        vector<unique_ptr<PlaintextBallotSelection>> ownedPlaintexts;
 
         // iterate over the actual selections for each contest description
         // and apply the selected value if it exists.  If it does not, an explicit
         // false is entered instead and the selection_count is not incremented
-        // this allows consumers to only pass in the relevant selections made by a voter
+        // this allows consumers to only pass in the relevant selections made by a voter.
+        // the normalized contest holds one selection per description in description order
         auto normalizedContest = emplaceMissingValues(contest, description);
         auto normalizedSelections = normalizedContest->getSelections();
-        for (const auto &selectionDescription : description.getSelections()) {
-            auto description_id = selectionDescription.get().getObjectId();
-            if (auto selection =
-                  std::find_if(normalizedSelections.begin(), normalizedSelections.end(),
-                               [description_id](const PlaintextBallotSelection &item) {
-                                   return item.getObjectId() == description_id;
-                               });
-                selection != normalizedSelections.end()) {
-
-                auto isPlaceholder = false;
-
-                // track the selection count so we can append the
-                // appropriate number of true placeholder votes
-                auto selection_ptr = &selection->get();
-
-                // if the is an overvote then we need to make all the selection votes 0
-                if (is_valid_contest == OVERVOTE) {
-                    auto markOvervoteZero = 0;
-                    duplicate_selection = make_unique<PlaintextBallotSelection>(
-                      selection_ptr->getObjectId(), markOvervoteZero, isPlaceholder);
-                    selection_ptr = duplicate_selection.get();
-                }
-
-                selectionCount += selection_ptr->getVote();
+        auto selectionDescriptions = description.getSelections();
+        if (normalizedSelections.size() != selectionDescriptions.size()) {
+            // Should never happen since the contest is normalized by emplaceMissingValues
+            throw runtime_error("Error constructing encrypted selection");
+        }
 
-                // explicitly do not verify proofs when creating the encrypted selections
-                // since we may verify the proofs on the entire contest
-                encryptedSelections.push_back(encryptSelection(
-                  *selection_ptr, selectionDescription.get(), *elgamalPublicKey_ptr,
-                  *cryptoExtendedBaseHash_ptr, *sharedNonce.get(), isPlaceholder,
-                  shouldVerifyProofs, shouldUsePrecomputedValues));
-            } else {
-                // Should never happen since the contest is normalized by emplaceMissingValues
+        for (size_t i = 0; i < selectionDescriptions.size(); i++) {
+            const auto &selectionDescription = selectionDescriptions[i].get();
+            const auto *selection_ptr = &normalizedSelections[i].get();
+            if (selection_ptr->getObjectId() != selectionDescription.getObjectId()) {
                 throw runtime_error("Error constructing encrypted selection");
             }
+
+            auto isPlaceholder = false;
+
+            // if the is an overvote then we need to make all the selection votes 0
+            if (is_valid_contest == OVERVOTE) {
+                auto markOvervoteZero = 0;
+                ownedPlaintexts.push_back(make_unique<PlaintextBallotSelection>(
+                  selection_ptr->getObjectId(), markOvervoteZero, isPlaceholder));
+                selection_ptr = ownedPlaintexts.back().get();
+            }
+
+            // track the selection count so we can append the
+            // appropriate number of true placeholder votes
+            selectionCount += selection_ptr->getVote();
+            plaintexts.emplace_back(selection_ptr, &selectionDescription);
         }
 
         // Handle Placeholder selections
         // After we loop through all of the real selections on the ballot,
         // we loop through each placeholder value and determine if it should be filled in
+        auto placeholderStart = plaintexts.size();
         for (const auto &placeholder : description.getPlaceholders()) {
             bool selectPlaceholder = false;
             // if the is an overvote then we don't count any of the selections
@@ -589,12 +604,32 @@ namespace electionguard
                 }
             }
 
-            auto isPlaceholder = true;
-            auto placeholderSelection = selectionFrom(placeholder, true, selectPlaceholder);
-            encryptedSelections.push_back(
-              encryptSelection(*placeholderSelection, placeholder, *elgamalPublicKey_ptr,
-                               *cryptoExtendedBaseHash_ptr, *sharedNonce.get(), isPlaceholder,
-                               shouldVerifyProofs, shouldUsePrecomputedValues));
+            ownedPlaintexts.push_back(selectionFrom(placeholder, true, selectPlaceholder));
+            plaintexts.emplace_back(ownedPlaintexts.back().get(), &placeholder.get());
+        }
+
+        // each selection derives its own nonce from the shared contest nonce and its
+        // description hash, so the encryptions are independent of the order they run in
+        auto encryptAt = [&](size_t i) {
+            auto isPlaceholder = i >= placeholderStart;
+            return encryptSelection(*plaintexts[i].first, *plaintexts[i].second,
+                                    *elgamalPublicKey_ptr, *cryptoExtendedBaseHash_ptr,
+                                    *sharedNonce.get(), isPlaceholder, shouldVerifyProofs,
+                                    shouldUsePrecomputedValues);
+        };
+
+        vector<unique_ptr<CiphertextBallotSelection>> encryptedSelections;
+        if (shouldEncryptInParallel && plaintexts.size() > 1) {
+            vector<future<unique_ptr<CiphertextBallotSelection>>> tasks;
+            tasks.reserve(plaintexts.size());
+            for (size_t i = 0; i < plaintexts.size(); i++) {
+                tasks.push_back(Scheduler::submit([&encryptAt, i]() { return encryptAt(i); }));
+            }
+            encryptedSelections = when_all(tasks);
+        } else {
+            for (size_t i = 0; i < plaintexts.size(); i++) {
+                encryptedSelections.push_back(encryptAt(i));
+            }
         }
 
         // Derive the extendedDataNonce from the selection nonce and a constant
@@ -645,34 +680,51 @@ namespace electionguard
     encryptContests(const PlaintextBallot &ballot, const InternalManifest &internalManifest,
                     const CiphertextElectionContext &context, const ElementModQ &nonceSeed,
                     bool shouldVerifyProofs /* = true */,
-                    bool shouldUsePrecomputedValues /* = true */)
+                    bool shouldUsePrecomputedValues /* = true */,
+                    bool shouldEncryptInParallel /* = false */)
     {
         auto *style = internalManifest.getBallotStyle(ballot.getStyleId());
-        vector<unique_ptr<CiphertextBallotContest>> encryptedContests;
         auto normalizedBallot = emplaceMissingValues(ballot, internalManifest);
 
-        // TODO: Issue #217: implement this
-
-        // only iterate on contests for this specific ballot style
-        for (const auto &description : internalManifest.getContestsFor(style->getObjectId())) {
-            bool hasContest = false;
-            for (const auto &contest : normalizedBallot->getContests()) {
-                if (contest.get().getObjectId() == description.get().getObjectId()) {
-                    hasContest = true;
-                    auto encrypted = encryptContest(
-                      contest.get(), internalManifest, description.get(),
-                      *context.getElGamalPublicKey(), *context.getCryptoExtendedBaseHash(),
-                      nonceSeed, shouldVerifyProofs, shouldUsePrecomputedValues);
-
-                    encryptedContests.push_back(move(encrypted));
-                    break;
-                }
-            }
+        // only iterate on contests for this specific ballot style.
+        // the normalized ballot holds one contest per description in description order
+        auto descriptions = internalManifest.getContestsFor(style->getObjectId());
+        auto normalizedContests = normalizedBallot->getContests();
+        if (normalizedContests.size() != descriptions.size()) {
+            // Should never happen since the ballot is normalized by emplacing missing values
+            throw runtime_error("The ballot was malformed");
+        }
 
-            if (!hasContest) {
-                // Should never happen since the ballot is normalized by emplacing missing values
+        vector<std::pair<const PlaintextBallotContest *, const ContestDescriptionWithPlaceholders *>>
+          plaintexts;
+        plaintexts.reserve(descriptions.size());
+        for (size_t i = 0; i < descriptions.size(); i++) {
+            if (normalizedContests[i].get().getObjectId() != descriptions[i].get().getObjectId()) {
                 throw runtime_error("The ballot was malformed");
             }
+            plaintexts.emplace_back(&normalizedContests[i].get(), &descriptions[i].get());
+        }
+
+        auto encryptAt = [&](size_t i) {
+            return encryptContest(*plaintexts[i].first, internalManifest, *plaintexts[i].second,
+                                  *context.getElGamalPublicKey(),
+                                  *context.getCryptoExtendedBaseHash(), nonceSeed,
+                                  shouldVerifyProofs, shouldUsePrecomputedValues,
+                                  shouldEncryptInParallel);
+        };
+
+        vector<unique_ptr<CiphertextBallotContest>> encryptedContests;
+        if (shouldEncryptInParallel && plaintexts.size() > 1) {
+            vector<future<unique_ptr<CiphertextBallotContest>>> tasks;
+            tasks.reserve(plaintexts.size());
+            for (size_t i = 0; i < plaintexts.size(); i++) {
+                tasks.push_back(Scheduler::submit([&encryptAt, i]() { return encryptAt(i); }));
+            }
+            encryptedContests = when_all(tasks);
+        } else {
+            for (size_t i = 0; i < plaintexts.size(); i++) {
+                encryptedContests.push_back(encryptAt(i));
+            }
         }
         return encryptedContests;
     }
@@ -682,7 +734,8 @@ namespace electionguard
                   const CiphertextElectionContext &context, const ElementModQ &encryptionSeed,
                   unique_ptr<ElementModQ> nonce /* = nullptr */, uint64_t timestamp /* = 0 */,
                   bool shouldVerifyProofs /* = true */,
-                  bool shouldUsePrecomputedValues /* = false */)
+                  bool shouldUsePrecomputedValues /* = false */,
+                  bool shouldEncryptInParallel /* = false */)
     {
         Log::trace("encryptBallot:: encrypting");
         auto *style = manifest.getBallotStyle(ballot.getStyleId());
@@ -714,8 +767,9 @@ namespace electionguard
         Log::trace("timestamp       :", to_string(timestamp));
 
         // encrypt contests
-        auto encryptedContests = encryptContests(ballot, manifest, context, *nonceSeed,
-                                                 shouldVerifyProofs, shouldUsePrecomputedValues);
+        auto encryptedContests =
+          encryptContests(ballot, manifest, context, *nonceSeed, shouldVerifyProofs,
+                          shouldUsePrecomputedValues, shouldEncryptInParallel);
 
         // Get the system time
         if (timestamp == 0) {
@@ -749,6 +803,94 @@ namespace electionguard
         throw runtime_error("encryptBallot: failed validity check");
     }
 
+    vector<unique_ptr<CiphertextBallot>>
+    encryptBallots(const vector<reference_wrapper<const PlaintextBallot>> &ballots,
+                   const InternalManifest &manifest, const CiphertextElectionContext &context,
+                   const ElementModQ &ballotCodeSeed, uint64_t timestamp /* = 0 */,
+                   bool shouldVerifyProofs /* = true */,
+                   bool shouldUsePrecomputedValues /* = false */)
+    {
+        Log::trace("encryptBallots:: encrypting " + to_string(ballots.size()) + " ballots");
+
+        // Validate Input before scheduling any work
+        for (const auto &ballot : ballots) {
+            if (manifest.getBallotStyle(ballot.get().getStyleId()) == nullptr) {
+                throw invalid_argument("could not find a ballot style: " +
+                                       ballot.get().getStyleId());
+            }
+        }
+
+        // Generate a random seed nonce for each ballot and schedule the contest encryptions.
+        // The contests of a ballot do not depend on the ballot code chain so every ballot
+        // of the batch can be normalized, encrypted and proven concurrently
+        vector<unique_ptr<ElementModQ>> nonces;
+        vector<future<vector<unique_ptr<CiphertextBallotContest>>>> encryptions;
+        nonces.reserve(ballots.size());
+        encryptions.reserve(ballots.size());
+        for (const auto &ballot : ballots) {
+            nonces.push_back(rand_q());
+            auto nonceSeed = CiphertextBallot::nonceSeed(*manifest.getManifestHash(),
+                                                         ballot.get().getObjectId(), *nonces.back());
+            std::shared_ptr<ElementModQ> sharedNonceSeed(move(nonceSeed));
+            const auto *plaintext = &ballot.get();
+            encryptions.push_back(Scheduler::submit([&, plaintext, sharedNonceSeed]() {
+                return encryptContests(*plaintext, manifest, context, *sharedNonceSeed,
+                                       shouldVerifyProofs, shouldUsePrecomputedValues);
+            }));
+        }
+
+        // Chain the ballot codes in input order as the encryptions complete
+        // and verify each ballot while the rest of the batch is still encrypting
+        vector<unique_ptr<CiphertextBallot>> encryptedBallots;
+        vector<future<bool>> verifications;
+        encryptedBallots.reserve(ballots.size());
+        std::exception_ptr error = nullptr;
+        for (size_t i = 0; i < ballots.size(); i++) {
+            Scheduler::wait(encryptions[i]);
+            if (error != nullptr) {
+                continue;
+            }
+            try {
+                const auto &ballot = ballots[i].get();
+                const auto &codeSeed = i == 0 ? ballotCodeSeed
+                                              : *encryptedBallots[i - 1]->getBallotCode();
+                auto encryptedBallot = CiphertextBallot::make(
+                  ballot.getObjectId(), ballot.getStyleId(), *manifest.getManifestHash(),
+                  encryptions[i].get(), move(nonces[i]),
+                  timestamp == 0 ? getSystemTimestamp() : timestamp,
+                  make_unique<ElementModQ>(codeSeed), nullptr);
+                if (!encryptedBallot) {
+                    throw runtime_error("encryptBallots:: Error constructing encrypted ballot");
+                }
+
+                if (shouldVerifyProofs) {
+                    auto *encrypted = encryptedBallot.get();
+                    verifications.push_back(Scheduler::submit([&, encrypted]() {
+                        return encrypted->isValidEncryption(*manifest.getManifestHash(),
+                                                            *context.getElGamalPublicKey(),
+                                                            *context.getCryptoExtendedBaseHash());
+                    }));
+                }
+                encryptedBallots.push_back(move(encryptedBallot));
+            } catch (...) {
+                // keep waiting so no scheduled task outlives the inputs
+                error = std::current_exception();
+            }
+        }
+
+        auto results = when_all(verifications);
+        if (error != nullptr) {
+            std::rethrow_exception(error);
+        }
+        for (size_t i = 0; i < results.size(); i++) {
+            if (!results[i]) {
+                throw runtime_error("encryptBallots: failed validity check for ballot " +
+                                    encryptedBallots[i]->getObjectId());
+            }
+        }
+        return encryptedBallots;
+    }
+
     unique_ptr<CompactCiphertextBallot>
     encryptCompactBallot(const PlaintextBallot &ballot, const InternalManifest &manifest,
                          const CiphertextElectionContext &context,
@@ -8,6 +8,7 @@ extern "C" {
 #include "electionguard/chaum_pedersen.h"
 }
 
+using electionguard::ChaumPedersenProof;
 using electionguard::ConstantChaumPedersenProof;
 using electionguard::DisjunctiveChaumPedersenProof;
 using electionguard::ElementModP;
@@ -263,4 +264,67 @@ bool eg_constant_chaum_pedersen_proof_is_valid(eg_constant_chaum_pedersen_proof_
     return AS_TYPE(ConstantChaumPedersenProof, handle)->isValid(*ciphertext, *k, *q);
 }
 
-#pragma endregion
\ No newline at end of file
+#pragma endregion
+
+#pragma region ChaumPedersenProof
+
+eg_electionguard_status_t eg_chaum_pedersen_proof_free(eg_chaum_pedersen_proof_t *handle)
+{
+    if (handle == nullptr) {
+        return ELECTIONGUARD_STATUS_ERROR_INVALID_ARGUMENT;
+    }
+
+    delete AS_TYPE(ChaumPedersenProof, handle); // NOLINT(cppcoreguidelines-owning-memory)
+    handle = nullptr;
+    return ELECTIONGUARD_STATUS_SUCCESS;
+}
+
+EG_API eg_electionguard_status_t eg_chaum_pedersen_proof_get_pad(
+  eg_chaum_pedersen_proof_t *handle, eg_element_mod_p_t **out_element_ref)
+{
+    auto *element = AS_TYPE(ChaumPedersenProof, handle)->getPad();
+    *out_element_ref = AS_TYPE(eg_element_mod_p_t, element);
+    return ELECTIONGUARD_STATUS_SUCCESS;
+}
+
+EG_API eg_electionguard_status_t eg_chaum_pedersen_proof_get_data(
+  eg_chaum_pedersen_proof_t *handle, eg_element_mod_p_t **out_element_ref)
+{
+    auto *element = AS_TYPE(ChaumPedersenProof, handle)->getData();
+    *out_element_ref = AS_TYPE(eg_element_mod_p_t, element);
+    return ELECTIONGUARD_STATUS_SUCCESS;
+}
+
+EG_API eg_electionguard_status_t eg_chaum_pedersen_proof_get_challenge(
+  eg_chaum_pedersen_proof_t *handle, eg_element_mod_q_t **out_element_ref)
+{
+    auto *element = AS_TYPE(ChaumPedersenProof, handle)->getChallenge();
+    *out_element_ref = AS_TYPE(eg_element_mod_q_t, element);
+    return ELECTIONGUARD_STATUS_SUCCESS;
+}
+
+EG_API eg_electionguard_status_t eg_chaum_pedersen_proof_get_response(
+  eg_chaum_pedersen_proof_t *handle, eg_element_mod_q_t **out_element_ref)
+{
+    auto *element = AS_TYPE(ChaumPedersenProof, handle)->getResponse();
+    *out_element_ref = AS_TYPE(eg_element_mod_q_t, element);
+    return ELECTIONGUARD_STATUS_SUCCESS;
+}
+
+bool eg_chaum_pedersen_proof_is_valid(eg_chaum_pedersen_proof_t *handle,
+                                      eg_elgamal_ciphertext_t *in_ciphertext,
+                                      eg_element_mod_p_t *in_k, eg_element_mod_p_t *in_m,
+                                      eg_element_mod_q_t *in_q)
+{
+    if (handle == nullptr || in_ciphertext == nullptr || in_k == nullptr || in_m == nullptr ||
+        in_q == nullptr) {
+        return false;
+    }
+    auto *ciphertext = AS_TYPE(ElGamalCiphertext, in_ciphertext);
+    auto *k = AS_TYPE(ElementModP, in_k);
+    auto *m = AS_TYPE(ElementModP, in_m);
+    auto *q = AS_TYPE(ElementModQ, in_q);
+    return AS_TYPE(ChaumPedersenProof, handle)->isValid(*ciphertext, *k, *m, *q);
+}
+
+#pragma endregion
@@ -0,0 +1,305 @@
+#include "electionguard/decrypt.hpp"
+
+#include "../log.hpp"
+#include "convert.hpp"
+#include "variant_cast.hpp"
+
+#include <exception>
+#include <stdexcept>
+
+extern "C" {
+#include "electionguard/decrypt.h"
+}
+
+using electionguard::combineDecryptionShares;
+using electionguard::computeCompensatedDecryptionShares;
+using electionguard::computeDecryptionShares;
+using electionguard::computePartialDecryptions;
+using electionguard::computeRecoveryPublicKeys;
+using electionguard::DecryptionShare;
+using electionguard::ElementModP;
+using electionguard::ElementModQ;
+using electionguard::ElGamalCiphertext;
+using electionguard::LagrangeCoefficients;
+using electionguard::Log;
+using electionguard::uint64_to_size;
+
+using std::invalid_argument;
+using std::make_unique;
+using std::reference_wrapper;
+using std::runtime_error;
+using std::vector;
+
+#pragma region DecryptionShare
+
+eg_electionguard_status_t eg_decryption_share_free(eg_decryption_share_t *handle)
+{
+    if (handle == nullptr) {
+        return ELECTIONGUARD_STATUS_ERROR_INVALID_ARGUMENT;
+    }
+
+    delete AS_TYPE(DecryptionShare, handle); // NOLINT(cppcoreguidelines-owning-memory)
+    handle = nullptr;
+    return ELECTIONGUARD_STATUS_SUCCESS;
+}
+
+eg_electionguard_status_t eg_decryption_share_get_share(eg_decryption_share_t *handle,
+                                                        eg_element_mod_p_t **out_element_ref)
+{
+    auto *element = AS_TYPE(DecryptionShare, handle)->getShare();
+    *out_element_ref = AS_TYPE(eg_element_mod_p_t, element);
+    return ELECTIONGUARD_STATUS_SUCCESS;
+}
+
+eg_electionguard_status_t eg_decryption_share_get_proof(eg_decryption_share_t *handle,
+                                                        eg_chaum_pedersen_proof_t **out_proof_ref)
+{
+    auto *proof = AS_TYPE(DecryptionShare, handle)->getProof();
+    *out_proof_ref = AS_TYPE(eg_chaum_pedersen_proof_t, proof);
+    return ELECTIONGUARD_STATUS_SUCCESS;
+}
+
+#pragma endregion
+
+#pragma region LagrangeCoefficients
+
+eg_electionguard_status_t eg_lagrange_coefficients_get(uint64_t *in_sequence_orders,
+                                                       uint64_t in_sequence_orders_size,
+                                                       eg_element_mod_q_t *out_handles[])
+{
+    if ((in_sequence_orders == nullptr && in_sequence_orders_size > 0) || out_handles == nullptr) {
+        return ELECTIONGUARD_STATUS_ERROR_INVALID_ARGUMENT;
+    }
+
+    try {
+        auto size = uint64_to_size(in_sequence_orders_size);
+        vector<uint64_t> sequenceOrders(in_sequence_orders, in_sequence_orders + size);
+        auto coefficients = LagrangeCoefficients::get(sequenceOrders);
+        for (size_t i = 0; i < coefficients.size(); i++) {
+            auto coefficient = make_unique<ElementModQ>(coefficients[i]);
+            out_handles[i] = AS_TYPE(eg_element_mod_q_t, coefficient.release());
+        }
+        return ELECTIONGUARD_STATUS_SUCCESS;
+    } catch (const invalid_argument &e) {
+        Log::error(":eg_lagrange_coefficients_get", e);
+        return ELECTIONGUARD_STATUS_ERROR_INVALID_ARGUMENT;
+    } catch (const exception &e) {
+        Log::error(":eg_lagrange_coefficients_get", e);
+        return ELECTIONGUARD_STATUS_ERROR_BAD_ALLOC;
+    }
+}
+
+eg_electionguard_status_t eg_lagrange_coefficients_clear()
+{
+    LagrangeCoefficients::clear();
+    return ELECTIONGUARD_STATUS_SUCCESS;
+}
+
+#pragma endregion
+
+#pragma region Decrypt Functions
+
+eg_electionguard_status_t eg_compute_partial_decryptions(eg_element_mod_p_t *in_pads[],
+                                                         uint64_t in_pads_size,
+                                                         eg_element_mod_q_t *in_secret_key,
+                                                         eg_element_mod_p_t *out_handles[])
+{
+    if ((in_pads == nullptr && in_pads_size > 0) || in_secret_key == nullptr ||
+        out_handles == nullptr) {
+        return ELECTIONGUARD_STATUS_ERROR_INVALID_ARGUMENT;
+    }
+
+    try {
+        vector<reference_wrapper<const ElementModP>> pads;
+        pads.reserve(uint64_to_size(in_pads_size));
+        for (size_t i = 0; i < in_pads_size; i++) {
+            pads.push_back(*AS_TYPE(ElementModP, in_pads[i]));
+        }
+        auto *secretKey = AS_TYPE(ElementModQ, in_secret_key);
+
+        auto partials = computePartialDecryptions(pads, *secretKey);
+        for (size_t i = 0; i < partials.size(); i++) {
+            out_handles[i] = AS_TYPE(eg_element_mod_p_t, partials[i].release());
+        }
+        return ELECTIONGUARD_STATUS_SUCCESS;
+    } catch (const invalid_argument &e) {
+        Log::error(":eg_compute_partial_decryptions", e);
+        return ELECTIONGUARD_STATUS_ERROR_INVALID_ARGUMENT;
+    } catch (const runtime_error &e) {
+        Log::error(":eg_compute_partial_decryptions", e);
+        return ELECTIONGUARD_STATUS_ERROR_RUNTIME_ERROR;
+    } catch (const exception &e) {
+        Log::error(":eg_compute_partial_decryptions", e);
+        return ELECTIONGUARD_STATUS_ERROR_BAD_ALLOC;
+    }
+}
+
+eg_electionguard_status_t eg_compute_decryption_shares(
+  eg_elgamal_ciphertext_t *in_ciphertexts[], uint64_t in_ciphertexts_size,
+  eg_element_mod_q_t *in_secret_key, eg_element_mod_q_t *in_seed,
+  eg_element_mod_q_t *in_crypto_extended_base_hash, eg_decryption_share_t *out_handles[])
+{
+    if ((in_ciphertexts == nullptr && in_ciphertexts_size > 0) || in_secret_key == nullptr ||
+        in_seed == nullptr || in_crypto_extended_base_hash == nullptr || out_handles == nullptr) {
+        return ELECTIONGUARD_STATUS_ERROR_INVALID_ARGUMENT;
+    }
+
+    try {
+        vector<reference_wrapper<const ElGamalCiphertext>> ciphertexts;
+        ciphertexts.reserve(uint64_to_size(in_ciphertexts_size));
+        for (size_t i = 0; i < in_ciphertexts_size; i++) {
+            ciphertexts.push_back(*AS_TYPE(ElGamalCiphertext, in_ciphertexts[i]));
+        }
+        auto *secretKey = AS_TYPE(ElementModQ, in_secret_key);
+        auto *seed = AS_TYPE(ElementModQ, in_seed);
+        auto *extendedBaseHash = AS_TYPE(ElementModQ, in_crypto_extended_base_hash);
+
+        auto shares = computeDecryptionShares(ciphertexts, *secretKey, *seed, *extendedBaseHash);
+        for (size_t i = 0; i < shares.size(); i++) {
+            out_handles[i] = AS_TYPE(eg_decryption_share_t, shares[i].release());
+        }
+        return ELECTIONGUARD_STATUS_SUCCESS;
+    } catch (const invalid_argument &e) {
+        Log::error(":eg_compute_decryption_shares", e);
+        return ELECTIONGUARD_STATUS_ERROR_INVALID_ARGUMENT;
+    } catch (const runtime_error &e) {
+        Log::error(":eg_compute_decryption_shares", e);
+        return ELECTIONGUARD_STATUS_ERROR_RUNTIME_ERROR;
+    } catch (const exception &e) {
+        Log::error(":eg_compute_decryption_shares", e);
+        return ELECTIONGUARD_STATUS_ERROR_BAD_ALLOC;
+    }
+}
+
+eg_electionguard_status_t eg_compute_compensated_decryption_shares(
+  eg_elgamal_ciphertext_t *in_ciphertexts[], uint64_t in_ciphertexts_size,
+  eg_element_mod_q_t *in_backups[], uint64_t in_backups_size, eg_element_mod_q_t *in_seed,
+  eg_element_mod_q_t *in_crypto_extended_base_hash, eg_decryption_share_t *out_handles[])
+{
+    if ((in_ciphertexts == nullptr && in_ciphertexts_size > 0) ||
+        (in_backups == nullptr && in_backups_size > 0) || in_seed == nullptr ||
+        in_crypto_extended_base_hash == nullptr || out_handles == nullptr) {
+        return ELECTIONGUARD_STATUS_ERROR_INVALID_ARGUMENT;
+    }
+
+    try {
+        vector<reference_wrapper<const ElGamalCiphertext>> ciphertexts;
+        ciphertexts.reserve(uint64_to_size(in_ciphertexts_size));
+        for (size_t i = 0; i < in_ciphertexts_size; i++) {
+            ciphertexts.push_back(*AS_TYPE(ElGamalCiphertext, in_ciphertexts[i]));
+        }
+        vector<reference_wrapper<const ElementModQ>> backups;
+        backups.reserve(uint64_to_size(in_backups_size));
+        for (size_t m = 0; m < in_backups_size; m++) {
+            backups.push_back(*AS_TYPE(ElementModQ, in_backups[m]));
+        }
+        auto *seed = AS_TYPE(ElementModQ, in_seed);
+        auto *extendedBaseHash = AS_TYPE(ElementModQ, in_crypto_extended_base_hash);
+
+        auto shares =
+          computeCompensatedDecryptionShares(ciphertexts, backups, *seed, *extendedBaseHash);
+        for (size_t m = 0; m < shares.size(); m++) {
+            for (size_t i = 0; i < shares[m].size(); i++) {
+                out_handles[m * ciphertexts.size() + i] =
+                  AS_TYPE(eg_decryption_share_t, shares[m][i].release());
+            }
+        }
+        return ELECTIONGUARD_STATUS_SUCCESS;
+    } catch (const invalid_argument &e) {
+        Log::error(":eg_compute_compensated_decryption_shares", e);
+        return ELECTIONGUARD_STATUS_ERROR_INVALID_ARGUMENT;
+    } catch (const runtime_error &e) {
+        Log::error(":eg_compute_compensated_decryption_shares", e);
+        return ELECTIONGUARD_STATUS_ERROR_RUNTIME_ERROR;
+    } catch (const exception &e) {
+        Log::error(":eg_compute_compensated_decryption_shares", e);
+        return ELECTIONGUARD_STATUS_ERROR_BAD_ALLOC;
+    }
+}
+
+eg_electionguard_status_t eg_compute_recovery_public_keys(eg_element_mod_p_t *in_commitments[],
+                                                          uint64_t in_missing_size,
+                                                          uint64_t in_quorum,
+                                                          uint64_t *in_sequence_orders,
+                                                          uint64_t in_sequence_orders_size,
+                                                          eg_element_mod_p_t *out_handles[])
+{
+    if ((in_commitments == nullptr && in_missing_size > 0 && in_quorum > 0) ||
+        (in_sequence_orders == nullptr && in_sequence_orders_size > 0) || out_handles == nullptr) {
+        return ELECTIONGUARD_STATUS_ERROR_INVALID_ARGUMENT;
+    }
+
+    try {
+        auto missing = uint64_to_size(in_missing_size);
+        auto quorum = uint64_to_size(in_quorum);
+        auto available = uint64_to_size(in_sequence_orders_size);
+        vector<vector<reference_wrapper<const ElementModP>>> commitments(missing);
+        for (size_t m = 0; m < missing; m++) {
+            commitments[m].reserve(quorum);
+            for (size_t j = 0; j < quorum; j++) {
+                commitments[m].push_back(*AS_TYPE(ElementModP, in_commitments[m * quorum + j]));
+            }
+        }
+        vector<uint64_t> sequenceOrders(in_sequence_orders, in_sequence_orders + available);
+
+        auto keys = computeRecoveryPublicKeys(commitments, sequenceOrders);
+        for (size_t m = 0; m < keys.size(); m++) {
+            for (size_t a = 0; a < keys[m].size(); a++) {
+                out_handles[m * available + a] = AS_TYPE(eg_element_mod_p_t, keys[m][a].release());
+            }
+        }
+        return ELECTIONGUARD_STATUS_SUCCESS;
+    } catch (const invalid_argument &e) {
+        Log::error(":eg_compute_recovery_public_keys", e);
+        return ELECTIONGUARD_STATUS_ERROR_INVALID_ARGUMENT;
+    } catch (const runtime_error &e) {
+        Log::error(":eg_compute_recovery_public_keys", e);
+        return ELECTIONGUARD_STATUS_ERROR_RUNTIME_ERROR;
+    } catch (const exception &e) {
+        Log::error(":eg_compute_recovery_public_keys", e);
+        return ELECTIONGUARD_STATUS_ERROR_BAD_ALLOC;
+    }
+}
+
+eg_electionguard_status_t eg_combine_decryption_shares(uint64_t *in_sequence_orders,
+                                                       uint64_t in_guardians_size,
+                                                       eg_element_mod_p_t *in_shares[],
+                                                       uint64_t in_ciphertexts_size,
+                                                       eg_element_mod_p_t *out_handles[])
+{
+    if ((in_sequence_orders == nullptr && in_guardians_size > 0) ||
+        (in_shares == nullptr && in_guardians_size > 0 && in_ciphertexts_size > 0) ||
+        out_handles == nullptr) {
+        return ELECTIONGUARD_STATUS_ERROR_INVALID_ARGUMENT;
+    }
+
+    try {
+        auto guardians = uint64_to_size(in_guardians_size);
+        auto count = uint64_to_size(in_ciphertexts_size);
+        vector<uint64_t> sequenceOrders(in_sequence_orders, in_sequence_orders + guardians);
+        vector<vector<reference_wrapper<const ElementModP>>> shares(guardians);
+        for (size_t g = 0; g < guardians; g++) {
+            shares[g].reserve(count);
+            for (size_t i = 0; i < count; i++) {
+                shares[g].push_back(*AS_TYPE(ElementModP, in_shares[g * count + i]));
+            }
+        }
+
+        auto products = combineDecryptionShares(sequenceOrders, shares);
+        for (size_t i = 0; i < products.size(); i++) {
+            out_handles[i] = AS_TYPE(eg_element_mod_p_t, products[i].release());
+        }
+        return ELECTIONGUARD_STATUS_SUCCESS;
+    } catch (const invalid_argument &e) {
+        Log::error(":eg_combine_decryption_shares", e);
+        return ELECTIONGUARD_STATUS_ERROR_INVALID_ARGUMENT;
+    } catch (const runtime_error &e) {
+        Log::error(":eg_combine_decryption_shares", e);
+        return ELECTIONGUARD_STATUS_ERROR_RUNTIME_ERROR;
+    } catch (const exception &e) {
+        Log::error(":eg_combine_decryption_shares", e);
+        return ELECTIONGUARD_STATUS_ERROR_BAD_ALLOC;
+    }
+}
+
+#pragma endregion
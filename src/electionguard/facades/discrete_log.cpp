@@ -32,4 +32,15 @@ eg_electionguard_status_t eg_discrete_log_get_async(eg_element_mod_p_t *in_eleme
     }
 }
 
+eg_electionguard_status_t eg_discrete_log_set_max_exponent(uint64_t in_max_exponent)
+{
+    try {
+        DiscreteLog::setMaxExponent(in_max_exponent);
+        return ELECTIONGUARD_STATUS_SUCCESS;
+    } catch (const exception &e) {
+        Log::error(":eg_discrete_log_set_max_exponent", e);
+        return ELECTIONGUARD_STATUS_ERROR_BAD_ALLOC;
+    }
+}
+
 #pragma endregion
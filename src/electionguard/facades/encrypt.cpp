@@ -22,6 +22,7 @@ using electionguard::dynamicCopy;
 using electionguard::ElementModP;
 using electionguard::ElementModQ;
 using electionguard::encryptBallot;
+using electionguard::encryptBallots;
 using electionguard::encryptContest;
 using electionguard::EncryptionDevice;
 using electionguard::EncryptionMediator;
@@ -31,11 +32,14 @@ using electionguard::PlaintextBallot;
 using electionguard::PlaintextBallotContest;
 using electionguard::PlaintextBallotSelection;
 using electionguard::SelectionDescription;
+using electionguard::uint64_to_size;
 
 using std::invalid_argument;
 using std::make_unique;
+using std::reference_wrapper;
 using std::runtime_error;
 using std::unique_ptr;
+using std::vector;
 
 #pragma region EncryptionDevice
 
@@ -165,6 +169,39 @@ eg_electionguard_status_t eg_encryption_mediator_encrypt_ballot(
     }
 }
 
+eg_electionguard_status_t eg_encryption_mediator_encrypt_ballots(
+  eg_encryption_mediator_t *handle, eg_plaintext_ballot_t *in_plaintexts[],
+  uint64_t in_plaintexts_size, bool in_should_verify_proofs, bool in_use_precomputed_values,
+  eg_ciphertext_ballot_t *out_ciphertext_handles[])
+{
+    try {
+        vector<reference_wrapper<const PlaintextBallot>> plaintexts;
+        plaintexts.reserve(uint64_to_size(in_plaintexts_size));
+        for (size_t i = 0; i < in_plaintexts_size; i++) {
+            plaintexts.push_back(*AS_TYPE(PlaintextBallot, in_plaintexts[i]));
+        }
+        auto ciphertexts = AS_TYPE(EncryptionMediator, handle)
+                             ->encrypt(plaintexts, in_should_verify_proofs,
+                                       in_use_precomputed_values);
+
+        for (size_t i = 0; i < ciphertexts.size(); i++) {
+            out_ciphertext_handles[i] =
+              AS_TYPE(eg_ciphertext_ballot_t, ciphertexts[i].release());
+        }
+        return ELECTIONGUARD_STATUS_SUCCESS;
+
+    } catch (const invalid_argument &e) {
+        Log::error(":eg_encryption_mediator_encrypt_ballots", e);
+        return ELECTIONGUARD_STATUS_ERROR_INVALID_ARGUMENT;
+    } catch (const runtime_error &e) {
+        Log::error(":eg_encryption_mediator_encrypt_ballots", e);
+        return ELECTIONGUARD_STATUS_ERROR_RUNTIME_ERROR;
+    } catch (const exception &e) {
+        Log::error(":eg_encryption_mediator_encrypt_ballots", e);
+        return ELECTIONGUARD_STATUS_ERROR_BAD_ALLOC;
+    }
+}
+
 eg_electionguard_status_t eg_encryption_mediator_compact_encrypt_ballot(
   eg_encryption_mediator_t *handle, eg_plaintext_ballot_t *in_plaintext,
   eg_compact_ciphertext_ballot_t **out_ciphertext_handle)
@@ -337,6 +374,40 @@ eg_encrypt_ballot(eg_plaintext_ballot_t *in_plaintext, eg_internal_manifest_t *i
     }
 }
 
+eg_electionguard_status_t
+eg_encrypt_ballots(eg_plaintext_ballot_t *in_plaintexts[], uint64_t in_plaintexts_size,
+                   eg_internal_manifest_t *in_manifest, eg_ciphertext_election_context_t *in_context,
+                   eg_element_mod_q_t *in_ballot_code_seed, bool in_should_verify_proofs,
+                   bool in_use_precomputed_values, eg_ciphertext_ballot_t *out_handles[])
+{
+    try {
+        vector<reference_wrapper<const PlaintextBallot>> plaintexts;
+        plaintexts.reserve(uint64_to_size(in_plaintexts_size));
+        for (size_t i = 0; i < in_plaintexts_size; i++) {
+            plaintexts.push_back(*AS_TYPE(PlaintextBallot, in_plaintexts[i]));
+        }
+        auto *manifest = AS_TYPE(InternalManifest, in_manifest);
+        auto *context = AS_TYPE(CiphertextElectionContext, in_context);
+        auto *code_seed = AS_TYPE(ElementModQ, in_ballot_code_seed);
+
+        auto ciphertexts = encryptBallots(plaintexts, *manifest, *context, *code_seed, 0ULL,
+                                          in_should_verify_proofs, in_use_precomputed_values);
+        for (size_t i = 0; i < ciphertexts.size(); i++) {
+            out_handles[i] = AS_TYPE(eg_ciphertext_ballot_t, ciphertexts[i].release());
+        }
+        return ELECTIONGUARD_STATUS_SUCCESS;
+    } catch (const invalid_argument &e) {
+        Log::error(":eg_encrypt_ballots", e);
+        return ELECTIONGUARD_STATUS_ERROR_INVALID_ARGUMENT;
+    } catch (const runtime_error &e) {
+        Log::error(":eg_encrypt_ballots", e);
+        return ELECTIONGUARD_STATUS_ERROR_RUNTIME_ERROR;
+    } catch (const exception &e) {
+        Log::error(":eg_encrypt_ballots", e);
+        return ELECTIONGUARD_STATUS_ERROR_BAD_ALLOC;
+    }
+}
+
 eg_electionguard_status_t eg_encrypt_ballot_with_nonce(
   eg_plaintext_ballot_t *in_plaintext, eg_internal_manifest_t *in_manifest,
   eg_ciphertext_election_context_t *in_context, eg_element_mod_q_t *in_ballot_code_seed,
@@ -106,8 +106,9 @@ eg_electionguard_status_t eg_element_mod_p_get_data(eg_element_mod_p_t *handle,
         return ELECTIONGUARD_STATUS_ERROR_INVALID_ARGUMENT;
     }
 
+    // the data is read only, handles can refer to constants such as the fixed base G
     auto *element = AS_TYPE(ElementModP, handle);
-    *out_data = element->get();
+    *out_data = const_cast<uint64_t *>(element->get());
     *out_size = (uint64_t)MAX_P_LEN;
 
     return ELECTIONGUARD_STATUS_SUCCESS;
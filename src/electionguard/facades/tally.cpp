@@ -0,0 +1,166 @@
+#include "electionguard/tally.hpp"
+
+#include "../log.hpp"
+#include "convert.hpp"
+#include "variant_cast.hpp"
+
+#include <exception>
+#include <stdexcept>
+
+extern "C" {
+#include "electionguard/tally.h"
+}
+
+using electionguard::CiphertextBallot;
+using electionguard::CiphertextElectionContext;
+using electionguard::CiphertextTally;
+using electionguard::dynamicCopy;
+using electionguard::InternalManifest;
+using electionguard::Log;
+using electionguard::uint64_to_size;
+
+using std::invalid_argument;
+using std::make_unique;
+using std::reference_wrapper;
+using std::runtime_error;
+using std::string;
+using std::vector;
+
+#pragma region CiphertextTally
+
+eg_electionguard_status_t eg_ciphertext_tally_new(char *in_object_id,
+                                                  eg_internal_manifest_t *in_manifest,
+                                                  eg_ciphertext_election_context_t *in_context,
+                                                  eg_ciphertext_tally_t **out_handle)
+{
+    if (in_object_id == nullptr || in_manifest == nullptr || in_context == nullptr) {
+        return ELECTIONGUARD_STATUS_ERROR_INVALID_ARGUMENT;
+    }
+
+    try {
+        auto *manifest = AS_TYPE(InternalManifest, in_manifest);
+        auto *context = AS_TYPE(CiphertextElectionContext, in_context);
+        auto tally = make_unique<CiphertextTally>(string(in_object_id), *manifest, *context);
+        *out_handle = AS_TYPE(eg_ciphertext_tally_t, tally.release());
+        return ELECTIONGUARD_STATUS_SUCCESS;
+    } catch (const exception &e) {
+        Log::error(":eg_ciphertext_tally_new", e);
+        return ELECTIONGUARD_STATUS_ERROR_BAD_ALLOC;
+    }
+}
+
+eg_electionguard_status_t eg_ciphertext_tally_free(eg_ciphertext_tally_t *handle)
+{
+    if (handle == nullptr) {
+        return ELECTIONGUARD_STATUS_ERROR_INVALID_ARGUMENT;
+    }
+
+    delete AS_TYPE(CiphertextTally, handle); // NOLINT(cppcoreguidelines-owning-memory)
+    handle = nullptr;
+    return ELECTIONGUARD_STATUS_SUCCESS;
+}
+
+eg_electionguard_status_t eg_ciphertext_tally_accumulate(eg_ciphertext_tally_t *handle,
+                                                         eg_ciphertext_ballot_t *in_ballots[],
+                                                         uint64_t in_ballots_size,
+                                                         bool in_skip_validation,
+                                                         uint64_t *out_accumulated)
+{
+    if (handle == nullptr || (in_ballots == nullptr && in_ballots_size > 0)) {
+        return ELECTIONGUARD_STATUS_ERROR_INVALID_ARGUMENT;
+    }
+
+    try {
+        vector<reference_wrapper<const CiphertextBallot>> ballots;
+        ballots.reserve(uint64_to_size(in_ballots_size));
+        for (size_t i = 0; i < in_ballots_size; i++) {
+            ballots.push_back(*AS_TYPE(CiphertextBallot, in_ballots[i]));
+        }
+
+        auto results = AS_TYPE(CiphertextTally, handle)->accumulate(ballots, in_skip_validation);
+
+        uint64_t accumulated = 0;
+        for (auto result : results) {
+            accumulated += result ? 1 : 0;
+        }
+        *out_accumulated = accumulated;
+        return ELECTIONGUARD_STATUS_SUCCESS;
+    } catch (const invalid_argument &e) {
+        Log::error(":eg_ciphertext_tally_accumulate", e);
+        return ELECTIONGUARD_STATUS_ERROR_INVALID_ARGUMENT;
+    } catch (const runtime_error &e) {
+        Log::error(":eg_ciphertext_tally_accumulate", e);
+        return ELECTIONGUARD_STATUS_ERROR_RUNTIME_ERROR;
+    } catch (const exception &e) {
+        Log::error(":eg_ciphertext_tally_accumulate", e);
+        return ELECTIONGUARD_STATUS_ERROR_BAD_ALLOC;
+    }
+}
+
+eg_electionguard_status_t eg_ciphertext_tally_accumulate_files(eg_ciphertext_tally_t *handle,
+                                                               char *in_path,
+                                                               uint64_t in_max_buffered_bytes,
+                                                               uint64_t *out_accumulated)
+{
+    if (handle == nullptr || in_path == nullptr) {
+        return ELECTIONGUARD_STATUS_ERROR_INVALID_ARGUMENT;
+    }
+
+    try {
+        *out_accumulated = AS_TYPE(CiphertextTally, handle)
+                             ->accumulateFiles(string(in_path), in_max_buffered_bytes);
+        return ELECTIONGUARD_STATUS_SUCCESS;
+    } catch (const invalid_argument &e) {
+        Log::error(":eg_ciphertext_tally_accumulate_files", e);
+        return ELECTIONGUARD_STATUS_ERROR_INVALID_ARGUMENT;
+    } catch (const runtime_error &e) {
+        Log::error(":eg_ciphertext_tally_accumulate_files", e);
+        return ELECTIONGUARD_STATUS_ERROR_RUNTIME_ERROR;
+    } catch (const exception &e) {
+        Log::error(":eg_ciphertext_tally_accumulate_files", e);
+        return ELECTIONGUARD_STATUS_ERROR_BAD_ALLOC;
+    }
+}
+
+uint64_t eg_ciphertext_tally_get_selections_size(eg_ciphertext_tally_t *handle)
+{
+    return AS_TYPE(CiphertextTally, handle)->getSelectionIds().size();
+}
+
+eg_electionguard_status_t eg_ciphertext_tally_get_selection_object_id_at(
+  eg_ciphertext_tally_t *handle, uint64_t in_index, char **out_object_id)
+{
+    try {
+        auto selectionIds = AS_TYPE(CiphertextTally, handle)->getSelectionIds();
+        if (in_index >= selectionIds.size()) {
+            return ELECTIONGUARD_STATUS_ERROR_INVALID_ARGUMENT;
+        }
+        *out_object_id = dynamicCopy(selectionIds[uint64_to_size(in_index)]);
+        return ELECTIONGUARD_STATUS_SUCCESS;
+    } catch (const exception &e) {
+        Log::error(":eg_ciphertext_tally_get_selection_object_id_at", e);
+        return ELECTIONGUARD_STATUS_ERROR_BAD_ALLOC;
+    }
+}
+
+eg_electionguard_status_t eg_ciphertext_tally_get_ciphertexts(
+  eg_ciphertext_tally_t *handle, eg_elgamal_ciphertext_t *out_ciphertexts[])
+{
+    if (handle == nullptr || out_ciphertexts == nullptr) {
+        return ELECTIONGUARD_STATUS_ERROR_INVALID_ARGUMENT;
+    }
+
+    try {
+        auto selections = AS_TYPE(CiphertextTally, handle)->getSelections();
+        for (size_t i = 0; i < selections.size(); i++) {
+            auto ciphertext = selections[i]->getCiphertext()->clone();
+            out_ciphertexts[i] = AS_TYPE(eg_elgamal_ciphertext_t, ciphertext.release());
+        }
+        return ELECTIONGUARD_STATUS_SUCCESS;
+    } catch (const exception &e) {
+        Log::error(":eg_ciphertext_tally_get_ciphertexts", e);
+        return ELECTIONGUARD_STATUS_ERROR_BAD_ALLOC;
+    }
+}
+
+#pragma endregion
@@ -11,8 +11,11 @@
 #include "random.hpp"
 #include "utils.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <cstdint>
+#include <cstring>
 #include <iomanip>
 #include <iostream>
 #include <random>
@@ -32,6 +35,7 @@ using std::get;
 using std::holds_alternative;
 using std::invalid_argument;
 using std::make_unique;
+using std::memory_order_relaxed;
 using std::move;
 using std::out_of_range;
 using std::overflow_error;
@@ -39,6 +43,7 @@ using std::reference_wrapper;
 using std::runtime_error;
 using std::to_string;
 using std::unique_ptr;
+using std::vector;
 
 namespace electionguard
 {
@@ -110,153 +115,290 @@ namespace electionguard
 
 #pragma region ElementModP
 
-    struct ElementModP::Impl {
+    // the helpers for the jacobi symbol only touch the lowest `length` limbs,
+    // which shrinks as the values are reduced
 
-        bool isFixedBase = false;
-        uint64_t data[MAX_P_LEN] = {};
-        string hexRepresentation;
+    // a >>= bits for a shift of less than 64 * length bits
+    static void shiftRight(uint64_t *a, uint32_t length, uint32_t bits)
+    {
+        auto limbs = bits / 64;
+        auto offset = bits % 64;
+        for (uint32_t i = 0; i < length; i++) {
+            uint64_t low = i + limbs < length ? a[i + limbs] : 0;
+            uint64_t high = i + limbs + 1 < length ? a[i + limbs + 1] : 0;
+            a[i] = offset == 0 ? low : (low >> offset) | (high << (64 - offset));
+        }
+    }
 
-        Impl(const vector<uint64_t> &elem, bool unchecked, bool fixedBase)
-        {
-            uint64_t array[MAX_P_LEN] = {};
-            copy(elem.begin(), elem.end(), static_cast<uint64_t *>(array));
-            if (!unchecked && Bignum4096::lessThan(const_cast<uint64_t *>(P().get()),
-                                                   static_cast<uint64_t *>(array)) > 0) {
-                throw out_of_range("Value for ElementModP is greater than allowed");
-            }
-            isFixedBase = fixedBase;
-            copy(begin(array), end(array), begin(data));
-        };
+    // the value must not be zero
+    static uint32_t countTrailingZeros(const uint64_t *a)
+    {
+        uint32_t zeros = 0;
+        uint32_t i = 0;
+        for (; a[i] == 0; i++) {
+            zeros += 64;
+        }
+        for (auto limb = a[i]; (limb & 1) == 0; limb >>= 1) {
+            zeros++;
+        }
+        return zeros;
+    }
+
+    // a -= b for a >= b
+    static void subtractInPlace(uint64_t *a, const uint64_t *b, uint32_t length)
+    {
+        uint64_t borrow = 0;
+        for (uint32_t i = 0; i < length; i++) {
+            auto difference = a[i] - b[i];
+            auto nextBorrow = static_cast<uint64_t>(a[i] < b[i]);
+            nextBorrow |= static_cast<uint64_t>(difference < borrow);
+            a[i] = difference - borrow;
+            borrow = nextBorrow;
+        }
+    }
 
-        Impl(const uint64_t (&elem)[MAX_P_LEN], bool unchecked, bool fixedBase)
-        {
-            if (!unchecked && Bignum4096::lessThan(const_cast<uint64_t *>(P().get()),
-                                                   const_cast<uint64_t *>(elem)) > 0) {
-                throw out_of_range("Value for ElementModP is greater than allowed");
+    static bool isLessThan(const uint64_t *a, const uint64_t *b, uint32_t length)
+    {
+        for (uint32_t i = length; i > 0; i--) {
+            if (a[i - 1] != b[i - 1]) {
+                return a[i - 1] < b[i - 1];
             }
-            isFixedBase = fixedBase;
-            copy(begin(elem), end(elem), begin(data));
-        };
+        }
+        return false;
+    }
 
-        ~Impl() { hacl::Lib::memZero(static_cast<uint64_t *>(data), MAX_P_LEN); };
+    // Evaluates the jacobi symbol (a/p) with the binary algorithm, which costs
+    // far less than the exponentiation of Euler's criterion. The element must be in [1, P)
+    static bool isQuadraticResidue(const uint64_t (&element)[MAX_P_LEN])
+    {
+        uint64_t x[MAX_P_LEN] = {};
+        uint64_t n[MAX_P_LEN] = {};
+        memcpy(static_cast<uint64_t *>(x), static_cast<const uint64_t *>(element), MAX_P_SIZE);
+        memcpy(static_cast<uint64_t *>(n), static_cast<const uint64_t *>(P_ARRAY_REVERSE),
+               MAX_P_SIZE);
+        uint64_t *a = static_cast<uint64_t *>(x);
+        uint64_t *b = static_cast<uint64_t *>(n);
+        uint32_t length = MAX_P_LEN;
+
+        bool negative = false;
+        while (true) {
+            while (length > 0 && a[length - 1] == 0 && b[length - 1] == 0) {
+                length--;
+            }
+            bool isZero = true;
+            for (uint32_t i = 0; i < length && isZero; i++) {
+                isZero = a[i] == 0;
+            }
+            if (isZero) {
+                break;
+            }
 
-        [[nodiscard]] unique_ptr<ElementModP::Impl> clone() const
-        {
-            return make_unique<ElementModP::Impl>(data, true, isFixedBase);
-        }
+            // (2/n) = -1 when n = 3 or 5 mod 8
+            auto zeros = countTrailingZeros(a);
+            shiftRight(a, length, zeros);
+            auto nMod8 = b[0] & 7;
+            if ((zeros & 1) == 1 && (nMod8 == 3 || nMod8 == 5)) {
+                negative = !negative;
+            }
 
-        bool operator==(const Impl &other)
-        {
-            for (uint8_t i = 0; i < MAX_P_LEN; i++) {
-                auto l = data[i];
-                auto r = other.data[i];
-                if (l != r) {
-                    return false;
+            // quadratic reciprocity: (a/n) = -(n/a) when a = n = 3 mod 4
+            if (isLessThan(a, b, length)) {
+                std::swap(a, b);
+                if ((a[0] & 3) == 3 && (b[0] & 3) == 3) {
+                    negative = !negative;
                 }
             }
-            return true;
+            subtractInPlace(a, b, length);
         }
 
-        bool operator<(const Impl &other)
-        {
-            auto other_ = other;
-            return Bignum4096::lessThan(static_cast<uint64_t *>(data),
-                                        static_cast<uint64_t *>(other_.data)) > 0;
+        // the gcd is left in b and is one since p is prime
+        bool isOne = b[0] == 1;
+        for (uint32_t i = 1; i < length && isOne; i++) {
+            isOne = b[i] == 0;
         }
-    };
+        return !negative && isOne;
+    }
 
     // Lifecycle Methods
 
-    ElementModP::ElementModP(const ElementModP &other) : pimpl(other.pimpl->clone()) {}
+    ElementModP::ElementModP() : data(), fixedBase(false), verifiedResidue(false) {}
+
+    ElementModP::ElementModP(const ElementModP &other)
+        : fixedBase(other.fixedBase.load(memory_order_relaxed)),
+          verifiedResidue(other.verifiedResidue.load(memory_order_relaxed))
+    {
+        memcpy(static_cast<uint64_t *>(data), static_cast<uint64_t *>(other.data), MAX_P_SIZE);
+    }
 
-    ElementModP::ElementModP(ElementModP &&other) = default;
+    ElementModP::ElementModP(ElementModP &&other) : ElementModP(other) {}
 
     ElementModP::ElementModP(const vector<uint64_t> &elem, bool unchecked /* = false */,
                              bool fixedBase /* = false */)
-        : pimpl(new Impl(elem, unchecked, fixedBase))
+        : data(), fixedBase(fixedBase), verifiedResidue(false)
     {
+        if (elem.size() > MAX_P_LEN) {
+            throw out_of_range("Value for ElementModP is greater than allowed");
+        }
+        copy(elem.begin(), elem.end(), static_cast<uint64_t *>(data));
+        if (!unchecked && Bignum4096::lessThan(const_cast<uint64_t *>(P().get()),
+                                               static_cast<uint64_t *>(data)) > 0) {
+            hacl::Lib::memZero(static_cast<uint64_t *>(data), MAX_P_LEN);
+            throw out_of_range("Value for ElementModP is greater than allowed");
+        }
     }
 
     ElementModP::ElementModP(const uint64_t (&elem)[MAX_P_LEN], bool unchecked /* = false */,
                              bool fixedBase /* = false */)
-        : pimpl(new Impl(elem, unchecked, fixedBase))
+        : fixedBase(fixedBase), verifiedResidue(false)
     {
+        if (!unchecked && Bignum4096::lessThan(const_cast<uint64_t *>(P().get()),
+                                               const_cast<uint64_t *>(elem)) > 0) {
+            throw out_of_range("Value for ElementModP is greater than allowed");
+        }
+        memcpy(static_cast<uint64_t *>(data), static_cast<const uint64_t *>(elem), MAX_P_SIZE);
     }
 
-    ElementModP::~ElementModP() = default;
+    ElementModP::~ElementModP() { hacl::Lib::memZero(static_cast<uint64_t *>(data), MAX_P_LEN); }
 
     // Operator Overloads
 
-    ElementModP &ElementModP::operator=(ElementModP other)
+    ElementModP &ElementModP::operator=(const ElementModP &other)
     {
-        swap(pimpl, other.pimpl);
+        if (this != &other) {
+            memcpy(static_cast<uint64_t *>(data), static_cast<uint64_t *>(other.data),
+                   MAX_P_SIZE);
+            fixedBase.store(other.fixedBase.load(memory_order_relaxed), memory_order_relaxed);
+            verifiedResidue.store(other.verifiedResidue.load(memory_order_relaxed),
+                                  memory_order_relaxed);
+        }
         return *this;
     }
 
-    bool ElementModP::operator==(const ElementModP &other) { return *pimpl == *other.pimpl; }
-
-    bool ElementModP::operator==(const ElementModP &other) const { return *pimpl == *other.pimpl; }
+    ElementModP &ElementModP::operator=(ElementModP &&other)
+    {
+        return *this = static_cast<const ElementModP &>(other);
+    }
 
-    bool ElementModP::operator!=(const ElementModP &other) { return !(*this == other); }
+    bool ElementModP::operator==(const ElementModP &other) const
+    {
+        return memcmp(static_cast<uint64_t *>(data), static_cast<uint64_t *>(other.data),
+                      MAX_P_SIZE) == 0;
+    }
 
     bool ElementModP::operator!=(const ElementModP &other) const { return !(*this == other); }
 
-    bool ElementModP::operator<(const ElementModP &other) { return *pimpl < *other.pimpl; }
-
-    bool ElementModP::operator<(const ElementModP &other) const { return *pimpl < *other.pimpl; }
+    bool ElementModP::operator<(const ElementModP &other) const
+    {
+        return Bignum4096::lessThan(static_cast<uint64_t *>(data),
+                                    static_cast<uint64_t *>(other.data)) > 0;
+    }
 
     // Property Getters
 
-    uint64_t *ElementModP::get() const { return static_cast<uint64_t *>(pimpl->data); }
+    const uint64_t *ElementModP::get() const { return static_cast<const uint64_t *>(data); }
+
+    uint64_t *ElementModP::getMutable()
+    {
+        fixedBase.store(false, memory_order_relaxed);
+        verifiedResidue.store(false, memory_order_relaxed);
+        return static_cast<uint64_t *>(data);
+    }
 
-    uint64_t (&ElementModP::ref() const)[MAX_P_LEN] { return pimpl->data; }
+    const uint64_t (&ElementModP::ref() const)[MAX_P_LEN] { return data; }
 
     uint64_t ElementModP::length() const { return MAX_P_LEN; }
 
-    bool ElementModP::isFixedBase() const { return pimpl->isFixedBase; }
+    bool ElementModP::isFixedBase() const { return fixedBase.load(memory_order_relaxed); }
 
-    bool ElementModP::isInBounds() const
+    bool ElementModP::isInBounds() const { return ZERO_MOD_P() < *this && *this < P(); }
+
+    bool ElementModP::isValidResidue() const
     {
-        return (const_cast<ElementModP &>(ZERO_MOD_P()) < *this) &&
-               (const_cast<ElementModP &>(*this) < P());
+        if (verifiedResidue.load(memory_order_relaxed)) {
+            return true;
+        }
+        auto valid = this->isInBounds() && *pow_mod_p(*this, Q()) == ONE_MOD_P();
+        if (valid) {
+            verifiedResidue.store(true, memory_order_relaxed);
+        }
+        return valid;
     }
-    bool ElementModP::isValidResidue() const
+
+    vector<bool>
+    ElementModP::isValidResidueBatch(const vector<reference_wrapper<const ElementModP>> &elements)
     {
-        auto residue = (*pow_mod_p(*this, Q()) == const_cast<ElementModP &>(ONE_MOD_P()));
-        return this->isInBounds() && residue;
+        vector<bool> results(elements.size(), false);
+        vector<size_t> pending;
+        pending.reserve(elements.size());
+        for (size_t i = 0; i < elements.size(); i++) {
+            const auto &element = elements[i].get();
+            if (element.verifiedResidue.load(memory_order_relaxed)) {
+                results[i] = true;
+            } else if (element.isInBounds() && isQuadraticResidue(element.data)) {
+                pending.push_back(i);
+            }
+        }
+
+#ifndef USE_TEST_PRIMES
+        // the product test needs the cofactor (p - 1) / q to be twice a large prime.
+        // the jacobi symbol rules out the factor of two and the random exponents
+        // make it unlikely that elements outside of Z^r_p cancel each other out
+        if (pending.size() > 1) {
+            vector<ElementModQ> exponents;
+            exponents.reserve(pending.size());
+            for (auto exponent : Random::getBatchExponents(pending.size())) {
+                exponents.push_back(*ElementModQ::fromUint64(exponent, true));
+            }
+            vector<reference_wrapper<const ElementModP>> bases;
+            vector<reference_wrapper<const ElementModQ>> baseExponents;
+            bases.reserve(pending.size());
+            baseExponents.reserve(pending.size());
+            for (size_t i = 0; i < pending.size(); i++) {
+                bases.push_back(elements[pending[i]]);
+                baseExponents.push_back(exponents[i]);
+            }
+            auto product = multi_pow_mod_p(bases, baseExponents);
+            if (*pow_mod_p(*product, Q()) == ONE_MOD_P()) {
+                for (auto i : pending) {
+                    elements[i].get().verifiedResidue.store(true, memory_order_relaxed);
+                    results[i] = true;
+                }
+                return results;
+            }
+        }
+#endif
+
+        // check each element to find the invalid ones
+        for (auto i : pending) {
+            results[i] = elements[i].get().isValidResidue();
+        }
+        return results;
     }
 
     vector<uint8_t> ElementModP::toBytes() const
     {
         uint8_t byteResult[MAX_P_SIZE] = {};
         // Use Hacl to convert the bignum to byte array
-        Bignum4096::toBytes(static_cast<uint64_t *>(pimpl->data),
-                            static_cast<uint8_t *>(byteResult));
+        Bignum4096::toBytes(static_cast<uint64_t *>(data), static_cast<uint8_t *>(byteResult));
         return vector<uint8_t>(begin(byteResult), end(byteResult));
     }
 
     string ElementModP::toHex() const
     {
-        if (!pimpl->hexRepresentation.empty()) {
-            return pimpl->hexRepresentation;
-        }
-
         // Returned bytes array from Hacl needs to be pre-allocated to 512 bytes
         uint8_t byteResult[MAX_P_SIZE] = {};
         // Use Hacl to convert the bignum to byte array
-        Bignum4096::toBytes(static_cast<uint64_t *>(pimpl->data),
-                            static_cast<uint8_t *>(byteResult));
-        pimpl->hexRepresentation = bytes_to_hex(byteResult);
-        return pimpl->hexRepresentation;
+        Bignum4096::toBytes(static_cast<uint64_t *>(data), static_cast<uint8_t *>(byteResult));
+        return bytes_to_hex(byteResult);
     }
 
-    std::unique_ptr<ElementModP> ElementModP::clone() const
+    std::unique_ptr<ElementModP> ElementModP::clone() const { return make_unique<ElementModP>(*this); }
+
+    void ElementModP::setIsFixedBase(bool fixedBase) const
     {
-        return make_unique<ElementModP>(pimpl->data, true, pimpl->isFixedBase);
+        this->fixedBase.store(fixedBase, memory_order_relaxed);
     }
 
-    void ElementModP::setIsFixedBase(bool fixedBase) const { pimpl->isFixedBase = fixedBase; }
-
     // Static Methods
 
     unique_ptr<ElementModP> ElementModP::fromHex(const string &representation,
@@ -272,123 +414,91 @@ namespace electionguard
     unique_ptr<ElementModP> ElementModP::fromUint64(uint64_t representation,
                                                     bool unchecked /* = false */)
     {
-        const size_t bitWidth = 8U;
-        uint64_t bigEndian = htobe64(representation);
-        return bytes_to_p(reinterpret_cast<uint8_t *>(&bigEndian), bitWidth, unchecked);
+        uint64_t limbs[MAX_P_LEN] = {representation};
+        return make_unique<ElementModP>(limbs, unchecked);
     }
 
 #pragma endregion
 
 #pragma region ElementModQ
 
-    struct ElementModQ::Impl {
-
-        uint64_t data[MAX_Q_LEN] = {};
-
-        Impl(const vector<uint64_t> &elem, bool unchecked)
-        {
-            uint64_t array[MAX_Q_LEN] = {};
-            copy(elem.begin(), elem.end(), static_cast<uint64_t *>(array));
-            if (!unchecked && Bignum256::lessThan(const_cast<uint64_t *>(Q().get()),
-                                                  static_cast<uint64_t *>(array)) > 0) {
-                throw out_of_range("Value for ElementModQ is greater than allowed");
-            }
-            copy(begin(array), end(array), begin(data));
-        };
+    // Lifecycle Methods
 
-        Impl(const uint64_t (&elem)[MAX_Q_LEN], bool unchecked)
-        {
-            if (!unchecked && Bignum256::lessThan(const_cast<uint64_t *>(Q().get()),
-                                                  const_cast<uint64_t *>(elem)) > 0) {
-                throw out_of_range("Value for ElementModQ is greater than allowed");
-            }
-            copy(begin(elem), end(elem), begin(data));
-        };
+    ElementModQ::ElementModQ() : data() {}
 
-        ~Impl() { hacl::Lib::memZero(static_cast<uint64_t *>(data), MAX_Q_LEN); };
+    ElementModQ::ElementModQ(const ElementModQ &other)
+    {
+        memcpy(static_cast<uint64_t *>(data), static_cast<uint64_t *>(other.data), MAX_Q_SIZE);
+    }
 
-        [[nodiscard]] unique_ptr<ElementModQ::Impl> clone() const
-        {
-            return make_unique<ElementModQ::Impl>(data, true);
-        }
+    ElementModQ::ElementModQ(ElementModQ &&other) : ElementModQ(other) {}
 
-        bool operator==(const Impl &other)
-        {
-            for (uint8_t i = 0; i < MAX_Q_LEN; i++) {
-                auto l = data[i];
-                auto r = other.data[i];
-                if (l != r) {
-                    return false;
-                }
-            }
-            return true;
+    ElementModQ::ElementModQ(const vector<uint64_t> &elem, bool unchecked /* = false */) : data()
+    {
+        if (elem.size() > MAX_Q_LEN) {
+            throw out_of_range("Value for ElementModQ is greater than allowed");
         }
-
-        bool operator<(const Impl &other)
-        {
-            auto other_ = other;
-            return Bignum256::lessThan(static_cast<uint64_t *>(data),
-                                       static_cast<uint64_t *>(other_.data)) > 0;
+        copy(elem.begin(), elem.end(), static_cast<uint64_t *>(data));
+        if (!unchecked && Bignum256::lessThan(const_cast<uint64_t *>(Q().get()),
+                                              static_cast<uint64_t *>(data)) > 0) {
+            hacl::Lib::memZero(static_cast<uint64_t *>(data), MAX_Q_LEN);
+            throw out_of_range("Value for ElementModQ is greater than allowed");
         }
-    };
-
-    // Lifecycle Methods
-
-    ElementModQ::ElementModQ(const ElementModQ &other) : pimpl(other.pimpl->clone()) {}
-
-    ElementModQ::ElementModQ(ElementModQ &&other) = default;
-
-    ElementModQ::ElementModQ(const vector<uint64_t> &elem, bool unchecked /* = false */)
-        : pimpl(new Impl(elem, unchecked))
-    {
     }
 
     ElementModQ::ElementModQ(const uint64_t (&elem)[MAX_Q_LEN], bool unchecked /* = false*/)
-        : pimpl(new Impl(elem, unchecked))
     {
+        if (!unchecked && Bignum256::lessThan(const_cast<uint64_t *>(Q().get()),
+                                              const_cast<uint64_t *>(elem)) > 0) {
+            throw out_of_range("Value for ElementModQ is greater than allowed");
+        }
+        memcpy(static_cast<uint64_t *>(data), static_cast<const uint64_t *>(elem), MAX_Q_SIZE);
     }
-    ElementModQ::~ElementModQ() = default;
+
+    ElementModQ::~ElementModQ() { hacl::Lib::memZero(static_cast<uint64_t *>(data), MAX_Q_LEN); }
 
     // Operator Overloads
 
-    ElementModQ &ElementModQ::operator=(ElementModQ other)
+    ElementModQ &ElementModQ::operator=(const ElementModQ &other)
     {
-        swap(pimpl, other.pimpl);
+        memcpy(static_cast<uint64_t *>(data), static_cast<uint64_t *>(other.data), MAX_Q_SIZE);
         return *this;
     }
 
-    bool ElementModQ::operator==(const ElementModQ &other) { return *pimpl == *other.pimpl; }
-
-    bool ElementModQ::operator==(const ElementModQ &other) const { return *pimpl == *other.pimpl; }
+    ElementModQ &ElementModQ::operator=(ElementModQ &&other)
+    {
+        return *this = static_cast<const ElementModQ &>(other);
+    }
 
-    bool ElementModQ::operator!=(const ElementModQ &other) { return !(*this == other); }
+    bool ElementModQ::operator==(const ElementModQ &other) const
+    {
+        return memcmp(static_cast<uint64_t *>(data), static_cast<uint64_t *>(other.data),
+                      MAX_Q_SIZE) == 0;
+    }
 
     bool ElementModQ::operator!=(const ElementModQ &other) const { return !(*this == other); }
 
-    bool ElementModQ::operator<(const ElementModQ &other) { return *pimpl < *other.pimpl; }
-
-    bool ElementModQ::operator<(const ElementModQ &other) const { return *pimpl < *other.pimpl; }
+    bool ElementModQ::operator<(const ElementModQ &other) const
+    {
+        return Bignum256::lessThan(static_cast<uint64_t *>(data),
+                                   static_cast<uint64_t *>(other.data)) > 0;
+    }
 
     // Property Getters
 
-    uint64_t *ElementModQ::get() const { return static_cast<uint64_t *>(pimpl->data); }
+    uint64_t *ElementModQ::get() const { return static_cast<uint64_t *>(data); }
 
-    uint64_t (&ElementModQ::ref() const)[MAX_Q_LEN] { return pimpl->data; }
+    uint64_t (&ElementModQ::ref() const)[MAX_Q_LEN] { return data; }
 
     uint64_t ElementModQ::length() const { return MAX_Q_LEN; }
 
-    bool ElementModQ::isInBounds() const
-    {
-        return (const_cast<ElementModQ &>(ZERO_MOD_Q()) < *this) &&
-               (const_cast<ElementModQ &>(*this) < Q());
-    }
+    bool ElementModQ::isInBounds() const { return ZERO_MOD_Q() < *this && *this < Q(); }
 
     vector<uint8_t> ElementModQ::toBytes() const
     {
         uint8_t byteResult[MAX_Q_SIZE] = {};
         // Use Hacl to convert the bignum to byte array
-        Bignum256::toBytes(static_cast<uint64_t *>(pimpl->data),
-                           static_cast<uint8_t *>(byteResult));
+        Bignum256::toBytes(static_cast<uint64_t *>(data), static_cast<uint8_t *>(byteResult));
         return vector<uint8_t>(begin(byteResult), end(byteResult));
     }
 
@@ -397,8 +507,7 @@ namespace electionguard
         // Returned bytes array from Hacl needs to be pre-allocated to 32 bytes
         uint8_t byteResult[MAX_Q_SIZE] = {};
         // Use Hacl to convert the bignum to byte array
-        Bignum256::toBytes(static_cast<uint64_t *>(pimpl->data),
-                           static_cast<uint8_t *>(byteResult));
+        Bignum256::toBytes(static_cast<uint64_t *>(data), static_cast<uint8_t *>(byteResult));
         return bytes_to_hex(byteResult);
     }
 
@@ -417,23 +526,192 @@ namespace electionguard
     unique_ptr<ElementModQ> ElementModQ::fromUint64(uint64_t representation,
                                                     bool unchecked /* = false */)
     {
-        const size_t bitWidth = 8U;
-        uint64_t bigEndian = htobe64(representation);
-        return bytes_to_q(reinterpret_cast<uint8_t *>(&bigEndian), bitWidth, unchecked);
+        uint64_t limbs[MAX_Q_LEN] = {representation};
+        return make_unique<ElementModQ>(limbs, unchecked);
     }
 
     // Public Methods
 
     unique_ptr<ElementModP> ElementModQ::toElementModP() const
     {
-        uint64_t p4096[MAX_P_LEN] = {};
-        memcpy(static_cast<uint64_t *>(p4096), static_cast<uint64_t *>(pimpl->data), MAX_Q_SIZE);
-        return make_unique<ElementModP>(p4096, true);
+        auto element = make_unique<ElementModP>();
+        memcpy(element->getMutable(), static_cast<uint64_t *>(data), MAX_Q_SIZE);
+        return element;
+    }
+
+    std::unique_ptr<ElementModQ> ElementModQ::clone() const { return make_unique<ElementModQ>(*this); }
+
+#pragma endregion
+
+#pragma region MontgomeryElementModP
+
+    // the bit width of the windows used by multi_pow_mod_p
+    static constexpr uint32_t MULTI_POW_WINDOW_SIZE = 4;
+    static constexpr uint32_t MULTI_POW_TABLE_SIZE = 1U << MULTI_POW_WINDOW_SIZE;
+
+    // the number of bases that share squarings in multi_pow_mod_p.
+    // larger batches are split to bound the memory used by the tables
+    static constexpr size_t MULTI_POW_BATCH_SIZE = 64;
+
+    static uint32_t getWindow(const uint64_t *exponent, uint32_t offset)
+    {
+        // the window never straddles a limb since the limb width is a multiple of the window
+        return static_cast<uint32_t>(exponent[offset / 64] >> (offset % 64)) &
+               (MULTI_POW_TABLE_SIZE - 1);
+    }
+
+    static uint32_t getBitLength(const uint64_t *exponent)
+    {
+        for (uint32_t i = MAX_Q_LEN; i > 0; i--) {
+            if (exponent[i - 1] != 0) {
+                uint32_t bits = 0;
+                for (auto limb = exponent[i - 1]; limb != 0; limb >>= 1) {
+                    bits++;
+                }
+                return static_cast<uint32_t>((i - 1) * 64) + bits;
+            }
+        }
+        return 0;
+    }
+
+    // Straus' interleaved fixed window exponentiation in montgomery form.
+    // The bases are in montgomery form and the montgomery form of the product is written to resultM
+    static void multi_pow_mod_p_montgomery(const vector<const uint64_t *> &basesM,
+                                           const vector<const uint64_t *> &exponents,
+                                           uint64_t *resultM)
+    {
+        const auto &context = CONTEXT_P();
+        uint32_t bitLength = 0;
+        for (const auto *exponent : exponents) {
+            bitLength = std::max(bitLength, getBitLength(exponent));
+        }
+
+        // tables[i][j] holds bases[i]^j for j in [1, 2^w) in montgomery form
+        vector<uint64_t> tables(basesM.size() * MULTI_POW_TABLE_SIZE * MAX_P_LEN);
+        for (size_t i = 0; i < basesM.size(); i++) {
+            auto *table = &tables[i * MULTI_POW_TABLE_SIZE * MAX_P_LEN];
+            memcpy(&table[MAX_P_LEN], basesM[i], MAX_P_SIZE);
+            for (uint32_t j = 2; j < MULTI_POW_TABLE_SIZE; j++) {
+                context.montgomery_mod_mul_stay_in_mont_form(
+                  &table[(j - 1) * MAX_P_LEN], &table[MAX_P_LEN], &table[j * MAX_P_LEN]);
+            }
+        }
+
+        uint64_t one[MAX_P_LEN] = {1};
+        context.to_montgomery_form(static_cast<uint64_t *>(one), static_cast<uint64_t *>(resultM));
+
+        auto windows = (bitLength + MULTI_POW_WINDOW_SIZE - 1) / MULTI_POW_WINDOW_SIZE;
+        uint64_t temp[MAX_P_LEN] = {};
+        bool isOne = true;
+        for (auto w = windows; w > 0; w--) {
+            auto offset = (w - 1) * MULTI_POW_WINDOW_SIZE;
+            if (!isOne) {
+                for (uint32_t s = 0; s < MULTI_POW_WINDOW_SIZE; s++) {
+                    context.montgomery_mod_mul_stay_in_mont_form(
+                      static_cast<uint64_t *>(resultM), static_cast<uint64_t *>(resultM),
+                      static_cast<uint64_t *>(temp));
+                    memcpy(static_cast<uint64_t *>(resultM), static_cast<uint64_t *>(temp),
+                           MAX_P_SIZE);
+                }
+            }
+            for (size_t i = 0; i < basesM.size(); i++) {
+                auto window = getWindow(exponents[i], offset);
+                if (window == 0) {
+                    continue;
+                }
+                auto *entry = &tables[(i * MULTI_POW_TABLE_SIZE + window) * MAX_P_LEN];
+                context.montgomery_mod_mul_stay_in_mont_form(static_cast<uint64_t *>(resultM),
+                                                             entry, static_cast<uint64_t *>(temp));
+                memcpy(static_cast<uint64_t *>(resultM), static_cast<uint64_t *>(temp),
+                       MAX_P_SIZE);
+                isOne = false;
+            }
+        }
+    }
+
+    MontgomeryElementModP::MontgomeryElementModP()
+    {
+        uint64_t one[MAX_P_LEN] = {1};
+        CONTEXT_P().to_montgomery_form(static_cast<uint64_t *>(one), static_cast<uint64_t *>(data));
+    }
+
+    MontgomeryElementModP::MontgomeryElementModP(const ElementModP &element)
+    {
+        CONTEXT_P().to_montgomery_form(const_cast<uint64_t *>(element.get()),
+                                       static_cast<uint64_t *>(data));
+    }
+
+    MontgomeryElementModP::MontgomeryElementModP(const MontgomeryElementModP &other)
+    {
+        memcpy(static_cast<uint64_t *>(data), static_cast<const uint64_t *>(other.data),
+               MAX_P_SIZE);
+    }
+
+    MontgomeryElementModP::~MontgomeryElementModP()
+    {
+        hacl::Lib::memZero(static_cast<uint64_t *>(data), MAX_P_LEN);
+    }
+
+    // Operator Overloads
+
+    MontgomeryElementModP &MontgomeryElementModP::operator=(const MontgomeryElementModP &other)
+    {
+        memcpy(static_cast<uint64_t *>(data), static_cast<const uint64_t *>(other.data),
+               MAX_P_SIZE);
+        return *this;
+    }
+
+    // the montgomery form of a value in [0, P) is unique so the limbs can be compared directly
+    bool MontgomeryElementModP::operator==(const MontgomeryElementModP &other) const
+    {
+        return memcmp(static_cast<const uint64_t *>(data),
+                      static_cast<const uint64_t *>(other.data), MAX_P_SIZE) == 0;
+    }
+
+    bool MontgomeryElementModP::operator!=(const MontgomeryElementModP &other) const
+    {
+        return !(*this == other);
+    }
+
+    MontgomeryElementModP &MontgomeryElementModP::operator*=(const MontgomeryElementModP &other)
+    {
+        uint64_t product[MAX_P_LEN] = {};
+        CONTEXT_P().montgomery_mod_mul_stay_in_mont_form(
+          static_cast<uint64_t *>(data), other.get(), static_cast<uint64_t *>(product));
+        memcpy(static_cast<uint64_t *>(data), static_cast<uint64_t *>(product), MAX_P_SIZE);
+        return *this;
+    }
+
+    MontgomeryElementModP &MontgomeryElementModP::operator*=(const ElementModP &other)
+    {
+        return *this *= MontgomeryElementModP(other);
+    }
+
+    MontgomeryElementModP MontgomeryElementModP::operator*(const MontgomeryElementModP &other) const
+    {
+        MontgomeryElementModP result(*this);
+        result *= other;
+        return result;
     }
 
-    std::unique_ptr<ElementModQ> ElementModQ::clone() const
+    // Property Getters
+
+    uint64_t *MontgomeryElementModP::get() const { return const_cast<uint64_t *>(data); }
+
+    // Public Members
+
+    MontgomeryElementModP MontgomeryElementModP::pow(const ElementModQ &exponent) const
     {
-        return make_unique<ElementModQ>(pimpl->data);
+        MontgomeryElementModP result;
+        multi_pow_mod_p_montgomery({get()}, {exponent.get()}, result.get());
+        return result;
+    }
+
+    unique_ptr<ElementModP> MontgomeryElementModP::toElementModP() const
+    {
+        uint64_t result[MAX_P_LEN] = {};
+        CONTEXT_P().from_montgomery_form(get(), static_cast<uint64_t *>(result));
+        return make_unique<ElementModP>(result, true);
     }
 
 #pragma endregion
@@ -529,8 +807,8 @@ namespace electionguard
         const auto &p = P();
         uint64_t addResult[MAX_P_LEN_DOUBLE] = {};
         uint64_t carry =
-          Bignum4096::add(const_cast<ElementModP &>(lhs).get(),
-                          const_cast<ElementModP &>(rhs).get(), static_cast<uint64_t *>(addResult));
+          Bignum4096::add(const_cast<uint64_t *>(lhs.get()), const_cast<uint64_t *>(rhs.get()),
+                          static_cast<uint64_t *>(addResult));
 
         // handle the specific case where the the sum == MAX_4096
         // but the carry value is not set.  We still need to offset.
@@ -580,38 +858,41 @@ namespace electionguard
     std::unique_ptr<ElementModP> mod_p(const ElementModP &element)
     {
         uint64_t modResult[MAX_P_LEN] = {};
-        CONTEXT_P().mod(element.get(), static_cast<uint64_t *>(modResult));
+        CONTEXT_P().mod(const_cast<uint64_t *>(element.get()), static_cast<uint64_t *>(modResult));
         return make_unique<ElementModP>(modResult, true);
     }
 
-    unique_ptr<ElementModP> mul_mod_p(const ElementModP &lhs, const ElementModP &rhs)
+    void mul_mod_p_into(ElementModP &out, const ElementModP &lhs, const ElementModP &rhs)
     {
-        const auto &p = P();
         uint64_t mulResult[MAX_P_LEN_DOUBLE] = {};
-        Bignum4096::mul(const_cast<ElementModP &>(lhs).get(), const_cast<ElementModP &>(rhs).get(),
-                        static_cast<uint64_t *>(mulResult));
         uint64_t modResult[MAX_P_LEN] = {};
+        Bignum4096::mul(const_cast<uint64_t *>(lhs.get()), const_cast<uint64_t *>(rhs.get()),
+                        static_cast<uint64_t *>(mulResult));
         CONTEXT_P().mod(static_cast<uint64_t *>(mulResult), static_cast<uint64_t *>(modResult));
-        return make_unique<ElementModP>(modResult, true);
+        // assigning a new element also clears the flags of the output
+        out = ElementModP(modResult, true);
+    }
+
+    unique_ptr<ElementModP> mul_mod_p(const ElementModP &lhs, const ElementModP &rhs)
+    {
+        auto result = make_unique<ElementModP>();
+        mul_mod_p_into(*result, lhs, rhs);
+        return result;
     }
 
     unique_ptr<ElementModP> mul_mod_p(const vector<ElementModPOrQ> &elems)
     {
-        auto product = ElementModP::fromUint64(1UL);
+        MontgomeryElementModP product;
         for (auto x : elems) {
             if (holds_alternative<ElementModQ *>(x)) {
-                auto elem = get<ElementModQ *>(x)->toElementModP();
-                auto res = mul_mod_p(*product, *elem);
-                product.swap(res);
+                product *= *get<ElementModQ *>(x)->toElementModP();
             } else if (holds_alternative<ElementModP *>(x)) {
-                auto *elem = get<ElementModP *>(x);
-                auto res = mul_mod_p(*product, *elem);
-                product.swap(res);
+                product *= *get<ElementModP *>(x);
             } else {
                 throw "invalid type";
             }
         }
-        return make_unique<ElementModP>(*product);
+        return product.toElementModP();
     }
 
     // numerator * (denominator^-1) mod p
@@ -619,7 +900,8 @@ namespace electionguard
     {
         const auto &p = P();
         uint64_t divisor[MAX_P_LEN] = {};
-        Bignum4096::modInvPrime(p.get(), const_cast<ElementModP &>(denominator).get(),
+        Bignum4096::modInvPrime(const_cast<uint64_t *>(p.get()),
+                                const_cast<uint64_t *>(denominator.get()),
                                 static_cast<uint64_t *>(divisor));
         auto inverse = make_unique<ElementModP>(divisor, true);
         return mul_mod_p(numerator, *inverse);
@@ -632,27 +914,114 @@ namespace electionguard
             return ElementModP::fromUint64(1UL);
         }
         uint64_t result[MAX_P_LEN] = {};
-        CONTEXT_P().modExp(base.get(), MAX_P_SIZE, exponent.get(), static_cast<uint64_t *>(result));
+        CONTEXT_P().modExp(const_cast<uint64_t *>(base.get()), MAX_P_SIZE,
+                           const_cast<uint64_t *>(exponent.get()), static_cast<uint64_t *>(result));
         return make_unique<ElementModP>(result, true);
     }
 
-    unique_ptr<ElementModP> pow_mod_p(const ElementModP &base, const ElementModQ &exponent)
+    void pow_mod_p_into(ElementModP &out, const ElementModP &base, const ElementModQ &exponent)
     {
+        uint64_t result[MAX_P_LEN] = {};
         // HACL's input constraints require the exponent to be greater than zero
-        if (const_cast<ElementModQ &>(exponent) == ZERO_MOD_Q()) {
-            return ElementModP::fromUint64(1UL);
+        if (exponent == ZERO_MOD_Q()) {
+            result[0] = 1;
+        } else if (base.isFixedBase()) {
+            // check if we have a lookup table initialized for this element
+            auto power = LookupTableContext::pow_mod_p(base.ref(), exponent.ref());
+            copy(power.begin(), power.end(), static_cast<uint64_t *>(result));
+        } else {
+            // if none exists, execute the modular exponentiation directly
+            uint64_t exponentP[MAX_P_LEN] = {};
+            memcpy(static_cast<uint64_t *>(exponentP), exponent.get(), MAX_Q_SIZE);
+            CONTEXT_P().modExp(const_cast<uint64_t *>(base.get()), MAX_P_SIZE,
+                               static_cast<uint64_t *>(exponentP), static_cast<uint64_t *>(result));
         }
+        // the base may alias the output so it is only written once the power is complete
+        out = ElementModP(result, true);
+    }
+
+    unique_ptr<ElementModP> pow_mod_p(const ElementModP &base, const ElementModQ &exponent)
+    {
+        auto result = make_unique<ElementModP>();
+        pow_mod_p_into(*result, base, exponent);
+        return result;
+    }
+
+    void registerFixedBase(const ElementModP &base)
+    {
+        LookupTableContext::registerFixedBase(base.ref());
+        base.setIsFixedBase(true);
+    }
 
-        // check if we have a lookup table initialized for this element
-        if (base.isFixedBase()) {
-            // TODO: use a smaller key
-            auto hex = base.toHex();
-            auto exp_ptr = exponent.get();
-            auto result = LookupTableContext::pow_mod_p(hex, base.ref(), exponent.ref());
-            return make_unique<ElementModP>(result, true);
+    bool releaseFixedBase(const ElementModP &base)
+    {
+        auto removed = LookupTableContext::releaseFixedBase(base.ref());
+        if (removed) {
+            base.setIsFixedBase(false);
         }
-        // if none exists, execute the modular exponentiation directly
-        return pow_mod_p(base, *exponent.toElementModP());
+        return removed;
+    }
+
+    void saveFixedBase(const ElementModP &base, const string &path)
+    {
+        LookupTableContext::saveFixedBase(base.ref(), path);
+    }
+
+    void loadFixedBase(const ElementModP &base, const string &path)
+    {
+        LookupTableContext::loadFixedBase(base.ref(), path);
+        base.setIsFixedBase(true);
+    }
+
+    unique_ptr<ElementModP> multi_pow_mod_p(const vector<reference_wrapper<const ElementModP>> &bases,
+                                            const vector<reference_wrapper<const ElementModQ>> &exponents)
+    {
+        if (bases.size() != exponents.size()) {
+            throw invalid_argument("multi_pow_mod_p: bases and exponents must have the same size");
+        }
+
+        MontgomeryElementModP product;
+        vector<MontgomeryElementModP> batchBases;
+        vector<const uint64_t *> batchExponents;
+        batchBases.reserve(std::min(bases.size(), MULTI_POW_BATCH_SIZE));
+        batchExponents.reserve(std::min(bases.size(), MULTI_POW_BATCH_SIZE));
+
+        auto flush = [&]() {
+            if (batchBases.empty()) {
+                return;
+            }
+            vector<const uint64_t *> batchBasesM;
+            batchBasesM.reserve(batchBases.size());
+            for (const auto &base : batchBases) {
+                batchBasesM.push_back(base.get());
+            }
+            MontgomeryElementModP result;
+            multi_pow_mod_p_montgomery(batchBasesM, batchExponents, result.get());
+            product *= result;
+            batchBases.clear();
+            batchExponents.clear();
+        };
+
+        for (size_t i = 0; i < bases.size(); i++) {
+            const auto &base = bases[i].get();
+            const auto &exponent = exponents[i].get();
+            if (exponent == ZERO_MOD_Q()) {
+                continue;
+            }
+            // fixed bases are faster with their lookup table
+            if (base.isFixedBase()) {
+                product *= *pow_mod_p(base, exponent);
+                continue;
+            }
+            batchBases.emplace_back(base);
+            batchExponents.push_back(exponent.get());
+            if (batchBases.size() == MULTI_POW_BATCH_SIZE) {
+                flush();
+            }
+        }
+        flush();
+
+        return product.toElementModP();
     }
 
     unique_ptr<ElementModP> g_pow_p(const ElementModP &exponent)
@@ -665,11 +1034,16 @@ namespace electionguard
         return pow_mod_p(G(), exponent);
     }
 
+    void g_pow_p_into(ElementModP &out, const ElementModQ &exponent)
+    {
+        pow_mod_p_into(out, G(), exponent);
+    }
+
 #pragma endregion
 
 #pragma region ElementModQ Global Functions
 
-    unique_ptr<ElementModQ> add_mod_q(const ElementModQ &lhs, const ElementModQ &rhs)
+    void add_mod_q_into(ElementModQ &out, const ElementModQ &lhs, const ElementModQ &rhs)
     {
         const auto &q = Q();
         uint64_t addResult[MAX_Q_LEN_DOUBLE] = {};
@@ -717,9 +1091,14 @@ namespace electionguard
             }
         }
 
-        uint64_t result[MAX_Q_LEN] = {};
-        CONTEXT_Q().mod(static_cast<uint64_t *>(addResult), static_cast<uint64_t *>(result));
-        return make_unique<ElementModQ>(result, true);
+        CONTEXT_Q().mod(static_cast<uint64_t *>(addResult), out.get());
+    }
+
+    unique_ptr<ElementModQ> add_mod_q(const ElementModQ &lhs, const ElementModQ &rhs)
+    {
+        auto result = make_unique<ElementModQ>();
+        add_mod_q_into(*result, lhs, rhs);
+        return result;
     }
 
     unique_ptr<ElementModQ> add_mod_q(const vector<reference_wrapper<ElementModQ>> &elements)
@@ -728,16 +1107,14 @@ namespace electionguard
             throw invalid_argument("must have one or more elements");
         }
 
-        // TODO: const reference
-        auto result = ElementModQ::fromUint64(0UL, true);
+        auto result = make_unique<ElementModQ>();
         for (auto element : elements) {
-            auto sum = add_mod_q(*result, element.get());
-            result.swap(sum);
+            add_mod_q_into(*result, *result, element.get());
         }
         return result;
     }
 
-    unique_ptr<ElementModQ> sub_mod_q(const ElementModQ &a, const ElementModQ &b)
+    void sub_mod_q_into(ElementModQ &out, const ElementModQ &a, const ElementModQ &b)
     {
         const auto &q = Q();
         uint64_t subResult[MAX_Q_LEN_DOUBLE] = {};
@@ -775,32 +1152,38 @@ namespace electionguard
             }
         }
 
-        uint64_t resModQ[MAX_Q_LEN] = {};
-        CONTEXT_Q().mod(static_cast<uint64_t *>(subResult), static_cast<uint64_t *>(resModQ));
+        CONTEXT_Q().mod(static_cast<uint64_t *>(subResult), out.get());
+    }
 
-        return make_unique<ElementModQ>(resModQ, true);
+    unique_ptr<ElementModQ> sub_mod_q(const ElementModQ &a, const ElementModQ &b)
+    {
+        auto result = make_unique<ElementModQ>();
+        sub_mod_q_into(*result, a, b);
+        return result;
     }
 
     // (lhs * rhs) mod q
-    unique_ptr<ElementModQ> mul_mod_q(const ElementModQ &lhs, const ElementModQ &rhs)
+    void mul_mod_q_into(ElementModQ &out, const ElementModQ &lhs, const ElementModQ &rhs)
     {
-        const auto &p = Q();
         uint64_t mulResult[MAX_Q_LEN_DOUBLE] = {};
-        Bignum256::mul(const_cast<ElementModQ &>(lhs).get(), const_cast<ElementModQ &>(rhs).get(),
-                       static_cast<uint64_t *>(mulResult));
-        uint64_t modResult[MAX_Q_LEN] = {};
-        CONTEXT_Q().mod(static_cast<uint64_t *>(mulResult), static_cast<uint64_t *>(modResult));
-        return make_unique<ElementModQ>(modResult, true);
+        Bignum256::mul(lhs.get(), rhs.get(), static_cast<uint64_t *>(mulResult));
+        CONTEXT_Q().mod(static_cast<uint64_t *>(mulResult), out.get());
+    }
+
+    unique_ptr<ElementModQ> mul_mod_q(const ElementModQ &lhs, const ElementModQ &rhs)
+    {
+        auto result = make_unique<ElementModQ>();
+        mul_mod_q_into(*result, lhs, rhs);
+        return result;
     }
 
     unique_ptr<ElementModQ> mul_mod_q(const vector<ElementModQ> &elems)
     {
         auto product = ElementModQ::fromUint64(1UL, true);
         for (const auto &elem : elems) {
-            auto res = mul_mod_q(*product, elem);
-            product.swap(res);
+            mul_mod_q_into(*product, *product, elem);
         }
-        return make_unique<ElementModQ>(*product);
+        return product;
     }
 
     // numerator * (denominator^-1) mod q
@@ -838,8 +1221,8 @@ namespace electionguard
         return make_unique<ElementModQ>(result, true);
     }
 
-    unique_ptr<ElementModQ> a_plus_bc_mod_q(const ElementModQ &a, const ElementModQ &b,
-                                            const ElementModQ &c)
+    void a_plus_bc_mod_q_into(ElementModQ &out, const ElementModQ &a, const ElementModQ &b,
+                              const ElementModQ &c)
     {
         // multiply b * c and the result will be twice Q in size
         uint64_t bc[MAX_Q_LEN_DOUBLE] = {};
@@ -863,8 +1246,15 @@ namespace electionguard
         if (!modSuccess) {
             throw runtime_error("a_plus_bc_mod_q mod operation failed");
         }
+        memcpy(out.get(), static_cast<uint64_t *>(res), MAX_Q_SIZE);
+    }
 
-        return make_unique<ElementModQ>(res, true);
+    unique_ptr<ElementModQ> a_plus_bc_mod_q(const ElementModQ &a, const ElementModQ &b,
+                                            const ElementModQ &c)
+    {
+        auto result = make_unique<ElementModQ>();
+        a_plus_bc_mod_q_into(*result, a, b, c);
+        return result;
     }
 
     unique_ptr<ElementModP> rand_p()
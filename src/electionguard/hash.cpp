@@ -1,259 +1,272 @@
 #include "electionguard/hash.hpp"
 
-#include "../../libs/hacl/Hacl_Bignum256.hpp"
 #include "../../libs/hacl/Hacl_Streaming_SHA2.hpp"
 #include "log.hpp"
 
+#include <algorithm>
 #include <cstring>
-#include <iomanip>
-#include <iostream>
 
-using hacl::Bignum256;
 using hacl::StreamingSHA2;
 using hacl::StreamingSHA2Mode;
-using std::get;
 using std::make_unique;
-using std::move;
 using std::nullptr_t;
-using std::out_of_range;
 using std::reference_wrapper;
 using std::string;
-using std::to_string;
 using std::unique_ptr;
 using std::vector;
 
 namespace electionguard
 {
-    string get_hash_string(CryptoHashableType a);
-    template <typename T> string hash_inner_vector(vector<T> inner_vector);
-    void push_hash_update(StreamingSHA2 *p, CryptoHashableType a);
-    unique_ptr<StreamingSHA2> hash_open();
-    unique_ptr<ElementModQ> hash_close(StreamingSHA2 *p);
-
-    enum CryptoHashableTypeEnum {
-        NULL_PTR = 0,
-        CRYPTOHASHABLE_PTR = 1,
-        ELEMENTMODP_PTR = 2,
-        ELEMENTMODQ_PTR = 3,
-        CRYPTOHASHABLE_REF = 4,
-        ELEMENTMODP_REF = 5,
-        ELEMENTMODQ_REF = 6,
-        CRYPTOHASHABLE_CONST_REF = 7,
-        ELEMENTMODP_CONST_REF = 8,
-        ELEMENTMODQ_CONST_REF = 9,
-        UINT64_T = 10,
-        STRING = 11,
-        VECTOR_CRYPTOHASHABLE_PTR = 12,
-        VECTOR_ELEMENTMODP_PTR = 13,
-        VECTOR_ELEMENTMODQ_PTR = 14,
-        VECTOR_CRYPTOHASHABLE_REF = 15,
-        VECTOR_ELEMENTMODP_REF = 16,
-        VECTOR_ELEMENTMODQ_REF = 17,
-        VECTOR_CRYPTOHASHABLE_CONST_REF = 18,
-        VECTOR_ELEMENTMODP_CONST_REF = 19,
-        VECTOR_ELEMENTMODQ_CONST_REF = 20,
-        VECTOR_UINT64_T = 21,
-        VECTOR_STRING = 22,
-        VECTOR_UINT8_T = 23
-    };
-
     const char delimiter_char = '|';
-    const string null_string = "null";
+    const char null_string[] = "null";
 
     uint8_t delimiter[1] = {delimiter_char};
 
-    unique_ptr<ElementModQ> hash_elems(const vector<CryptoHashableType> &a)
+#pragma region Hex Encoding
+
+    /// <summary>
+    /// Two uppercase hex digits for every byte value, built at compile time
+    /// so encoding is a single lookup per byte
+    /// </summary>
+    struct HexTable {
+        char digits[512] = {};
+        constexpr HexTable()
+        {
+            constexpr char alphabet[] = "0123456789ABCDEF";
+            for (uint32_t i = 0; i < 256; i++) {
+                digits[i * 2] = alphabet[i >> 4];
+                digits[i * 2 + 1] = alphabet[i & 0x0F];
+            }
+        }
+    };
+
+    static constexpr HexTable HEX_TABLE{};
+
+    // bytes encoded per update, sized so the buffer stays on the stack
+    static constexpr size_t HEX_CHUNK_BYTES = 512;
+
+    static void update_raw(const StreamingSHA2 &sha, const void *data, size_t size)
     {
-        uint8_t output[MAX_Q_SIZE] = {};
-        unique_ptr<StreamingSHA2> p = hash_open();
+        sha.update(static_cast<uint8_t *>(const_cast<void *>(data)), static_cast<uint32_t>(size));
+    }
 
-        if (a.empty()) {
-            push_hash_update(p.get(), nullptr);
-        } else {
-            for (const CryptoHashableType &item : a) {
-                push_hash_update(p.get(), item);
+    /// <summary>
+    /// Write the uppercase hex of a big endian byte array into the hash,
+    /// matching bytes_to_hex: leading zero bytes are skipped and an all zero
+    /// array is written as "00"
+    /// </summary>
+    static void update_hex(const StreamingSHA2 &sha, const uint8_t *bytes, size_t size)
+    {
+        size_t start = 0;
+        while (start < size && bytes[start] == 0) {
+            start++;
+        }
+        if (start == size) {
+            update_raw(sha, "00", 2);
+            return;
+        }
+
+        char buffer[HEX_CHUNK_BYTES * 2];
+        while (start < size) {
+            size_t count = std::min(HEX_CHUNK_BYTES, size - start);
+            for (size_t i = 0; i < count; i++) {
+                memcpy(&buffer[i * 2], &HEX_TABLE.digits[bytes[start + i] * 2], 2);
             }
+            update_raw(sha, buffer, count * 2);
+            start += count;
         }
-        return hash_close(p.get());
     }
 
-    unique_ptr<ElementModQ> hash_elems(CryptoHashableType a)
+    /// <summary>
+    /// Write the uppercase hex of a little endian limb array into the hash.
+    /// Produces the same text as toHex without serializing the element first.
+    /// </summary>
+    static void update_hex(const StreamingSHA2 &sha, const uint64_t *limbs, uint32_t len)
     {
-        unique_ptr<StreamingSHA2> p = hash_open();
-        push_hash_update(p.get(), a);
-        return hash_close(p.get());
+        uint8_t bytes[MAX_P_SIZE];
+        for (uint32_t i = 0; i < len; i++) {
+            uint64_t limb = limbs[len - 1 - i];
+            for (uint32_t j = 0; j < sizeof(uint64_t); j++) {
+                bytes[i * sizeof(uint64_t) + j] = static_cast<uint8_t>(limb >> (56 - j * 8));
+            }
+        }
+        update_hex(sha, static_cast<uint8_t *>(bytes), len * sizeof(uint64_t));
     }
 
-    unique_ptr<StreamingSHA2> hash_open()
+#pragma endregion
+
+#pragma region Hashable Values
+
+    static void hash_value(const StreamingSHA2 &sha, nullptr_t value);
+    static void hash_value(const StreamingSHA2 &sha, CryptoHashable *value);
+    static void hash_value(const StreamingSHA2 &sha, const ElementModP *value);
+    static void hash_value(const StreamingSHA2 &sha, const ElementModQ *value);
+    static void hash_value(const StreamingSHA2 &sha, reference_wrapper<CryptoHashable> value);
+    static void hash_value(const StreamingSHA2 &sha, reference_wrapper<const CryptoHashable> value);
+    static void hash_value(const StreamingSHA2 &sha, const ElementModP &value);
+    static void hash_value(const StreamingSHA2 &sha, const ElementModQ &value);
+    static void hash_value(const StreamingSHA2 &sha, uint64_t value);
+    static void hash_value(const StreamingSHA2 &sha, const string &value);
+    static void hash_value(const StreamingSHA2 &sha, const vector<uint8_t> &value);
+    template <typename T> static void hash_value(const StreamingSHA2 &sha, const vector<T> &value);
+
+    static void hash_start(const StreamingSHA2 &sha) { update_raw(sha, delimiter, sizeof(delimiter)); }
+
+    /// <summary>
+    /// Write a value followed by the delimiter
+    /// </summary>
+    template <typename T> static void hash_update(const StreamingSHA2 &sha, const T &value)
     {
-        auto p = make_unique<StreamingSHA2>(StreamingSHA2Mode::SHA2_256);
-        p->update(static_cast<uint8_t *>(delimiter), sizeof(delimiter));
-        return move(p);
+        hash_value(sha, value);
+        update_raw(sha, delimiter, sizeof(delimiter));
     }
 
-    unique_ptr<ElementModQ> hash_close(StreamingSHA2 *p)
+    /// <summary>
+    /// Finish the hash and reduce the digest into the output element
+    /// </summary>
+    static void hash_finish(const StreamingSHA2 &sha, ElementModQ &out)
     {
         uint8_t output[MAX_Q_SIZE] = {};
-        p->finish(static_cast<uint8_t *>(output));
+        sha.finish(static_cast<uint8_t *>(output));
 
-        auto *bigNum = Bignum256::fromBytes(sizeof(output), static_cast<uint8_t *>(output));
-        if (bigNum == nullptr) {
-            throw out_of_range("bytes_to_p could not allocate");
+        // the digest is big endian, the element limbs are little endian
+        uint64_t limbs[MAX_Q_LEN] = {};
+        for (uint32_t i = 0; i < MAX_Q_LEN; i++) {
+            uint64_t limb = 0;
+            for (uint32_t j = 0; j < sizeof(uint64_t); j++) {
+                limb = (limb << 8) | output[i * sizeof(uint64_t) + j];
+            }
+            limbs[MAX_Q_LEN - 1 - i] = limb;
         }
 
-        // The ElementModQ constructor expects the bignum
-        // to be a certain size, but there's no guarantee
-        // that constraint is satisfied by new_bn_from_bytes_be
-        // so copy it into a new element that is the correct size
-        // and free the allocated resources
-        uint64_t normalized[MAX_Q_LEN] = {};
-        memcpy(static_cast<uint64_t *>(normalized), bigNum, sizeof(output));
-        free(bigNum);
-
-        auto element = make_unique<ElementModQ>(normalized, true);
-
         // TODO: take the result mod Q - 1
         // to produce a result that is [0,q-1]
-        return add_mod_q(*element, ZERO_MOD_Q());
+        add_mod_q_into(out, ElementModQ(limbs, true), ZERO_MOD_Q());
+    }
+
+    static void hash_value(const StreamingSHA2 &sha, nullptr_t /* value */)
+    {
+        update_raw(sha, null_string, strlen(null_string));
+    }
+
+    static void hash_value(const StreamingSHA2 &sha, CryptoHashable *value)
+    {
+        hash_value(sha, *value->crypto_hash());
+    }
+
+    static void hash_value(const StreamingSHA2 &sha, const ElementModP *value)
+    {
+        hash_value(sha, *value);
+    }
+
+    static void hash_value(const StreamingSHA2 &sha, const ElementModQ *value)
+    {
+        hash_value(sha, *value);
+    }
+
+    static void hash_value(const StreamingSHA2 &sha, reference_wrapper<CryptoHashable> value)
+    {
+        hash_value(sha, *value.get().crypto_hash());
+    }
+
+    static void hash_value(const StreamingSHA2 &sha, reference_wrapper<const CryptoHashable> value)
+    {
+        hash_value(sha, *value.get().crypto_hash());
+    }
+
+    static void hash_value(const StreamingSHA2 &sha, const ElementModP &value)
+    {
+        update_hex(sha, value.get(), MAX_P_LEN);
+    }
+
+    static void hash_value(const StreamingSHA2 &sha, const ElementModQ &value)
+    {
+        update_hex(sha, value.get(), MAX_Q_LEN);
     }
 
-    template <typename T> string hash_inner_vector(vector<T> inner_vector)
+    static void hash_value(const StreamingSHA2 &sha, uint64_t value)
     {
-        if (inner_vector.empty()) {
-            return null_string;
+        if (value == 0) {
+            hash_value(sha, nullptr);
+            return;
+        }
+
+        char digits[20];
+        size_t start = sizeof(digits);
+        while (value != 0) {
+            digits[--start] = static_cast<char>('0' + value % 10);
+            value /= 10;
         }
-        vector<CryptoHashableType> hashable_vector(inner_vector.begin(), inner_vector.end());
-        return hash_elems(hashable_vector)->toHex();
+        update_raw(sha, &digits[start], sizeof(digits) - start);
     }
 
-    string get_hash_string(CryptoHashableType a)
+    static void hash_value(const StreamingSHA2 &sha, const string &value)
     {
-        switch (a.index()) {
-            case NULL_PTR: // nullptr_t
-            {
-                return null_string;
-            }
-            case CRYPTOHASHABLE_PTR: // CryptoHashable *
-            {
-                auto hashable = get<CryptoHashable *>(a)->crypto_hash();
-                return hashable->toHex();
-            }
-            case ELEMENTMODP_PTR: // ElementModP *
-            {
-                return get<ElementModP *>(a)->toHex();
-            }
-            case ELEMENTMODQ_PTR: // ElementModQ *
-            {
-                return get<ElementModQ *>(a)->toHex();
-            }
-            case CRYPTOHASHABLE_REF: // reference_wrapper<CryptoHashable>
-            {
-                auto hashable = get<reference_wrapper<CryptoHashable>>(a).get().crypto_hash();
-                return hashable->toHex();
-                //Log::debug("input string: " + input_string);
-            }
-            case ELEMENTMODP_REF: // reference_wrapper<ElementModP>
-            {
-                return get<reference_wrapper<ElementModP>>(a).get().toHex();
-            }
-            case ELEMENTMODQ_REF: // reference_wrapper<ElementModQ>
-            {
-                return get<reference_wrapper<ElementModQ>>(a).get().toHex();
-            }
-            case CRYPTOHASHABLE_CONST_REF: // reference_wrapper<const CryptoHashable>
-            {
-                auto hashable = get<reference_wrapper<const CryptoHashable>>(a).get().crypto_hash();
-                return hashable->toHex();
-            }
-            case ELEMENTMODP_CONST_REF: // reference_wrapper<const ElementModP>
-            {
-                return get<reference_wrapper<const ElementModP>>(a).get().toHex();
-            }
-            case ELEMENTMODQ_CONST_REF: // reference_wrapper<const ElementModQ>
-            {
-                return get<reference_wrapper<const ElementModQ>>(a).get().toHex();
-            }
-            case UINT64_T: // uint64_t
-            {
-                uint64_t i = get<uint64_t>(a);
-                if (i != 0) {
-                    return to_string(i);
-                }
-                return null_string;
-            }
-            case STRING: // string
-            {
-                auto hashable = get<string>(a);
-                if (hashable.empty()) {
-                    return null_string;
-                }
-                return hashable;
-            }
-            case VECTOR_CRYPTOHASHABLE_PTR: // vector<CryptoHashable *>
-            {
-                return hash_inner_vector<CryptoHashable *>(get<vector<CryptoHashable *>>(a));
-            }
-            case VECTOR_ELEMENTMODP_PTR: // vector<ElementModP *>
-            {
-                return hash_inner_vector<ElementModP *>(get<vector<ElementModP *>>(a));
-            }
-            case VECTOR_ELEMENTMODQ_PTR: // vector<ElementModQ *>
-            {
-                return hash_inner_vector<ElementModQ *>(get<vector<ElementModQ *>>(a));
-            }
-            case VECTOR_CRYPTOHASHABLE_REF: // vector<reference_wrapper<CryptoHashable>>
-            {
-                return hash_inner_vector<reference_wrapper<CryptoHashable>>(
-                  get<vector<reference_wrapper<CryptoHashable>>>(a));
-            }
-            case VECTOR_ELEMENTMODP_REF: // vector<reference_wrapper<ElementModP>>
-            {
-                return hash_inner_vector<reference_wrapper<ElementModP>>(
-                  get<vector<reference_wrapper<ElementModP>>>(a));
-            }
-            case VECTOR_ELEMENTMODQ_REF: // vector<reference_wrapper<ElementModQ>>
-            {
-                return hash_inner_vector<reference_wrapper<ElementModQ>>(
-                  get<vector<reference_wrapper<ElementModQ>>>(a));
-            }
-            case VECTOR_CRYPTOHASHABLE_CONST_REF: // vector<reference_wrapper<const CryptoHashable>>
-            {
-                return hash_inner_vector<reference_wrapper<const CryptoHashable>>(
-                  get<vector<reference_wrapper<const CryptoHashable>>>(a));
-            }
-            case VECTOR_ELEMENTMODP_CONST_REF: // vector<reference_wrapper<const ElementModP>>
-            {
-                return hash_inner_vector<reference_wrapper<const ElementModP>>(
-                  get<vector<reference_wrapper<const ElementModP>>>(a));
-            }
-            case VECTOR_ELEMENTMODQ_CONST_REF: // vector<reference_wrapper<const ElementModQ>>
-            {
-                return hash_inner_vector<reference_wrapper<const ElementModQ>>(
-                  get<vector<reference_wrapper<const ElementModQ>>>(a));
-            }
-            case VECTOR_UINT64_T: // vector<uint64_t>
-            {
-                return hash_inner_vector<uint64_t>(get<vector<uint64_t>>(a));
-            }
-            case VECTOR_STRING: // vector<string>
-            {
-                return hash_inner_vector<string>(get<vector<string>>(a));
-            }
-            case VECTOR_UINT8_T: // vector<string>
-            {
-                vector<uint8_t> temp = get<vector<uint8_t>>(a);
-                return vector_uint8_t_to_hex(temp);
+        if (value.empty()) {
+            hash_value(sha, nullptr);
+            return;
+        }
+        update_raw(sha, value.data(), value.size());
+    }
+
+    static void hash_value(const StreamingSHA2 &sha, const vector<uint8_t> &value)
+    {
+        update_hex(sha, value.data(), value.size());
+    }
+
+    /// <summary>
+    /// A nested vector is hashed on its own and contributes the hex of its digest
+    /// </summary>
+    template <typename T> static void hash_value(const StreamingSHA2 &sha, const vector<T> &value)
+    {
+        if (value.empty()) {
+            hash_value(sha, nullptr);
+            return;
+        }
+
+        StreamingSHA2 inner(StreamingSHA2Mode::SHA2_256);
+        hash_start(inner);
+        for (const auto &item : value) {
+            hash_update(inner, item);
+        }
+        ElementModQ digest;
+        hash_finish(inner, digest);
+        hash_value(sha, digest);
+    }
+
+    static void push_hash_update(const StreamingSHA2 &sha, const CryptoHashableType &a)
+    {
+        std::visit([&sha](const auto &value) { hash_update(sha, value); }, a);
+    }
+
+#pragma endregion
+
+    unique_ptr<ElementModQ> hash_elems(const vector<CryptoHashableType> &a)
+    {
+        StreamingSHA2 sha(StreamingSHA2Mode::SHA2_256);
+        hash_start(sha);
+
+        if (a.empty()) {
+            hash_update(sha, nullptr);
+        } else {
+            for (const CryptoHashableType &item : a) {
+                push_hash_update(sha, item);
             }
         }
 
-        return null_string;
+        auto result = make_unique<ElementModQ>();
+        hash_finish(sha, *result);
+        return result;
     }
 
-    void push_hash_update(StreamingSHA2 *p, CryptoHashableType a)
+    unique_ptr<ElementModQ> hash_elems(CryptoHashableType a)
     {
-        string input_string = get_hash_string(a);
-        const auto *input = reinterpret_cast<const uint8_t *>(input_string.c_str());
-        p->update(const_cast<uint8_t *>(input), input_string.size());
-        p->update(static_cast<uint8_t *>(delimiter), sizeof(delimiter));
+        StreamingSHA2 sha(StreamingSHA2Mode::SHA2_256);
+        hash_start(sha);
+        push_hash_update(sha, a);
+
+        auto result = make_unique<ElementModQ>();
+        hash_finish(sha, *result);
+        return result;
     }
 } // namespace electionguard
@@ -0,0 +1,381 @@
+#include "lookup_table.hpp"
+
+#include "electionguard/group.hpp"
+#include "log.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <future>
+#include <mutex>
+#include <stdexcept>
+
+#ifdef _WIN32
+#    ifndef NOMINMAX
+#        define NOMINMAX
+#    endif
+#    include <windows.h>
+#else
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+using std::make_shared;
+using std::promise;
+using std::runtime_error;
+using std::shared_lock;
+using std::shared_mutex;
+using std::shared_ptr;
+using std::string;
+using std::unique_lock;
+using std::vector;
+
+namespace electionguard
+{
+    namespace
+    {
+        const char LOOKUP_TABLE_FILE_MAGIC[8] = {'E', 'G', 'F', 'I', 'X', 'T', 'B', 'L'};
+        const uint32_t LOOKUP_TABLE_FILE_VERSION = 1;
+
+        // the table starts on its own page so it is page aligned when mapped
+        const uint64_t LOOKUP_TABLE_FILE_HEADER_SIZE = 4096;
+
+        struct LookupTableFileHeader {
+            char magic[8];
+            uint32_t version;
+            uint32_t headerSize;
+            uint64_t windowSize;
+            uint64_t orderBits;
+            uint64_t tableLimbs;
+            uint64_t primeDigest;
+            uint64_t baseDigest;
+            uint64_t base[MAX_P_LEN];
+        };
+
+        static_assert(sizeof(LookupTableFileHeader) <= LOOKUP_TABLE_FILE_HEADER_SIZE,
+                      "the header must fit in the header page");
+
+        LookupTableFileHeader makeHeader(const uint64_t (&base)[MAX_P_LEN])
+        {
+            LookupTableFileHeader header = {};
+            memcpy(header.magic, LOOKUP_TABLE_FILE_MAGIC, sizeof(header.magic));
+            header.version = LOOKUP_TABLE_FILE_VERSION;
+            header.headerSize = static_cast<uint32_t>(LOOKUP_TABLE_FILE_HEADER_SIZE);
+            header.windowSize = LUT_WINDOW_SIZE;
+            header.orderBits = LUT_ORDER_BITS;
+            header.tableLimbs = LookupTableType::TableLimbs;
+            header.primeDigest = LookupTableContext::digest(P().ref());
+            header.baseDigest = LookupTableContext::digest(base);
+            memcpy(header.base, base, sizeof(header.base));
+            return header;
+        }
+
+        /// a read only mapping of a lookup table file
+        class MappedLookupTableFile
+        {
+          public:
+            explicit MappedLookupTableFile(const string &path)
+            {
+#ifdef _WIN32
+                file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                   OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+                if (file == INVALID_HANDLE_VALUE) {
+                    throw runtime_error("LookupTableContext:: could not open " + path);
+                }
+                LARGE_INTEGER fileSize;
+                if (!GetFileSizeEx(file, &fileSize)) {
+                    CloseHandle(file);
+                    throw runtime_error("LookupTableContext:: could not read the size of " + path);
+                }
+                size = static_cast<uint64_t>(fileSize.QuadPart);
+                mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                if (mapping == nullptr) {
+                    CloseHandle(file);
+                    throw runtime_error("LookupTableContext:: could not map " + path);
+                }
+                data = static_cast<const uint8_t *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+                if (data == nullptr) {
+                    CloseHandle(mapping);
+                    CloseHandle(file);
+                    throw runtime_error("LookupTableContext:: could not map " + path);
+                }
+#else
+                descriptor = ::open(path.c_str(), O_RDONLY);
+                if (descriptor < 0) {
+                    throw runtime_error("LookupTableContext:: could not open " + path);
+                }
+                struct stat status;
+                if (fstat(descriptor, &status) != 0) {
+                    ::close(descriptor);
+                    throw runtime_error("LookupTableContext:: could not read the size of " + path);
+                }
+                size = static_cast<uint64_t>(status.st_size);
+                if (size == 0) {
+                    ::close(descriptor);
+                    throw runtime_error("LookupTableContext:: " + path + " is empty");
+                }
+                auto *mapped = mmap(nullptr, size, PROT_READ, MAP_SHARED, descriptor, 0);
+                if (mapped == MAP_FAILED) {
+                    ::close(descriptor);
+                    throw runtime_error("LookupTableContext:: could not map " + path);
+                }
+                data = static_cast<const uint8_t *>(mapped);
+#endif
+            }
+
+            ~MappedLookupTableFile()
+            {
+#ifdef _WIN32
+                UnmapViewOfFile(data);
+                CloseHandle(mapping);
+                CloseHandle(file);
+#else
+                munmap(const_cast<uint8_t *>(data), size);
+                ::close(descriptor);
+#endif
+            }
+
+            MappedLookupTableFile(const MappedLookupTableFile &) = delete;
+            MappedLookupTableFile &operator=(const MappedLookupTableFile &) = delete;
+
+            const uint8_t *data = nullptr;
+            uint64_t size = 0;
+
+          private:
+#ifdef _WIN32
+            HANDLE file = INVALID_HANDLE_VALUE;
+            HANDLE mapping = nullptr;
+#else
+            int descriptor = -1;
+#endif
+        };
+    } // namespace
+
+    LookupTableContext &LookupTableContext::getInstance()
+    {
+        static LookupTableContext instance;
+        return instance;
+    }
+
+    uint64_t LookupTableContext::digest(const uint64_t (&base)[MAX_P_LEN])
+    {
+        // collisions are resolved by comparing the stored base
+        return digestLimbs(base);
+    }
+
+    uint64_t LookupTableContext::registerFixedBase(const uint64_t (&base)[MAX_P_LEN])
+    {
+        auto key = digest(base);
+        auto table = getInstance().findOrCreate(key, base, true);
+        if (!table.valid()) {
+            throw std::runtime_error("registerFixedBase: digest collision with another base");
+        }
+        table.wait();
+        return key;
+    }
+
+    bool LookupTableContext::releaseFixedBase(const uint64_t (&base)[MAX_P_LEN])
+    {
+        auto key = digest(base);
+        auto &instance = getInstance();
+        unique_lock<shared_mutex> lock(instance._mutex);
+        auto iter = instance._tables.find(key);
+        if (iter == instance._tables.end() ||
+            !std::equal(begin(base), end(base), iter->second.base.begin())) {
+            return false;
+        }
+
+        // tables generated lazily are shared by every user of the base and are never removed
+        auto &entry = iter->second;
+        if (entry.registrations == 0) {
+            return false;
+        }
+        if (--entry.registrations > 0) {
+            return false;
+        }
+
+        // tables still in use by an exponentiation are kept alive by their shared_ptr
+        instance._tables.erase(iter);
+        return true;
+    }
+
+    shared_ptr<const LookupTableType>
+    LookupTableContext::getFixedBase(const uint64_t (&base)[MAX_P_LEN])
+    {
+        auto table = getInstance().find(digest(base), base);
+        return table.valid() ? table.get() : nullptr;
+    }
+
+    void LookupTableContext::saveFixedBase(const uint64_t (&base)[MAX_P_LEN], const string &path)
+    {
+        auto pending = getInstance().findOrCreate(digest(base), base, false);
+        if (!pending.valid()) {
+            throw runtime_error("LookupTableContext:: digest collision with another base");
+        }
+        auto table = pending.get();
+
+        auto header = makeHeader(base);
+        vector<uint8_t> headerPage(LOOKUP_TABLE_FILE_HEADER_SIZE, 0);
+        memcpy(headerPage.data(), &header, sizeof(header));
+
+        // write next to the destination and rename so a table that is
+        // possibly still mapped by another process is replaced atomically
+        auto temporaryPath = path + ".tmp";
+        {
+            std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+            if (!file) {
+                throw runtime_error("LookupTableContext:: could not create " + temporaryPath);
+            }
+            file.write(reinterpret_cast<const char *>(headerPage.data()),
+                       static_cast<std::streamsize>(headerPage.size()));
+            file.write(reinterpret_cast<const char *>(table->data()),
+                       static_cast<std::streamsize>(LookupTableType::TableSize));
+            file.flush();
+            if (!file) {
+                throw runtime_error("LookupTableContext:: could not write " + temporaryPath);
+            }
+        }
+#ifdef _WIN32
+        auto renamed = MoveFileExA(temporaryPath.c_str(), path.c_str(),
+                                   MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+        auto renamed = std::rename(temporaryPath.c_str(), path.c_str()) == 0;
+#endif
+        if (!renamed) {
+            std::remove(temporaryPath.c_str());
+            throw runtime_error("LookupTableContext:: could not replace " + path);
+        }
+    }
+
+    uint64_t LookupTableContext::loadFixedBase(const uint64_t (&base)[MAX_P_LEN],
+                                               const string &path)
+    {
+        auto mapped = make_shared<const MappedLookupTableFile>(path);
+        if (mapped->size != LOOKUP_TABLE_FILE_HEADER_SIZE + LookupTableType::TableSize) {
+            throw runtime_error("LookupTableContext:: " + path +
+                                " does not match the size of the lookup table");
+        }
+
+        // every field of the header must match, including the base and the prime
+        // the table was generated for, before the values are trusted
+        auto expected = makeHeader(base);
+        LookupTableFileHeader header = {};
+        memcpy(&header, mapped->data, sizeof(header));
+        if (memcmp(&header, &expected, sizeof(header)) != 0) {
+            throw runtime_error("LookupTableContext:: " + path +
+                                " was not generated for this base and window size");
+        }
+
+        auto *values = reinterpret_cast<const uint64_t *>(mapped->data + LOOKUP_TABLE_FILE_HEADER_SIZE);
+        auto table = make_shared<const LookupTableType>(values, mapped);
+
+        auto key = header.baseDigest;
+        if (!getInstance().findOrCreate(key, base, true, table).valid()) {
+            throw runtime_error("LookupTableContext:: digest collision with another base");
+        }
+        Log::debug("LookupTableContext:: loaded a fixed base lookup table from " + path);
+        return key;
+    }
+
+    vector<uint64_t> LookupTableContext::pow_mod_p(const uint64_t (&base)[MAX_P_LEN],
+                                                   const uint64_t (&exponent)[MAX_Q_LEN])
+    {
+        auto table = getInstance().findOrCreate(digest(base), base, false);
+
+        // fall back to modExp when the digest collides with another registered base,
+        // or when a scheduler worker would otherwise block on a table another thread
+        // is still generating, since the rows of that table may be queued behind it
+        if (!table.valid() ||
+            (Scheduler::isWorkerThread() &&
+             table.wait_for(std::chrono::seconds(0)) != std::future_status::ready)) {
+            uint64_t result[MAX_P_LEN] = {};
+            CONTEXT_P().modExp(const_cast<uint64_t *>(static_cast<const uint64_t *>(base)),
+                               MAX_Q_SIZE * 8,
+                               const_cast<uint64_t *>(static_cast<const uint64_t *>(exponent)),
+                               static_cast<uint64_t *>(result));
+            return vector<uint64_t>(begin(result), end(result));
+        }
+        return table.get()->pow_mod_p(exponent);
+    }
+
+    // Private Methods
+
+    LookupTableContext::PendingTable
+    LookupTableContext::find(uint64_t digest, const uint64_t (&base)[MAX_P_LEN])
+    {
+        shared_lock<shared_mutex> lock(_mutex);
+        auto iter = _tables.find(digest);
+        if (iter == _tables.end() ||
+            !std::equal(begin(base), end(base), iter->second.base.begin())) {
+            return {};
+        }
+        return iter->second.table;
+    }
+
+    LookupTableContext::PendingTable
+    LookupTableContext::findOrCreate(uint64_t digest, const uint64_t (&base)[MAX_P_LEN],
+                                     bool shouldRegister, shared_ptr<const LookupTableType> table)
+    {
+        if (table == nullptr && !shouldRegister) {
+            auto found = find(digest, base);
+            if (found.valid()) {
+                return found;
+            }
+        }
+
+        // the first thread to miss adds a pending entry so the others wait
+        // for its table instead of generating their own
+        promise<shared_ptr<const LookupTableType>> generated;
+        PendingTable pending;
+        {
+            unique_lock<shared_mutex> lock(_mutex);
+            auto iter = _tables.find(digest);
+            if (iter != _tables.end()) {
+                auto &entry = iter->second;
+                if (!std::equal(begin(base), end(base), entry.base.begin())) {
+                    return {};
+                }
+                if (shouldRegister) {
+                    entry.registrations++;
+                }
+                return entry.table;
+            }
+
+            if (table != nullptr) {
+                generated.set_value(table);
+            }
+            pending = generated.get_future().share();
+            Entry entry{{}, pending, shouldRegister ? 1UL : 0UL};
+            std::copy(begin(base), end(base), entry.base.begin());
+            _tables.emplace(digest, std::move(entry));
+            if (table != nullptr) {
+                return pending;
+            }
+        }
+
+        // generate the table without holding the lock so exponentiations
+        // with other bases are not blocked while it is computed
+        try {
+            Log::debug("LookupTableContext: generating a fixed base lookup table");
+            generated.set_value(
+              make_shared<const LookupTableType>(static_cast<const uint64_t *>(base)));
+        } catch (...) {
+            // drop the entry so the next miss tries again, and wake the waiting threads
+            {
+                unique_lock<shared_mutex> lock(_mutex);
+                auto iter = _tables.find(digest);
+                if (iter != _tables.end() &&
+                    iter->second.table.wait_for(std::chrono::seconds(0)) !=
+                      std::future_status::ready) {
+                    _tables.erase(iter);
+                }
+            }
+            generated.set_exception(std::current_exception());
+            throw;
+        }
+        return pending;
+    }
+} // namespace electionguard
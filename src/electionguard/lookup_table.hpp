@@ -1,22 +1,26 @@
 #ifndef __ELECTIONGUARD_CPP_LOOKUP_TABLE_HPP_INCLUDED__
 #define __ELECTIONGUARD_CPP_LOOKUP_TABLE_HPP_INCLUDED__
 
-#include "facades/bignum256.hpp"
+#include "electionguard/constants.h"
 #include "facades/bignum4096.hpp"
 #include "utils.hpp"
 
+#include <algorithm>
 #include <array>
 #include <cstdint>
 #include <electionguard/async.hpp>
-#include <electionguard/constants.h>
 #include <electionguard/export.h>
+#include <future>
 #include <iomanip>
 #include <iostream>
 #include <memory>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 using electionguard::facades::Bignum4096;
 using electionguard::facades::CONTEXT_P;
-using hacl::Bignum256;
 using std::begin;
 using std::copy;
 using std::end;
@@ -27,58 +31,89 @@ namespace electionguard
     /// <summary>
     /// A fixed-base lookup tables used to precompute components for exponentiation.
     ///
-    /// For a given base, precompute `b` bit tables over a `k` window size
-    /// with a specific `m` table length.
+    /// For a given base, precompute `m` rows of `2^k` values, where `k` is the window size
+    /// and `m` is the number of `k` bit windows needed to cover the `b` order bits.
+    /// Row `i` holds base^(j * 2^(k * i)) for each `j` in [1, 2^k).
     ///
     /// when executing a `pow_mod_p` operation, the exponent is sliced into k-bits
     /// and each slice is multiplied together using the values precomputed in the lookup table
     ///
-    /// note this implementation is tuned sepcifically for the following values:
-    /// b order bits = 256
-    /// k window size = 8
-    /// m table length = 32
-    ///
-    /// any changes to these values may impact the internal operation of the functions.
+    /// the window size may be any value from 4 to 12 bits. Larger windows need
+    /// fewer multiplications per exponentiation but the table grows exponentially:
+    /// k = 4 uses 512 KB, k = 8 uses 4 MB and k = 12 uses 44 MB per base.
     /// </summary>
-    template <uint64_t WindowSize, uint64_t OrderBits, uint64_t TableLength>
+    template <uint64_t WindowSize, uint64_t OrderBits = LUT_ORDER_BITS>
     class EG_INTERNAL_API LookupTable
     {
-        typedef std::array<std::array<uint64_t[MAX_P_LEN], OrderBits>, TableLength> FixedBaseTable;
+        static_assert(WindowSize >= 4 && WindowSize <= 12,
+                      "the lookup table window size must be between 4 and 12 bits");
+        static_assert(OrderBits <= MAX_Q_LEN * 64, "the order bits must fit in an ElementModQ");
 
       public:
-        explicit LookupTable(uint64_t *base) { generateTable(base, MAX_P_LEN); }
+        /// <summary>
+        /// the number of windows needed to cover the exponent
+        /// </summary>
+        static constexpr uint64_t TableLength = (OrderBits + WindowSize - 1) / WindowSize;
+
+        /// <summary>
+        /// the number of values in each row, including the unused zero slice
+        /// </summary>
+        static constexpr uint64_t RowLength = 1UL << WindowSize;
+
+        /// <summary>
+        /// the size of the table in bytes
+        /// </summary>
+        static constexpr uint64_t TableSize = TableLength * RowLength * MAX_P_LEN * sizeof(uint64_t);
+
+        /// <summary>
+        /// the number of limbs in the table
+        /// </summary>
+        static constexpr uint64_t TableLimbs = TableLength * RowLength * MAX_P_LEN;
+
+        explicit LookupTable(const uint64_t *base) : _ownedTable(TableLimbs)
+        {
+            _lookupTable = _ownedTable.data();
+            generateTable(base, MAX_P_LEN);
+        }
+
+        /// <summary>
+        /// wrap a table that was previously generated, for instance one mapped from a file.
+        /// the storage must hold `TableLimbs` limbs and is kept alive by the table.
+        /// </summary>
+        LookupTable(const uint64_t *table, std::shared_ptr<const void> storage)
+            : _lookupTable(table), _storage(std::move(storage))
+        {
+            setOneInMontgomeryForm();
+        }
+
+        /// <summary>
+        /// the raw table values in montgomery form
+        /// </summary>
+        const uint64_t *data() const { return _lookupTable; }
 
         /// <summary>
         /// calcuate pow_mod_p using the precomputed fixed base.
         /// </summary>
-        std::vector<uint64_t> pow_mod_p(uint64_t (&exponent)[MAX_Q_LEN]) const
+        std::vector<uint64_t> pow_mod_p(const uint64_t (&exponent)[MAX_Q_LEN]) const
         {
             uint64_t montgomery_result[MAX_P_LEN] = {};
             uint64_t result[MAX_P_LEN] = {};
-            uint8_t exponentBytes[MAX_Q_SIZE] = {};
 
             // copy the 1 in montgomery form into montgomery_result to start
             copy((uint64_t *)one_in_montgomery_form, (uint64_t *)one_in_montgomery_form + MAX_P_LEN,
                  montgomery_result);
 
-            // convert the bignum to byte array
-            // which aligns with the k window size
-            Bignum256::toBytes(static_cast<uint64_t *>(exponent),
-                               static_cast<uint8_t *>(exponentBytes));
-            // reverse the byte order to account for the way hacl offsets its limbs
-            std::reverse(std::begin(exponentBytes), std::end(exponentBytes));
-
             // iterate over rows-m slicing each segment of the exponent
             // and lookup the table values before executing a mul_mod_p operation
-            for (uint64_t i = 0; i < _lookupTable.size(); i++) {
-                auto slice = exponentBytes[i];
+            for (uint64_t i = 0; i < TableLength; i++) {
+                auto slice = getSlice(exponent, i);
 
-                // skip zero bytes
+                // skip zero slices
                 if (slice == 0) {
                     continue;
                 }
 
-                mul_mod_p_mont(montgomery_result, const_cast<uint64_t *>(_lookupTable[i][slice]),
+                mul_mod_p_mont(montgomery_result, const_cast<uint64_t *>(getEntry(i, slice)),
                                montgomery_result);
             }
 
@@ -91,36 +126,76 @@ namespace electionguard
         }
 
       protected:
-        void generateTable(uint64_t *base, uint64_t len)
+        /// <summary>
+        /// get the `index` window of the exponent.
+        /// windows that are not byte aligned may span two limbs.
+        /// </summary>
+        static constexpr uint64_t getSlice(const uint64_t (&exponent)[MAX_Q_LEN], uint64_t index)
         {
-            // checking for power of two ensures the table is uniform
-            if (!isPowerOfTwo(WindowSize)) {
-                throw;
+            const uint64_t offset = index * WindowSize;
+            const uint64_t limb = offset / 64;
+            const uint64_t shift = offset % 64;
+
+            uint64_t slice = exponent[limb] >> shift;
+            if (shift + WindowSize > 64 && limb + 1 < MAX_Q_LEN) {
+                slice |= exponent[limb + 1] << (64 - shift);
             }
+            return slice & (RowLength - 1);
+        }
 
-            uint64_t row_base[MAX_P_LEN] = {};
-            uint64_t running_base[MAX_P_LEN] = {};
-            uint64_t one[MAX_P_LEN] = {1UL};
+        const uint64_t *getEntry(uint64_t row, uint64_t slice) const
+        {
+            return &_lookupTable[(row * RowLength + slice) * MAX_P_LEN];
+        }
 
-            // convert base to montgomery form
-            CONTEXT_P().to_montgomery_form(base, row_base);
+        uint64_t *getEntry(uint64_t row, uint64_t slice)
+        {
+            return &_ownedTable[(row * RowLength + slice) * MAX_P_LEN];
+        }
 
-            // assign initial values
-            copy(row_base, row_base + len, running_base);
+        void generateTable(const uint64_t *base, uint64_t len)
+        {
+            // the first value of each row is base^(2^(k * i)) so it is derived
+            // from the previous row with k squarings. computing these serially
+            // lets the rows themselves be filled in parallel
+            std::vector<std::array<uint64_t, MAX_P_LEN>> row_bases(TableLength);
+            CONTEXT_P().to_montgomery_form(const_cast<uint64_t *>(base), row_bases[0].data());
+            for (uint64_t i = 1; i < TableLength; i++) {
+                row_bases[i] = row_bases[i - 1];
+                for (uint64_t s = 0; s < WindowSize; s++) {
+                    mul_mod_p_mont(row_bases[i].data(), row_bases[i].data(), row_bases[i].data());
+                }
+            }
 
-            // iterate over each m-row in the table
+            std::vector<std::future<void>> tasks;
+            tasks.reserve(TableLength);
             for (uint64_t i = 0; i < TableLength; i++) {
-                // iterate over each b-bit and compute the table values
-                for (uint64_t j = 1; j < OrderBits; j++) {
-                    copy(begin(running_base), end(running_base), begin(_lookupTable[i][j]));
-                    mul_mod_p_mont(running_base, row_base, running_base);
-                }
-                copy(begin(running_base), end(running_base), begin(row_base));
+                tasks.push_back(
+                  Scheduler::submit([this, &row_bases, i, len]() { generateRow(i, row_bases[i].data(), len); }));
             }
+            when_all(tasks);
 
-            // also convert 1 to montgomery form and store it because we use it to
+            setOneInMontgomeryForm();
+        }
+
+        void generateRow(uint64_t row, uint64_t *row_base, uint64_t len)
+        {
+            uint64_t running_base[MAX_P_LEN] = {};
+            copy(row_base, row_base + len, running_base);
+
+            // iterate over each slice value and compute the table values
+            for (uint64_t j = 1; j < RowLength; j++) {
+                copy(begin(running_base), end(running_base), getEntry(row, j));
+                mul_mod_p_mont(running_base, row_base, running_base);
+            }
+        }
+
+        void setOneInMontgomeryForm()
+        {
+            // convert 1 to montgomery form and store it because we use it to
             // start every table based exponentiation and there is no point in
             // computing it each time
+            uint64_t one[MAX_P_LEN] = {1UL};
             CONTEXT_P().to_montgomery_form(one, one_in_montgomery_form);
         }
 
@@ -130,14 +205,31 @@ namespace electionguard
         }
 
       private:
-        FixedBaseTable _lookupTable = {};
+        std::vector<uint64_t> _ownedTable;
+        const uint64_t *_lookupTable = nullptr;
+        std::shared_ptr<const void> _storage;
         uint64_t one_in_montgomery_form[MAX_P_LEN] = {};
     };
 
-    typedef LookupTable<LUT_WINDOW_SIZE, LUT_ORDER_BITS, LUT_TABLE_LENGTH> LookupTableType;
+    typedef LookupTable<LUT_WINDOW_SIZE, LUT_ORDER_BITS> LookupTableType;
+    static_assert(LookupTableType::TableLength == LUT_TABLE_LENGTH,
+                  "LUT_TABLE_LENGTH must match the lookup table");
 
     /// <summary>
-    /// A singleton context for a collection of fixed base lookup tables.
+    /// A singleton registry of fixed base lookup tables.
+    ///
+    /// Tables are keyed by a 64-bit digest of the base. The full base is stored
+    /// alongside each table and compared on lookup so a digest collision never
+    /// returns the wrong table. Lookups take a shared lock so concurrent
+    /// exponentiations do not serialize on the registry.
+    ///
+    /// A table is created either explicitly with `registerFixedBase` or lazily
+    /// the first time a base flagged as a fixed base is exponentiated. Only the
+    /// first thread to miss on a base generates its table and the others wait for it,
+    /// except for scheduler workers, which exponentiate without the table meanwhile
+    /// so they never block the tasks that generate its rows.
+    /// `releaseFixedBase` drops a registration and removes the table once every
+    /// registration has been released.
     /// </summary>
     class EG_INTERNAL_API LookupTableContext
     {
@@ -152,40 +244,79 @@ namespace electionguard
         ~LookupTableContext() {}
 
       public:
-        static LookupTableContext &getInstance()
-        {
-            static LookupTableContext instance;
-            return instance;
-        }
+        static LookupTableContext &getInstance();
 
         /// <summary>
-        /// calcuate pow_mod_p using the provided fixed base.
+        /// compute the digest used to identify a fixed base.
         /// </summary>
-        static std::vector<uint64_t> pow_mod_p(std::string key, uint64_t (&base)[MAX_P_LEN],
-                                               uint64_t (&exponent)[MAX_Q_LEN])
-        {
-            LookupTableType *public_key_table = NULL;
-            {
-                getInstance().task_lock.wait();
-                public_key_table = getInstance().getBaseLookupTable(key, base);
-            }
-            return public_key_table->pow_mod_p(exponent);
-        }
+        static uint64_t digest(const uint64_t (&base)[MAX_P_LEN]);
+
+        /// <summary>
+        /// generate the lookup table for the base if one does not exist
+        /// and hold a registration for it until it is released.
+        /// <returns>the digest of the base</returns>
+        /// </summary>
+        static uint64_t registerFixedBase(const uint64_t (&base)[MAX_P_LEN]);
+
+        /// <summary>
+        /// release a registration of the base.
+        /// the table is removed when no registrations remain.
+        /// tables that were never registered are not removed.
+        /// <returns>true if the table was removed</returns>
+        /// </summary>
+        static bool releaseFixedBase(const uint64_t (&base)[MAX_P_LEN]);
+
+        /// <summary>
+        /// get the lookup table for the base.
+        /// <returns>the table or nullptr if one does not exist</returns>
+        /// </summary>
+        static std::shared_ptr<const LookupTableType>
+        getFixedBase(const uint64_t (&base)[MAX_P_LEN]);
+
+        /// <summary>
+        /// write the lookup table of the base to a file so it can be loaded
+        /// with `loadFixedBase` instead of being generated again.
+        /// the table is generated if one does not exist.
+        /// the values are stored in host byte order.
+        /// </summary>
+        static void saveFixedBase(const uint64_t (&base)[MAX_P_LEN], const std::string &path);
+
+        /// <summary>
+        /// memory map a lookup table written by `saveFixedBase` and hold a registration for it.
+        /// Throws if the file is malformed or was written for a different base,
+        /// window size or prime.
+        /// <returns>the digest of the base</returns>
+        /// </summary>
+        static uint64_t loadFixedBase(const uint64_t (&base)[MAX_P_LEN], const std::string &path);
+
+        /// <summary>
+        /// calcuate pow_mod_p using the provided fixed base,
+        /// generating the lookup table if one does not exist.
+        /// </summary>
+        static std::vector<uint64_t> pow_mod_p(const uint64_t (&base)[MAX_P_LEN],
+                                               const uint64_t (&exponent)[MAX_Q_LEN]);
 
       private:
-        AsyncSemaphore task_lock;
-        std::map<std::string, std::unique_ptr<LookupTableType>> key_map;
+        // a table that is not ready until the thread generating it is done
+        typedef std::shared_future<std::shared_ptr<const LookupTableType>> PendingTable;
 
-        LookupTableType *getBaseLookupTable(const std::string key, uint64_t (&base)[MAX_P_LEN])
-        {
-            auto const iter = key_map.find(key);
-            if (iter != key_map.end()) {
-                return key_map[key].get();
-            }
+        struct Entry {
+            std::array<uint64_t, MAX_P_LEN> base;
+            PendingTable table;
+            uint64_t registrations;
+        };
 
-            key_map.emplace(std::pair(key, new LookupTableType(static_cast<uint64_t *>(base))));
-            return key_map[key].get();
-        }
+        /// <returns>the table or an invalid future if one does not exist</returns>
+        PendingTable find(uint64_t digest, const uint64_t (&base)[MAX_P_LEN]);
+
+        /// <returns>the table, or an invalid future if the digest collides
+        /// with another base</returns>
+        PendingTable findOrCreate(uint64_t digest, const uint64_t (&base)[MAX_P_LEN],
+                                  bool shouldRegister,
+                                  std::shared_ptr<const LookupTableType> table = nullptr);
+
+        std::shared_mutex _mutex;
+        std::unordered_map<uint64_t, Entry> _tables;
     };
 
 } // namespace electionguard
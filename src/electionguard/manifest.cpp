@@ -5,9 +5,12 @@
 #include "serialize.hpp"
 #include "utils.hpp"
 
+#include <algorithm>
 #include <cstring>
 #include <iostream>
+#include <mutex>
 #include <set>
+#include <unordered_map>
 #include <utility>
 
 using std::make_unique;
@@ -20,6 +23,7 @@ using std::runtime_error;
 using std::string;
 using std::to_string;
 using std::unique_ptr;
+using std::unordered_map;
 using std::vector;
 using std::chrono::system_clock;
 
@@ -955,10 +959,18 @@ namespace electionguard
 
         [[nodiscard]] unique_ptr<ElementModQ> crypto_hash() const
         {
-            auto hash = hash_elems({object_id, sequenceOrder, candidateId});
-            Log::trace("SelectionDescription", hash.get());
-            return hash;
-        }
+            // the description cannot change once constructed,
+            // so the hash is computed once and shared by every caller
+            std::call_once(hashOnce, [this]() {
+                cachedHash = hash_elems({object_id, sequenceOrder, candidateId});
+                Log::trace("SelectionDescription", cachedHash.get());
+            });
+            return make_unique<ElementModQ>(*cachedHash);
+        }
+
+      private:
+        mutable std::once_flag hashOnce;
+        mutable unique_ptr<ElementModQ> cachedHash;
     };
 
     // Lifecycle Methods
@@ -1107,6 +1119,18 @@ namespace electionguard
         }
 
         [[nodiscard]] unique_ptr<ElementModQ> crypto_hash() const
+        {
+            // the description cannot change once constructed,
+            // so the hash is computed once and shared by every caller
+            std::call_once(hashOnce, [this]() { cachedHash = makeCryptoHash(); });
+            return make_unique<ElementModQ>(*cachedHash);
+        }
+
+      private:
+        mutable std::once_flag hashOnce;
+        mutable unique_ptr<ElementModQ> cachedHash;
+
+        [[nodiscard]] unique_ptr<ElementModQ> makeCryptoHash() const
         {
             vector<reference_wrapper<CryptoHashable>> selectionRefs;
             selectionRefs.reserve(selections.size());
@@ -1825,6 +1849,13 @@ namespace electionguard
         vector<unique_ptr<BallotStyle>> ballotStyles;
         unique_ptr<ElementModQ> manifestHash;
 
+        // lookups built once so per ballot queries do not scan the manifest
+        unordered_map<string, BallotStyle *> ballotStylesById;
+        unordered_map<string, vector<reference_wrapper<ContestDescriptionWithPlaceholders>>>
+          contestsByBallotStyleId;
+        unordered_map<string, ContestDescriptionWithPlaceholders *> contestsById;
+        unordered_map<string, Candidate *> candidatesById;
+
         Impl(vector<unique_ptr<GeopoliticalUnit>> geopoliticalUnits,
              vector<unique_ptr<Candidate>> candidates,
              vector<unique_ptr<ContestDescriptionWithPlaceholders>> contests,
@@ -1833,6 +1864,54 @@ namespace electionguard
               contests(move(contests)), ballotStyles(move(ballotStyles)),
               manifestHash(move(manifestHash))
         {
+            // compute the description hashes up front so encrypting
+            // and validating ballots only ever reads the cached values
+            for (const auto &contest : this->contests) {
+                contest->crypto_hash();
+                for (const auto &placeholder : contest->getPlaceholders()) {
+                    placeholder.get().crypto_hash();
+                }
+            }
+            buildIndexes();
+        }
+
+      private:
+        void buildIndexes()
+        {
+            for (const auto &candidate : candidates) {
+                candidatesById.emplace(candidate->getObjectId(), candidate.get());
+            }
+
+            // a later contest with the same id replaces an earlier one
+            for (const auto &contest : contests) {
+                contestsById[contest->getObjectId()] = contest.get();
+            }
+
+            for (const auto &style : ballotStyles) {
+                // the first style with a given id wins
+                if (!ballotStylesById.emplace(style->getObjectId(), style.get()).second) {
+                    continue;
+                }
+
+                vector<reference_wrapper<ContestDescriptionWithPlaceholders>> styleContests;
+                auto gpUnitIds = style->getGeopoliticalUnitIds();
+                for (const auto &contest : contests) {
+                    for (const auto &gpUnitId : gpUnitIds) {
+                        if (contest->getElectoralDistrictId() == gpUnitId) {
+                            styleContests.push_back(ref(*contest));
+                        }
+                    }
+                }
+
+                stable_sort(styleContests.begin(), styleContests.end(),
+                            [](const reference_wrapper<ContestDescriptionWithPlaceholders> left,
+                               const reference_wrapper<ContestDescriptionWithPlaceholders> right) {
+                                return left.get().getSequenceOrder() <
+                                       right.get().getSequenceOrder();
+                            });
+
+                contestsByBallotStyleId.emplace(style->getObjectId(), move(styleContests));
+            }
         }
     };
 
@@ -1922,12 +2001,11 @@ namespace electionguard
 
     BallotStyle *InternalManifest::getBallotStyle(const std::string &ballotStyleId) const
     {
-        for (auto &style : pimpl->ballotStyles) {
-            if (style->getObjectId() == ballotStyleId) {
-                return style.get();
-            }
+        auto style = pimpl->ballotStylesById.find(ballotStyleId);
+        if (style == pimpl->ballotStylesById.end()) {
+            return nullptr;
         }
-        return nullptr;
+        return style->second;
     }
 
     vector<reference_wrapper<ContestDescriptionWithPlaceholders>>
@@ -1938,22 +2016,25 @@ namespace electionguard
             throw runtime_error("Could not resolve a valid geopolitical unit");
         }
 
-        vector<reference_wrapper<ContestDescriptionWithPlaceholders>> contests;
-        for (const auto &reference : pimpl->contests) {
-            for (const auto &gpUnitId : style->getGeopoliticalUnitIds()) {
-                if (reference->getElectoralDistrictId() == gpUnitId) {
-                    contests.push_back(ref(*reference));
-                }
-            }
-        }
+        return pimpl->contestsByBallotStyleId.at(ballotStyleId);
+    }
 
-        sort(contests.begin(), contests.end(),
-             [](const reference_wrapper<ContestDescriptionWithPlaceholders> left,
-                const reference_wrapper<ContestDescriptionWithPlaceholders> right) {
-                 return left.get().getSequenceOrder() < right.get().getSequenceOrder();
-             });
+    ContestDescriptionWithPlaceholders *InternalManifest::getContest(const string &contestId) const
+    {
+        auto contest = pimpl->contestsById.find(contestId);
+        if (contest == pimpl->contestsById.end()) {
+            return nullptr;
+        }
+        return contest->second;
+    }
 
-        return contests;
+    Candidate *InternalManifest::getCandidate(const string &candidateId) const
+    {
+        auto candidate = pimpl->candidatesById.find(candidateId);
+        if (candidate == pimpl->candidatesById.end()) {
+            return nullptr;
+        }
+        return candidate->second;
     }
 
     vector<uint8_t> InternalManifest::toBson() const
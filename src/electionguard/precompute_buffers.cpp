@@ -1,5 +1,9 @@
+#include "../../libs/hacl/Lib.hpp"
+#include "electionguard/async.hpp"
+#include "electionguard/election.hpp"
 #include "electionguard/group.hpp"
 #include "log.hpp"
+#include "precompute_file.hpp"
 #include "utils.hpp"
 
 #include <array>
@@ -11,15 +15,34 @@
 #include <iostream>
 #include <memory>
 
+using hacl::Lib;
 using std::begin;
 using std::copy;
 using std::end;
 using std::lock_guard;
+using std::make_shared;
 using std::make_unique;
+using std::shared_ptr;
 using std::unique_ptr;
 
 namespace electionguard
 {
+    /// <summary>
+    /// The producers loop until the queues reach their high watermarks, which can take
+    /// minutes, so they run on a pool of their own instead of the shared Scheduler and
+    /// never hold a worker that encryption, tally or decryption tasks are queued behind.
+    /// </summary>
+    static ThreadPool &getProducerPool()
+    {
+        static ThreadPool pool;
+        return pool;
+    }
+
+    /// <summary>
+    /// Wipe a record once it is copied out, the records hold the secret nonces
+    /// </summary>
+    template <typename T> static void zeroRecord(T &record) { Lib::memZero(&record, sizeof(T)); }
+
 #pragma region Triple
     Triple::Triple(unique_ptr<ElementModQ> exp, unique_ptr<ElementModP> g_to_exp,
                    unique_ptr<ElementModP> pubkey_to_exp)
@@ -74,6 +97,20 @@ namespace electionguard
         return make_unique<Triple>(exp->clone(), g_to_exp->clone(), pubkey_to_exp->clone());
     }
 
+    unique_ptr<Triple> Triple::fromRecord(const PrecomputedTripleRecord &record)
+    {
+        return make_unique<Triple>(make_unique<ElementModQ>(record.exp, true),
+                                   make_unique<ElementModP>(record.g_to_exp, true),
+                                   make_unique<ElementModP>(record.pubkey_to_exp, true));
+    }
+
+    void Triple::toRecord(PrecomputedTripleRecord &record) const
+    {
+        copy(begin(exp->ref()), end(exp->ref()), begin(record.exp));
+        copy(begin(g_to_exp->ref()), end(g_to_exp->ref()), begin(record.g_to_exp));
+        copy(begin(pubkey_to_exp->ref()), end(pubkey_to_exp->ref()), begin(record.pubkey_to_exp));
+    }
+
 #pragma endregion
 
 #pragma region Quadruple
@@ -141,6 +178,24 @@ namespace electionguard
                                       g_to_exp2_mult_by_pubkey_to_exp1->clone());
     }
 
+    unique_ptr<Quadruple> Quadruple::fromRecord(const PrecomputedQuadrupleRecord &record)
+    {
+        return make_unique<Quadruple>(
+          make_unique<ElementModQ>(record.exp1, true), make_unique<ElementModQ>(record.exp2, true),
+          make_unique<ElementModP>(record.g_to_exp1, true),
+          make_unique<ElementModP>(record.g_to_exp2_mult_by_pubkey_to_exp1, true));
+    }
+
+    void Quadruple::toRecord(PrecomputedQuadrupleRecord &record) const
+    {
+        copy(begin(exp1->ref()), end(exp1->ref()), begin(record.exp1));
+        copy(begin(exp2->ref()), end(exp2->ref()), begin(record.exp2));
+        copy(begin(g_to_exp1->ref()), end(g_to_exp1->ref()), begin(record.g_to_exp1));
+        copy(begin(g_to_exp2_mult_by_pubkey_to_exp1->ref()),
+             end(g_to_exp2_mult_by_pubkey_to_exp1->ref()),
+             begin(record.g_to_exp2_mult_by_pubkey_to_exp1));
+    }
+
 #pragma endregion
 
 #pragma region TwoTriplesAndAQuadruple
@@ -193,6 +248,21 @@ namespace electionguard
                                                     quad->clone());
     }
 
+    unique_ptr<TwoTriplesAndAQuadruple>
+    TwoTriplesAndAQuadruple::fromRecord(const PrecomputedSelectionRecord &record)
+    {
+        return make_unique<TwoTriplesAndAQuadruple>(Triple::fromRecord(record.triple1),
+                                                    Triple::fromRecord(record.triple2),
+                                                    Quadruple::fromRecord(record.quad));
+    }
+
+    void TwoTriplesAndAQuadruple::toRecord(PrecomputedSelectionRecord &record) const
+    {
+        triple1->toRecord(record.triple1);
+        triple2->toRecord(record.triple2);
+        quad->toRecord(record.quad);
+    }
+
 #pragma endregion
 
 #pragma region PrecomputeBuffer
@@ -204,24 +274,31 @@ namespace electionguard
         : maxQueueSize(maxQueueSize == 0 ? DEFAULT_PRECOMPUTE_SIZE : maxQueueSize),
           shouldAutoPopulate(shouldAutoPopulate), publicKey(publicKey.clone())
     {
+        // by default fill the queue completely and refill once a quarter remains
+        highWatermark = this->maxQueueSize;
+        lowWatermark = this->maxQueueSize / 4;
+
+        // the triple watermarks are capped by the max queue size, so a triple
+        // ring the same size as the quadruple ring always has room for them
+        triple_queue = make_unique<AsyncRingBuffer<PrecomputedTripleRecord>>(this->maxQueueSize);
+        twoTriplesAndAQuadruple_queue =
+          make_unique<AsyncRingBuffer<PrecomputedSelectionRecord>>(this->maxQueueSize);
     }
-    PrecomputeBuffer::~PrecomputeBuffer() = default;
+    PrecomputeBuffer::~PrecomputeBuffer() { stop(); }
 
     void PrecomputeBuffer::clear()
     {
         stop();
 
-        std::lock_guard<std::mutex> lock1(triple_queue_lock);
-        uint32_t triple_size = triple_queue.size();
-        for (int i = 0; i < (int)triple_size; i++) {
-            triple_queue.pop();
+        PrecomputedTripleRecord triple;
+        while (triple_queue->pop(triple, zeroRecord<PrecomputedTripleRecord>)) {
         }
+        zeroRecord(triple);
 
-        std::lock_guard<std::mutex> lock2(quad_queue_lock);
-        uint32_t twoTriplesAndAQuadruple_size = twoTriplesAndAQuadruple_queue.size();
-        for (int i = 0; i < (int)twoTriplesAndAQuadruple_size; i++) {
-            twoTriplesAndAQuadruple_queue.pop();
+        PrecomputedSelectionRecord quad;
+        while (twoTriplesAndAQuadruple_queue->pop(quad, zeroRecord<PrecomputedSelectionRecord>)) {
         }
+        zeroRecord(quad);
     }
 
     void PrecomputeBuffer::start()
@@ -231,63 +308,289 @@ namespace electionguard
         }
 
         isRunning = true;
+        populate();
+    }
+
+    void PrecomputeBuffer::startAsync()
+    {
+        if (publicKey == nullptr) {
+            throw std::runtime_error(
+              "PrecomputeBufferContext::startAsync() - elgamalPublicKey is null");
+        }
+
+        std::lock_guard<std::mutex> lock(producer_lock);
+        isRunning = true;
+        scheduleProducers();
+    }
+
+    void PrecomputeBuffer::stop()
+    {
+        isRunning = false;
+
+        std::lock_guard<std::mutex> lock(producer_lock);
+        for (auto &producer : producers) {
+            try {
+                producer.get();
+            } catch (const std::exception &e) {
+                Log::error("PrecomputeBuffer::stop() - producer failed", e);
+            }
+        }
+        producers.clear();
+    }
+
+    void PrecomputeBuffer::scheduleProducers()
+    {
+        for (auto &producer : producers) {
+            if (!isReady(producer)) {
+                // already populating
+                return;
+            }
+        }
 
-        // This loop goes through until the queues are full but can be stopped
-        // between generations of two triples and a quad. By full it means
-        // we check how many quads are in the queue, to start with we will
-        // try 5000 and see how that works. If the vendor wanted to pass the
-        // queue size in we could use that.
-        // for now we just go through the loop once
-        int iteration_count = 0;
-        int iterationCountToGenerateTwoTriples = 3;
-        do {
-            std::lock_guard<std::mutex> lock1(triple_queue_lock);
-            std::lock_guard<std::mutex> lock2(quad_queue_lock);
-
-            // generate two triples and a quadruple
-            auto quad = createTwoTriplesAndAQuadruple(*publicKey);
-            twoTriplesAndAQuadruple_queue.push(move(quad));
-
-            // This is very rudimentary. We can add a more complex algorithm in
-            // the future, that would look at the queues and increase production if one
-            // is getting lower than expected.
-            // Every third iteration we generate two extra triples, one for use with
-            // the contest constant chaum pedersen proof and one for hashed elgamal encryption
-            // we need less of these because this exponentiation is done only every contest
-            // encryption whereas the two triples and a quadruple is used every selection
-            // encryption. The generating two triples every third iteration is a guess
-            // on how many precomputes we will need.
-            if ((iteration_count % iterationCountToGenerateTwoTriples) == 0) {
-                auto tuple = createTwoTriples(*publicKey);
-                triple_queue.push(move(std::get<0>(tuple)));
-                triple_queue.push(move(std::get<1>(tuple)));
+        // collect any producers left over from a previous run that filled the queue
+        for (auto &producer : producers) {
+            try {
+                producer.get();
+            } catch (const std::exception &e) {
+                Log::error("PrecomputeBuffer::scheduleProducers() - producer failed", e);
             }
-            iteration_count++;
+        }
+        producers.clear();
 
-        } while (isRunning && twoTriplesAndAQuadruple_queue.size() < maxQueueSize);
+        auto producerCount = std::max(1U, std::thread::hardware_concurrency());
+        for (uint32_t i = 0; i < producerCount; i++) {
+            producers.push_back(getProducerPool().submit([this]() { populate(); }));
+        }
     }
 
-    void PrecomputeBuffer::startAsync()
+    bool PrecomputeBuffer::hasActiveProducers()
     {
-        // TODO: Issue #217: implement this
-        start();
+        if (activeProducerCount > 0) {
+            return true;
+        }
+        for (auto &producer : producers) {
+            if (!isReady(producer)) {
+                return true;
+            }
+        }
+        return false;
     }
 
-    void PrecomputeBuffer::stop() { isRunning = false; }
+    void PrecomputeBuffer::refillIfNeeded()
+    {
+        if (!shouldAutoPopulate || !isRunning || activeProducerCount > 0) {
+            return;
+        }
+
+        if (twoTriplesAndAQuadruple_queue->size() >= lowWatermark &&
+            triple_queue->size() >= getTripleLowWatermark()) {
+            return;
+        }
+
+        // never block an encryption on the producers, if another thread
+        // is already starting or stopping them there is nothing to do
+        std::unique_lock<std::mutex> lock(producer_lock, std::try_to_lock);
+        if (lock.owns_lock() && isRunning) {
+            Log::debug("PrecomputeBuffer: queue below low watermark, refilling");
+            scheduleProducers();
+        }
+    }
+
+    uint32_t PrecomputeBuffer::scaleByTripleRatio(uint32_t quadCount)
+    {
+        // Every selection encryption consumes two triples and a quadruple,
+        // every contest consumes a triple for the hashed elgamal encryption
+        // of the extended data and one for the constant chaum pedersen proof.
+        // Start from the assumption of two triples for every three quadruples
+        // and follow the observed demand once there is some.
+        uint64_t triples = triplesRequested + 2;
+        uint64_t quads = quadsRequested + 3;
+        uint64_t scaled = (static_cast<uint64_t>(quadCount) * triples + quads - 1) / quads;
+        return static_cast<uint32_t>(std::min<uint64_t>(scaled, maxQueueSize));
+    }
+
+    void PrecomputeBuffer::populate()
+    {
+        activeProducerCount++;
+
+        // This loop goes through until both queues reach their high watermarks
+        // but can be stopped between generations. Each iteration generates a
+        // value for whichever queue is the emptiest relative to its watermark,
+        // counting the values other producers are currently generating.
+        while (isRunning) {
+            uint64_t quadTarget = highWatermark;
+            uint64_t tripleTarget = getTripleHighWatermark();
+            uint64_t quadCount = twoTriplesAndAQuadruple_queue->size() + pendingQuadCount;
+            uint64_t tripleCount = triple_queue->size() + pendingTripleCount;
+
+            bool needsQuad = quadCount < quadTarget;
+            bool needsTriple = tripleCount < tripleTarget;
+            if (!needsQuad && !needsTriple) {
+                break;
+            }
+
+            if (needsQuad && (!needsTriple || quadCount * tripleTarget <= tripleCount * quadTarget)) {
+                // reserve a slot so concurrent producers do not overfill the queue
+                if (twoTriplesAndAQuadruple_queue->size() + pendingQuadCount.fetch_add(1) >=
+                    quadTarget) {
+                    pendingQuadCount--;
+                    continue;
+                }
+
+                // take two triples and a quadruple from the pool file
+                // or generate them outside of the queue
+                PrecomputedSelectionRecord quad;
+                if (file == nullptr || !file->takeTwoTriplesAndAQuadruple(quad)) {
+                    createTwoTriplesAndAQuadruple(*publicKey)->toRecord(quad);
+                }
+                auto pushed = twoTriplesAndAQuadruple_queue->push(quad);
+                zeroRecord(quad);
+                pendingQuadCount--;
+                if (!pushed) {
+                    // the reservation keeps the queue below its capacity unless the
+                    // watermarks change underneath the producer, stop rather than spin
+                    Log::warn("PrecomputeBuffer: quadruple queue is full, discarding a value");
+                    break;
+                }
+            } else {
+                if (triple_queue->size() + pendingTripleCount.fetch_add(1) >= tripleTarget) {
+                    pendingTripleCount--;
+                    continue;
+                }
+
+                PrecomputedTripleRecord triple;
+                if (file == nullptr || !file->takeTriple(triple)) {
+                    Triple(*publicKey).toRecord(triple);
+                }
+                auto pushed = triple_queue->push(triple);
+                zeroRecord(triple);
+                pendingTripleCount--;
+                if (!pushed) {
+                    Log::warn("PrecomputeBuffer: triple queue is full, discarding a value");
+                    break;
+                }
+            }
+        }
+
+        hasWarnedEmpty = false;
+        activeProducerCount--;
+    }
 
     uint32_t PrecomputeBuffer::getMaxQueueSize() { return maxQueueSize; }
 
     uint32_t PrecomputeBuffer::getCurrentQueueSize()
     {
-        return twoTriplesAndAQuadruple_queue.size();
+        return static_cast<uint32_t>(twoTriplesAndAQuadruple_queue->size());
+    }
+
+    uint32_t PrecomputeBuffer::getCurrentTripleQueueSize()
+    {
+        return static_cast<uint32_t>(triple_queue->size());
+    }
+
+    void PrecomputeBuffer::setWatermarks(uint32_t lowWatermark, uint32_t highWatermark)
+    {
+        if (highWatermark == 0 || highWatermark > maxQueueSize) {
+            throw std::invalid_argument(
+              "PrecomputeBuffer::setWatermarks - high watermark must be in (0, maxQueueSize]");
+        }
+        if (lowWatermark > highWatermark) {
+            throw std::invalid_argument(
+              "PrecomputeBuffer::setWatermarks - low watermark must not exceed high watermark");
+        }
+        this->lowWatermark = lowWatermark;
+        this->highWatermark = highWatermark;
+    }
+
+    uint32_t PrecomputeBuffer::getLowWatermark() { return lowWatermark; }
+
+    uint32_t PrecomputeBuffer::getHighWatermark() { return highWatermark; }
+
+    uint32_t PrecomputeBuffer::getTripleLowWatermark() { return scaleByTripleRatio(lowWatermark); }
+
+    uint32_t PrecomputeBuffer::getTripleHighWatermark()
+    {
+        return scaleByTripleRatio(highWatermark);
     }
 
     ElementModP *PrecomputeBuffer::getPublicKey() { return publicKey.get(); }
 
+    void PrecomputeBuffer::save(const std::string &path)
+    {
+        std::lock_guard<std::mutex> lock(producer_lock);
+        if (hasActiveProducers()) {
+            throw std::runtime_error("PrecomputeBuffer::save() - stop the buffer before saving");
+        }
+
+        // reserve up front so the records are never left behind by a reallocation
+        std::vector<PrecomputedTripleRecord> triples;
+        triples.reserve(triple_queue->size() +
+                        (file != nullptr ? file->getRemainingTripleCount() : 0));
+        PrecomputedTripleRecord triple;
+        while (triple_queue->pop(triple, zeroRecord<PrecomputedTripleRecord>)) {
+            triples.push_back(triple);
+        }
+        while (file != nullptr && file->takeTriple(triple)) {
+            triples.push_back(triple);
+        }
+        zeroRecord(triple);
+
+        std::vector<PrecomputedSelectionRecord> quads;
+        quads.reserve(twoTriplesAndAQuadruple_queue->size() +
+                      (file != nullptr ? file->getRemainingQuadCount() : 0));
+        PrecomputedSelectionRecord quad;
+        while (twoTriplesAndAQuadruple_queue->pop(quad, zeroRecord<PrecomputedSelectionRecord>)) {
+            quads.push_back(quad);
+        }
+        while (file != nullptr && file->takeTwoTriplesAndAQuadruple(quad)) {
+            quads.push_back(quad);
+        }
+        zeroRecord(quad);
+
+        PrecomputeFile::write(path, *publicKey, triples, quads);
+        Lib::memZero(triples.data(), triples.size() * sizeof(PrecomputedTripleRecord));
+        Lib::memZero(quads.data(), quads.size() * sizeof(PrecomputedSelectionRecord));
+    }
+
+    void PrecomputeBuffer::load(const std::string &path)
+    {
+        std::lock_guard<std::mutex> lock(producer_lock);
+        if (hasActiveProducers()) {
+            throw std::runtime_error("PrecomputeBuffer::load() - stop the buffer before loading");
+        }
+
+        file = PrecomputeFile::open(path, *publicKey);
+        fillFromFile();
+    }
+
+    void PrecomputeBuffer::fillFromFile()
+    {
+        // a record taken from the file is spent even if it does not fit in the queue
+        PrecomputedSelectionRecord quad;
+        while (twoTriplesAndAQuadruple_queue->size() < highWatermark &&
+               file->takeTwoTriplesAndAQuadruple(quad)) {
+            if (!twoTriplesAndAQuadruple_queue->push(quad)) {
+                Log::warn("PrecomputeBuffer: quadruple queue is full, discarding a value");
+                break;
+            }
+        }
+        zeroRecord(quad);
+
+        PrecomputedTripleRecord triple;
+        while (triple_queue->size() < getTripleHighWatermark() && file->takeTriple(triple)) {
+            if (!triple_queue->push(triple)) {
+                Log::warn("PrecomputeBuffer: triple queue is full, discarding a value");
+                break;
+            }
+        }
+        zeroRecord(triple);
+    }
+
     std::unique_ptr<Triple> PrecomputeBuffer::getTriple()
     {
-        if (!triple_queue.empty()) {
-            return popTriple().value();
+        auto triple = popTriple();
+        if (triple.has_value() && triple.value() != nullptr) {
+            return move(triple.value());
         }
         return make_unique<Triple>(*publicKey);
     }
@@ -295,21 +598,26 @@ namespace electionguard
     std::optional<std::unique_ptr<Triple>> PrecomputeBuffer::popTriple()
     {
         unique_ptr<Triple> result = nullptr;
-        std::lock_guard<std::mutex> lock(triple_queue_lock);
-
-        // make sure there are enough in the queues
-        if (!triple_queue.empty()) {
-            result = std::move(triple_queue.front());
-            triple_queue.pop();
+        triplesRequested++;
+
+        PrecomputedTripleRecord record;
+        if (triple_queue->pop(record, zeroRecord<PrecomputedTripleRecord>)) {
+            result = Triple::fromRecord(record);
+            zeroRecord(record);
+        } else if (isRunning && !hasWarnedEmpty.exchange(true)) {
+            Log::warn("PrecomputeBuffer: triple queue is empty, falling back to full "
+                      "exponentiation");
         }
 
+        refillIfNeeded();
         return result;
     }
 
     std::unique_ptr<TwoTriplesAndAQuadruple> PrecomputeBuffer::getTwoTriplesAndAQuadruple()
     {
-        if (!twoTriplesAndAQuadruple_queue.empty()) {
-            return popTwoTriplesAndAQuadruple().value();
+        auto quad = popTwoTriplesAndAQuadruple();
+        if (quad.has_value() && quad.value() != nullptr) {
+            return move(quad.value());
         }
 
         return createTwoTriplesAndAQuadruple(*publicKey);
@@ -319,14 +627,18 @@ namespace electionguard
     PrecomputeBuffer::popTwoTriplesAndAQuadruple()
     {
         unique_ptr<TwoTriplesAndAQuadruple> result = nullptr;
-        std::lock_guard<std::mutex> lock(quad_queue_lock);
-
-        // make sure there are enough in the queues
-        if (!twoTriplesAndAQuadruple_queue.empty()) {
-            result = std::move(twoTriplesAndAQuadruple_queue.front());
-            twoTriplesAndAQuadruple_queue.pop();
+        quadsRequested++;
+
+        PrecomputedSelectionRecord record;
+        if (twoTriplesAndAQuadruple_queue->pop(record, zeroRecord<PrecomputedSelectionRecord>)) {
+            result = TwoTriplesAndAQuadruple::fromRecord(record);
+            zeroRecord(record);
+        } else if (isRunning && !hasWarnedEmpty.exchange(true)) {
+            Log::warn("PrecomputeBuffer: quadruple queue is empty, falling back to full "
+                      "exponentiation");
         }
 
+        refillIfNeeded();
         return result;
     }
 
@@ -350,94 +662,214 @@ namespace electionguard
 
 #pragma region PrecomputeBufferContext
 
+    // make sure the producer pool outlives the context so background
+    // producers can be stopped during static destruction
+    PrecomputeBufferContext::PrecomputeBufferContext() { getProducerPool(); }
+    PrecomputeBufferContext::~PrecomputeBufferContext()
+    {
+        for (auto &[key, buffer] : _buffers) {
+            buffer->stop();
+        }
+    }
+
+    PrecomputeBufferContext::PublicKeyType
+    PrecomputeBufferContext::makeKey(const ElementModP &publicKey)
+    {
+        PublicKeyType key;
+        copy(publicKey.get(), publicKey.get() + MAX_P_LEN, key.begin());
+        return key;
+    }
+
+    shared_ptr<PrecomputeBuffer> PrecomputeBufferContext::getCurrent()
+    {
+        std::shared_lock<std::shared_mutex> lock(getInstance()._mutex);
+        return getInstance()._current;
+    }
+
+    shared_ptr<PrecomputeBuffer> PrecomputeBufferContext::getOrCreate(const ElementModP &publicKey)
+    {
+        auto key = makeKey(publicKey);
+        std::unique_lock<std::shared_mutex> lock(getInstance()._mutex);
+        auto &buffers = getInstance()._buffers;
+        auto found = buffers.find(key);
+        if (found == buffers.end()) {
+            found = buffers.emplace(key, make_shared<PrecomputeBuffer>(publicKey)).first;
+        }
+        getInstance()._current = found->second;
+        return found->second;
+    }
+
     void PrecomputeBufferContext::clear()
     {
-        if (getInstance()._instance != nullptr) {
-            getInstance()._instance->clear();
-            getInstance()._instance = nullptr;
+        std::map<PublicKeyType, shared_ptr<PrecomputeBuffer>> buffers;
+        {
+            std::unique_lock<std::shared_mutex> lock(getInstance()._mutex);
+            buffers.swap(getInstance()._buffers);
+            getInstance()._current = nullptr;
+        }
+        // clear outside of the lock since stopping waits on the producers
+        for (auto &[key, buffer] : buffers) {
+            buffer->clear();
         }
     }
 
-    void PrecomputeBufferContext::initialize(const ElementModP &publicKey,
-                                             uint32_t maxQueueSize /* = 0 */)
+    void PrecomputeBufferContext::clear(const ElementModP &publicKey)
     {
-        std::lock_guard<std::mutex> lock(getInstance()._mutex);
-        clear();
-        getInstance()._instance = make_unique<PrecomputeBuffer>(publicKey, maxQueueSize);
+        shared_ptr<PrecomputeBuffer> buffer;
+        {
+            std::unique_lock<std::shared_mutex> lock(getInstance()._mutex);
+            auto &buffers = getInstance()._buffers;
+            auto found = buffers.find(makeKey(publicKey));
+            if (found == buffers.end()) {
+                return;
+            }
+            buffer = found->second;
+            buffers.erase(found);
+            if (getInstance()._current == buffer) {
+                getInstance()._current = nullptr;
+            }
+        }
+        buffer->clear();
+    }
+
+    void PrecomputeBufferContext::initialize(const ElementModP &publicKey,
+                                             uint32_t maxQueueSize /* = 0 */,
+                                             bool shouldAutoPopulate /* = false */)
+    {
+        auto buffer = make_shared<PrecomputeBuffer>(publicKey, maxQueueSize, shouldAutoPopulate);
+        shared_ptr<PrecomputeBuffer> replaced;
+        {
+            std::unique_lock<std::shared_mutex> lock(getInstance()._mutex);
+            auto &existing = getInstance()._buffers[makeKey(publicKey)];
+            replaced.swap(existing);
+            existing = buffer;
+            getInstance()._current = buffer;
+        }
+        if (replaced != nullptr) {
+            replaced->clear();
+        }
     }
 
     void PrecomputeBufferContext::start()
     {
-        std::lock_guard<std::mutex> lock(getInstance()._mutex);
-        if (getInstance()._instance == nullptr) {
+        auto current = getCurrent();
+        if (current == nullptr) {
             throw std::runtime_error("PrecomputeBufferContext::start() called before "
                                      "PrecomputeBufferContext::initialize()");
         }
-        getInstance()._instance->start();
+        current->start();
     }
 
     void PrecomputeBufferContext::start(const ElementModP &elgamalPublicKey)
     {
-        std::lock_guard<std::mutex> lock(getInstance()._mutex);
-        if (getInstance()._instance == nullptr) {
-            getInstance()._instance = make_unique<PrecomputeBuffer>(elgamalPublicKey);
-        } else if (*getInstance()._instance->getPublicKey() != elgamalPublicKey) {
-            getInstance()._instance->clear();
-            getInstance()._instance = make_unique<PrecomputeBuffer>(elgamalPublicKey);
-        }
-        getInstance()._instance->start();
+        getOrCreate(elgamalPublicKey)->start();
     }
 
     void PrecomputeBufferContext::startAsync(const ElementModP &elgamalPublicKey)
     {
-        std::lock_guard<std::mutex> lock(getInstance()._mutex);
-        if (getInstance()._instance == nullptr) {
-            getInstance()._instance = make_unique<PrecomputeBuffer>(elgamalPublicKey);
-        } else if (*getInstance()._instance->getPublicKey() != elgamalPublicKey) {
-            getInstance()._instance->clear();
-            getInstance()._instance = make_unique<PrecomputeBuffer>(elgamalPublicKey);
-        }
-        getInstance()._instance->startAsync();
+        getOrCreate(elgamalPublicKey)->startAsync();
     }
 
     void PrecomputeBufferContext::stop()
     {
-        std::lock_guard<std::mutex> lock(getInstance()._mutex);
-        if (getInstance()._instance != nullptr) {
-            getInstance()._instance->stop();
+        std::vector<shared_ptr<PrecomputeBuffer>> buffers;
+        {
+            std::shared_lock<std::shared_mutex> lock(getInstance()._mutex);
+            for (auto &[key, buffer] : getInstance()._buffers) {
+                buffers.push_back(buffer);
+            }
         }
+        for (auto &buffer : buffers) {
+            buffer->stop();
+        }
+    }
+
+    void PrecomputeBufferContext::stop(const ElementModP &publicKey)
+    {
+        if (auto buffer = getBuffer(publicKey)) {
+            buffer->stop();
+        }
+    }
+
+    shared_ptr<PrecomputeBuffer> PrecomputeBufferContext::getBuffer(const ElementModP &publicKey)
+    {
+        auto key = makeKey(publicKey);
+        std::shared_lock<std::shared_mutex> lock(getInstance()._mutex);
+        auto &buffers = getInstance()._buffers;
+        auto found = buffers.find(key);
+        if (found == buffers.end()) {
+            return nullptr;
+        }
+        return found->second;
+    }
+
+    shared_ptr<PrecomputeBuffer>
+    PrecomputeBufferContext::getBuffer(const CiphertextElectionContext &context)
+    {
+        return getBuffer(context.getElGamalPublicKeyRef());
+    }
+
+    void PrecomputeBufferContext::save(const std::string &path)
+    {
+        auto current = getCurrent();
+        if (current == nullptr) {
+            throw std::runtime_error("PrecomputeBufferContext::save() called before "
+                                     "PrecomputeBufferContext::initialize()");
+        }
+        current->save(path);
+    }
+
+    void PrecomputeBufferContext::load(const std::string &path)
+    {
+        auto current = getCurrent();
+        if (current == nullptr) {
+            throw std::runtime_error("PrecomputeBufferContext::load() called before "
+                                     "PrecomputeBufferContext::initialize()");
+        }
+        current->load(path);
     }
 
     uint32_t PrecomputeBufferContext::getMaxQueueSize()
     {
-        return getInstance()._instance->getMaxQueueSize();
+        auto current = getCurrent();
+        return current != nullptr ? current->getMaxQueueSize() : 0;
     }
 
     uint32_t PrecomputeBufferContext::getCurrentQueueSize()
     {
-        return getInstance()._instance->getCurrentQueueSize();
+        auto current = getCurrent();
+        return current != nullptr ? current->getCurrentQueueSize() : 0;
     }
 
     std::unique_ptr<Triple> PrecomputeBufferContext::getTriple()
     {
-        if (getInstance()._instance != nullptr) {
-            return getInstance()._instance->getTriple();
+        if (auto current = getCurrent()) {
+            return current->getTriple();
         }
         return nullptr;
     }
 
     std::optional<std::unique_ptr<Triple>> PrecomputeBufferContext::popTriple()
     {
-        if (getInstance()._instance != nullptr) {
-            return getInstance()._instance->popTriple();
+        if (auto current = getCurrent()) {
+            return current->popTriple();
+        }
+        return std::nullopt;
+    }
+
+    std::optional<std::unique_ptr<Triple>>
+    PrecomputeBufferContext::popTriple(const ElementModP &publicKey)
+    {
+        if (auto buffer = getBuffer(publicKey)) {
+            return buffer->popTriple();
         }
         return std::nullopt;
     }
 
     std::unique_ptr<TwoTriplesAndAQuadruple> PrecomputeBufferContext::getTwoTriplesAndAQuadruple()
     {
-        if (getInstance()._instance != nullptr) {
-            return getInstance()._instance->getTwoTriplesAndAQuadruple();
+        if (auto current = getCurrent()) {
+            return current->getTwoTriplesAndAQuadruple();
         }
         return nullptr;
     }
@@ -445,13 +877,20 @@ namespace electionguard
     std::optional<std::unique_ptr<TwoTriplesAndAQuadruple>>
     PrecomputeBufferContext::popTwoTriplesAndAQuadruple()
     {
-        if (getInstance()._instance != nullptr) {
-            return getInstance()._instance->popTwoTriplesAndAQuadruple();
+        if (auto current = getCurrent()) {
+            return current->popTwoTriplesAndAQuadruple();
         }
         return std::nullopt;
     }
 
-    //std::mutex PrecomputeBufferContext::_lock;
+    std::optional<std::unique_ptr<TwoTriplesAndAQuadruple>>
+    PrecomputeBufferContext::popTwoTriplesAndAQuadruple(const ElementModP &publicKey)
+    {
+        if (auto buffer = getBuffer(publicKey)) {
+            return buffer->popTwoTriplesAndAQuadruple();
+        }
+        return std::nullopt;
+    }
 
 #pragma endregion
 
@@ -0,0 +1,487 @@
+#include "precompute_file.hpp"
+
+#include "../../libs/hacl/Lib.hpp"
+#include "electionguard/hash.hpp"
+#include "log.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+#ifdef _WIN32
+#    ifndef NOMINMAX
+#        define NOMINMAX
+#    endif
+#    include <windows.h>
+#    include <sddl.h>
+#else
+#    include <fcntl.h>
+#    include <sys/file.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+using hacl::Lib;
+using std::lock_guard;
+using std::make_unique;
+using std::mutex;
+using std::runtime_error;
+using std::string;
+using std::unique_ptr;
+using std::vector;
+
+namespace electionguard
+{
+    namespace
+    {
+        const char PRECOMPUTE_FILE_MAGIC[8] = {'E', 'G', 'P', 'R', 'E', 'C', 'M', 'P'};
+        const uint32_t PRECOMPUTE_FILE_VERSION = 1;
+
+        // the records start on their own page so the header can be flushed on its own
+        const uint64_t PRECOMPUTE_FILE_HEADER_SIZE = 4096;
+
+        // number of records reserved and flushed to disk at a time
+        const uint64_t PRECOMPUTE_FILE_RESERVATION_SIZE = 64;
+
+        struct PrecomputeFileHeader {
+            char magic[8];
+            uint32_t version;
+            uint32_t headerSize;
+            uint32_t tripleRecordSize;
+            uint32_t selectionRecordSize;
+            uint64_t tripleCount;
+            uint64_t quadCount;
+            uint64_t publicKeyHash[MAX_Q_LEN];
+            uint64_t tripleCursor;
+            uint64_t quadCursor;
+        };
+
+        static_assert(sizeof(PrecomputeFileHeader) <= PRECOMPUTE_FILE_HEADER_SIZE,
+                      "the header must fit in the header page");
+
+        /// the fields of the header that describe the layout of the records
+        PrecomputeFileHeader makeLayout()
+        {
+            PrecomputeFileHeader header = {};
+            memcpy(header.magic, PRECOMPUTE_FILE_MAGIC, sizeof(header.magic));
+            header.version = PRECOMPUTE_FILE_VERSION;
+            header.headerSize = static_cast<uint32_t>(PRECOMPUTE_FILE_HEADER_SIZE);
+            header.tripleRecordSize = sizeof(PrecomputedTripleRecord);
+            header.selectionRecordSize = sizeof(PrecomputedSelectionRecord);
+            return header;
+        }
+
+        PrecomputeFileHeader makeHeader(const ElementModP &publicKey, uint64_t tripleCount,
+                                        uint64_t quadCount)
+        {
+            auto header = makeLayout();
+            header.tripleCount = tripleCount;
+            header.quadCount = quadCount;
+            auto keyHash = hash_elems(std::cref(publicKey));
+            memcpy(header.publicKeyHash, keyHash->get(), sizeof(header.publicKeyHash));
+            return header;
+        }
+
+        /// <summary>
+        /// Check that a header read from a file of the given size describes records of
+        /// this build that fit in the file, with cursors that are within the records.
+        /// The header comes from disk so every size is checked for overflow.
+        /// </summary>
+        bool isCompatibleLayout(const PrecomputeFileHeader &header, uint64_t fileSize)
+        {
+            auto expected = makeLayout();
+            if (memcmp(header.magic, expected.magic, sizeof(expected.magic)) != 0 ||
+                header.version != expected.version || header.headerSize != expected.headerSize ||
+                header.tripleRecordSize != expected.tripleRecordSize ||
+                header.selectionRecordSize != expected.selectionRecordSize ||
+                header.tripleCursor > header.tripleCount || header.quadCursor > header.quadCount) {
+                return false;
+            }
+
+            auto available = fileSize - PRECOMPUTE_FILE_HEADER_SIZE;
+            if (header.tripleCount > available / sizeof(PrecomputedTripleRecord)) {
+                return false;
+            }
+            available -= header.tripleCount * sizeof(PrecomputedTripleRecord);
+            return header.quadCount <= available / sizeof(PrecomputedSelectionRecord);
+        }
+
+        /// <summary>
+        /// Create a new file that only the current user can read and write,
+        /// write the chunks to it and flush it to disk before returning.
+        /// The records hold the secret nonces of ballots that are not cast yet.
+        /// </summary>
+        void writeSecretFile(const string &path,
+                             std::initializer_list<std::pair<const void *, size_t>> chunks)
+        {
+#ifdef _WIN32
+            // owner only, and do not inherit the permissions of the directory
+            PSECURITY_DESCRIPTOR descriptor = nullptr;
+            if (!ConvertStringSecurityDescriptorToSecurityDescriptorA(
+                  "D:P(A;;FA;;;OW)", SDDL_REVISION_1, &descriptor, nullptr)) {
+                throw runtime_error("PrecomputeFile:: could not create " + path);
+            }
+            SECURITY_ATTRIBUTES attributes = {sizeof(SECURITY_ATTRIBUTES), descriptor, FALSE};
+            DeleteFileA(path.c_str());
+            auto file = CreateFileA(path.c_str(), GENERIC_WRITE, 0, &attributes, CREATE_NEW,
+                                    FILE_ATTRIBUTE_NORMAL, nullptr);
+            LocalFree(descriptor);
+            if (file == INVALID_HANDLE_VALUE) {
+                throw runtime_error("PrecomputeFile:: could not create " + path);
+            }
+            auto written = true;
+            for (const auto &[bytes, length] : chunks) {
+                auto *next = static_cast<const uint8_t *>(bytes);
+                auto remaining = length;
+                while (written && remaining > 0) {
+                    DWORD count = 0;
+                    auto request = static_cast<DWORD>(std::min<size_t>(remaining, MAXDWORD));
+                    written = WriteFile(file, next, request, &count, nullptr) != 0;
+                    next += count;
+                    remaining -= count;
+                }
+            }
+            written = written && FlushFileBuffers(file) != 0;
+            CloseHandle(file);
+#else
+            // a leftover from an interrupted write is replaced, O_EXCL refuses to
+            // follow anything put in its place before the new file is created
+            ::unlink(path.c_str());
+            auto descriptor = ::open(path.c_str(), O_CREAT | O_EXCL | O_WRONLY, S_IRUSR | S_IWUSR);
+            if (descriptor < 0) {
+                throw runtime_error("PrecomputeFile:: could not create " + path);
+            }
+            auto written = true;
+            for (const auto &[bytes, length] : chunks) {
+                auto *next = static_cast<const uint8_t *>(bytes);
+                auto remaining = length;
+                while (written && remaining > 0) {
+                    auto count = ::write(descriptor, next, remaining);
+                    if (count < 0 && errno == EINTR) {
+                        continue;
+                    }
+                    written = count > 0;
+                    if (written) {
+                        next += count;
+                        remaining -= static_cast<size_t>(count);
+                    }
+                }
+            }
+            written = written && ::fsync(descriptor) == 0;
+            written = ::close(descriptor) == 0 && written;
+#endif
+            if (!written) {
+                std::remove(path.c_str());
+                throw runtime_error("PrecomputeFile:: could not write " + path);
+            }
+        }
+    } // namespace
+
+#pragma region PrecomputeFile
+
+    class PrecomputeFile::Impl
+    {
+      public:
+        Impl() = default;
+        ~Impl()
+        {
+            if (data == nullptr) {
+                return;
+            }
+
+            // give back the records that were reserved but never handed out
+            if (isValid) {
+                if (header()->tripleCursor == tripleReservationEnd) {
+                    header()->tripleCursor = nextTriple;
+                }
+                if (header()->quadCursor == quadReservationEnd) {
+                    header()->quadCursor = nextQuad;
+                }
+                try {
+                    flush();
+                } catch (const std::exception &e) {
+                    Log::error("PrecomputeFile:: failed to release reserved records", e);
+                }
+            }
+            unmap();
+        }
+
+        void map(const string &path)
+        {
+#ifdef _WIN32
+            file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ,
+                               nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (file == INVALID_HANDLE_VALUE) {
+                throw runtime_error("PrecomputeFile:: could not open " + path);
+            }
+            // the cursor only guards against reuse within this process,
+            // so hold the whole file for as long as it is open
+            OVERLAPPED overlapped = {};
+            if (!LockFileEx(file, LOCKFILE_EXCLUSIVE_LOCK | LOCKFILE_FAIL_IMMEDIATELY, 0,
+                            MAXDWORD, MAXDWORD, &overlapped)) {
+                CloseHandle(file);
+                throw runtime_error("PrecomputeFile:: " + path + " is open in another process");
+            }
+            LARGE_INTEGER fileSize;
+            if (!GetFileSizeEx(file, &fileSize)) {
+                CloseHandle(file);
+                throw runtime_error("PrecomputeFile:: could not read the size of " + path);
+            }
+            size = static_cast<uint64_t>(fileSize.QuadPart);
+            if (size < PRECOMPUTE_FILE_HEADER_SIZE) {
+                CloseHandle(file);
+                throw runtime_error("PrecomputeFile:: " + path + " is not a precompute file");
+            }
+            PrecomputeFileHeader fileHeader = {};
+            DWORD headerBytes = 0;
+            if (!ReadFile(file, &fileHeader, sizeof(fileHeader), &headerBytes, nullptr) ||
+                headerBytes != sizeof(fileHeader) || !isCompatibleLayout(fileHeader, size)) {
+                CloseHandle(file);
+                throw runtime_error("PrecomputeFile:: " + path +
+                                    " is not a compatible precompute file");
+            }
+            mapping = CreateFileMappingA(file, nullptr, PAGE_READWRITE, 0, 0, nullptr);
+            if (mapping == nullptr) {
+                CloseHandle(file);
+                throw runtime_error("PrecomputeFile:: could not map " + path);
+            }
+            data = static_cast<uint8_t *>(MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, 0));
+            if (data == nullptr) {
+                CloseHandle(mapping);
+                CloseHandle(file);
+                throw runtime_error("PrecomputeFile:: could not map " + path);
+            }
+#else
+            descriptor = ::open(path.c_str(), O_RDWR);
+            if (descriptor < 0) {
+                throw runtime_error("PrecomputeFile:: could not open " + path);
+            }
+            // the cursor only guards against reuse within this process,
+            // so hold the whole file for as long as it is open
+            if (flock(descriptor, LOCK_EX | LOCK_NB) != 0) {
+                ::close(descriptor);
+                throw runtime_error("PrecomputeFile:: " + path + " is open in another process");
+            }
+            struct stat status;
+            if (fstat(descriptor, &status) != 0) {
+                ::close(descriptor);
+                throw runtime_error("PrecomputeFile:: could not read the size of " + path);
+            }
+            size = static_cast<uint64_t>(status.st_size);
+            if (size < PRECOMPUTE_FILE_HEADER_SIZE) {
+                ::close(descriptor);
+                throw runtime_error("PrecomputeFile:: " + path + " is not a precompute file");
+            }
+            PrecomputeFileHeader fileHeader = {};
+            if (pread(descriptor, &fileHeader, sizeof(fileHeader), 0) !=
+                  static_cast<ssize_t>(sizeof(fileHeader)) ||
+                !isCompatibleLayout(fileHeader, size)) {
+                ::close(descriptor);
+                throw runtime_error("PrecomputeFile:: " + path +
+                                    " is not a compatible precompute file");
+            }
+            auto *mapped = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+            if (mapped == MAP_FAILED) {
+                ::close(descriptor);
+                throw runtime_error("PrecomputeFile:: could not map " + path);
+            }
+            data = static_cast<uint8_t *>(mapped);
+#endif
+        }
+
+        void unmap()
+        {
+#ifdef _WIN32
+            UnmapViewOfFile(data);
+            CloseHandle(mapping);
+            CloseHandle(file);
+#else
+            munmap(data, size);
+            ::close(descriptor);
+#endif
+            data = nullptr;
+        }
+
+        /// <summary>
+        /// Write the consumption cursor and the records zeroed since the last flush to disk.
+        /// Only the dirty pages of the mapping are written.
+        /// </summary>
+        void flush()
+        {
+#ifdef _WIN32
+            if (!FlushViewOfFile(data, 0) || !FlushFileBuffers(file)) {
+                throw runtime_error("PrecomputeFile:: could not flush the consumption cursor");
+            }
+#else
+            if (msync(data, size, MS_SYNC) != 0) {
+                throw runtime_error("PrecomputeFile:: could not flush the consumption cursor");
+            }
+#endif
+        }
+
+        PrecomputeFileHeader *header() { return reinterpret_cast<PrecomputeFileHeader *>(data); }
+
+        PrecomputedTripleRecord *triples()
+        {
+            return reinterpret_cast<PrecomputedTripleRecord *>(data + PRECOMPUTE_FILE_HEADER_SIZE);
+        }
+
+        PrecomputedSelectionRecord *quads()
+        {
+            return reinterpret_cast<PrecomputedSelectionRecord *>(
+              data + PRECOMPUTE_FILE_HEADER_SIZE +
+              header()->tripleCount * sizeof(PrecomputedTripleRecord));
+        }
+
+        /// <summary>
+        /// Copy a record out of the mapping and zero it, so the nonces of the values
+        /// that were handed out do not stay readable on disk.
+        /// The zeroed pages are written with the next reservation or when the file is closed.
+        /// </summary>
+        template <typename T> static void take(T &cell, T &record)
+        {
+            record = cell;
+            Lib::memZero(&cell, sizeof(T));
+        }
+
+        /// <summary>
+        /// Reserve the next batch of records by advancing and flushing the
+        /// persisted cursor before any of them are handed out.
+        /// </summary>
+        bool reserve(uint64_t &cursor, uint64_t count, uint64_t &next, uint64_t &reservationEnd)
+        {
+            if (next < reservationEnd) {
+                return true;
+            }
+            auto start = std::max(cursor, reservationEnd);
+            if (start >= count) {
+                return false;
+            }
+            auto end = std::min(count, start + PRECOMPUTE_FILE_RESERVATION_SIZE);
+            cursor = end;
+            flush();
+            next = start;
+            reservationEnd = end;
+            return true;
+        }
+
+        mutex lock;
+        bool isValid = false;
+        uint8_t *data = nullptr;
+        uint64_t size = 0;
+        uint64_t nextTriple = 0;
+        uint64_t tripleReservationEnd = 0;
+        uint64_t nextQuad = 0;
+        uint64_t quadReservationEnd = 0;
+#ifdef _WIN32
+        HANDLE file = INVALID_HANDLE_VALUE;
+        HANDLE mapping = nullptr;
+#else
+        int descriptor = -1;
+#endif
+    };
+
+    PrecomputeFile::PrecomputeFile(unique_ptr<Impl> pimpl) : pimpl(move(pimpl)) {}
+    PrecomputeFile::~PrecomputeFile() = default;
+
+    void PrecomputeFile::write(const string &path, const ElementModP &publicKey,
+                               const vector<PrecomputedTripleRecord> &triples,
+                               const vector<PrecomputedSelectionRecord> &quads)
+    {
+        auto header = makeHeader(publicKey, triples.size(), quads.size());
+        vector<uint8_t> headerPage(PRECOMPUTE_FILE_HEADER_SIZE, 0);
+        memcpy(headerPage.data(), &header, sizeof(header));
+
+        // write next to the destination and rename so an existing pool,
+        // possibly still mapped by this process, is replaced atomically
+        auto temporaryPath = path + ".tmp";
+        writeSecretFile(temporaryPath,
+                        {{headerPage.data(), headerPage.size()},
+                         {triples.data(), triples.size() * sizeof(PrecomputedTripleRecord)},
+                         {quads.data(), quads.size() * sizeof(PrecomputedSelectionRecord)}});
+#ifdef _WIN32
+        auto renamed = MoveFileExA(temporaryPath.c_str(), path.c_str(),
+                                   MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+        auto renamed = std::rename(temporaryPath.c_str(), path.c_str()) == 0;
+#endif
+        if (!renamed) {
+            std::remove(temporaryPath.c_str());
+            throw runtime_error("PrecomputeFile:: could not replace " + path);
+        }
+
+        Log::debug("PrecomputeFile:: wrote " + std::to_string(triples.size()) + " triples and " +
+                   std::to_string(quads.size()) + " quadruples to " + path);
+    }
+
+    unique_ptr<PrecomputeFile> PrecomputeFile::open(const string &path,
+                                                    const ElementModP &publicKey)
+    {
+        // the layout of the header is checked before the file is mapped
+        auto pimpl = make_unique<Impl>();
+        pimpl->map(path);
+
+        auto *header = pimpl->header();
+        auto expected = makeHeader(publicKey, header->tripleCount, header->quadCount);
+        if (memcmp(header->publicKeyHash, expected.publicKeyHash,
+                   sizeof(expected.publicKeyHash)) != 0) {
+            throw std::invalid_argument("PrecomputeFile:: " + path +
+                                        " was generated for a different public key");
+        }
+
+        pimpl->isValid = true;
+        pimpl->nextTriple = pimpl->tripleReservationEnd = header->tripleCursor;
+        pimpl->nextQuad = pimpl->quadReservationEnd = header->quadCursor;
+        return unique_ptr<PrecomputeFile>(new PrecomputeFile(move(pimpl)));
+    }
+
+    bool PrecomputeFile::takeTriple(PrecomputedTripleRecord &record)
+    {
+        lock_guard<mutex> lock(pimpl->lock);
+        auto *header = pimpl->header();
+        if (!pimpl->reserve(header->tripleCursor, header->tripleCount, pimpl->nextTriple,
+                            pimpl->tripleReservationEnd)) {
+            return false;
+        }
+        Impl::take(pimpl->triples()[pimpl->nextTriple++], record);
+        return true;
+    }
+
+    bool PrecomputeFile::takeTwoTriplesAndAQuadruple(PrecomputedSelectionRecord &record)
+    {
+        lock_guard<mutex> lock(pimpl->lock);
+        auto *header = pimpl->header();
+        if (!pimpl->reserve(header->quadCursor, header->quadCount, pimpl->nextQuad,
+                            pimpl->quadReservationEnd)) {
+            return false;
+        }
+        Impl::take(pimpl->quads()[pimpl->nextQuad++], record);
+        return true;
+    }
+
+    uint64_t PrecomputeFile::getRemainingTripleCount()
+    {
+        lock_guard<mutex> lock(pimpl->lock);
+        auto *header = pimpl->header();
+        return (pimpl->tripleReservationEnd - pimpl->nextTriple) +
+               (header->tripleCount - std::max(header->tripleCursor, pimpl->tripleReservationEnd));
+    }
+
+    uint64_t PrecomputeFile::getRemainingQuadCount()
+    {
+        lock_guard<mutex> lock(pimpl->lock);
+        auto *header = pimpl->header();
+        return (pimpl->quadReservationEnd - pimpl->nextQuad) +
+               (header->quadCount - std::max(header->quadCursor, pimpl->quadReservationEnd));
+    }
+
+#pragma endregion
+
+} // namespace electionguard
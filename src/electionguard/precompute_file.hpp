@@ -0,0 +1,81 @@
+#ifndef __ELECTIONGUARD_CPP_PRECOMPUTE_FILE_HPP_INCLUDED__
+#define __ELECTIONGUARD_CPP_PRECOMPUTE_FILE_HPP_INCLUDED__
+
+#include <cstdint>
+#include <electionguard/export.h>
+#include <electionguard/group.hpp>
+#include <electionguard/precompute_buffers.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace electionguard
+{
+    /// <summary>
+    /// A pool of precomputed values persisted to disk.
+    ///
+    /// The file is a fixed size header followed by the raw triple records and
+    /// the raw two triples and a quadruple records. The header stores a hash of
+    /// the elgamal public key the values were generated for and a consumption
+    /// cursor for each record type.
+    ///
+    /// Opening the file memory maps it. Records are handed out in order and the
+    /// cursor is advanced and flushed to disk in batches before any record of
+    /// the batch is returned, so a record is never used twice even if the
+    /// process crashes. Records reserved but not handed out are returned to the
+    /// pool when the file is closed cleanly.
+    ///
+    /// The records hold the secret nonces of ballots that are not cast yet.
+    /// The file is created readable by its owner only, opening it takes an
+    /// exclusive lock that fails if another process has the file open, and each
+    /// record is zeroed in the file as it is handed out.
+    ///
+    /// The records are stored in host byte order.
+    /// </summary>
+    class EG_INTERNAL_API PrecomputeFile
+    {
+      public:
+        PrecomputeFile(const PrecomputeFile &other) = delete;
+        PrecomputeFile(PrecomputeFile &&other) = delete;
+        PrecomputeFile &operator=(const PrecomputeFile &) = delete;
+        PrecomputeFile &operator=(PrecomputeFile &&) = delete;
+        ~PrecomputeFile();
+
+        /// <summary>
+        /// Write the records to a new pool file, replacing any existing file at the path.
+        /// </summary>
+        static void write(const std::string &path, const ElementModP &publicKey,
+                          const std::vector<PrecomputedTripleRecord> &triples,
+                          const std::vector<PrecomputedSelectionRecord> &quads);
+
+        /// <summary>
+        /// Memory map an existing pool file and lock it until the returned file is destroyed.
+        /// Throws if the file is malformed, was generated for a different public key
+        /// or is already open.
+        /// </summary>
+        static std::unique_ptr<PrecomputeFile> open(const std::string &path,
+                                                    const ElementModP &publicKey);
+
+        /// <summary>
+        /// Take the next unused triple record.
+        /// <returns>false if the pool has no triples left</returns>
+        /// </summary>
+        bool takeTriple(PrecomputedTripleRecord &record);
+
+        /// <summary>
+        /// Take the next unused two triples and a quadruple record.
+        /// <returns>false if the pool has no quadruples left</returns>
+        /// </summary>
+        bool takeTwoTriplesAndAQuadruple(PrecomputedSelectionRecord &record);
+
+        uint64_t getRemainingTripleCount();
+        uint64_t getRemainingQuadCount();
+
+      private:
+        class Impl;
+        explicit PrecomputeFile(std::unique_ptr<Impl> pimpl);
+        std::unique_ptr<Impl> pimpl;
+    };
+} // namespace electionguard
+
+#endif /* __ELECTIONGUARD_CPP_PRECOMPUTE_FILE_HPP_INCLUDED__ */
@@ -5,6 +5,7 @@
 #include "convert.hpp"
 #include "log.hpp"
 
+#include <cstring>
 #include <ctime>
 #include <iomanip>
 #include <iostream>
@@ -97,4 +98,20 @@ namespace electionguard
             throw bad_alloc();
         }
     }
+
+    vector<uint64_t> Random::getBatchExponents(size_t count)
+    {
+        vector<uint64_t> exponents;
+        exponents.reserve(count);
+        while (exponents.size() < count) {
+            auto bytes = getBytes(SHA512);
+            for (size_t i = 0; i + sizeof(uint64_t) <= bytes.size() && exponents.size() < count;
+                 i += sizeof(uint64_t)) {
+                uint64_t exponent = 0;
+                memcpy(&exponent, &bytes[i], sizeof(uint64_t));
+                exponents.push_back(exponent | 1UL);
+            }
+        }
+        return exponents;
+    }
 } // namespace electionguard
@@ -1,6 +1,7 @@
 #ifndef __ELECTIONGUARD_CPP_RANDOM_HPP_INCLUDED__
 #define __ELECTIONGUARD_CPP_RANDOM_HPP_INCLUDED__
 
+#include <cstdint>
 #include <ctime>
 #include <electionguard/export.h>
 #include <iomanip>
@@ -49,6 +50,12 @@ namespace electionguard
         /// </summary>
         static vector<uint8_t> getBytes(ByteSize size = SHA256);
 
+        /// <summary>
+        /// Get pseudo-random 64-bit exponents to combine a batch of equations into one.
+        /// The exponents are odd so they are never zero.
+        /// </summary>
+        static vector<uint64_t> getBatchExponents(size_t count);
+
       private:
         Random() {}
     };
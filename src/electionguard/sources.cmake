@@ -8,6 +8,7 @@ set(FACADES_electionguard
     ${PROJECT_SOURCE_DIR}/src/electionguard/facades/bignum4096.cpp
     ${PROJECT_SOURCE_DIR}/src/electionguard/facades/bignum4096.hpp
     ${PROJECT_SOURCE_DIR}/src/electionguard/facades/chaum_pedersen.cpp
+    ${PROJECT_SOURCE_DIR}/src/electionguard/facades/decrypt.cpp
     ${PROJECT_SOURCE_DIR}/src/electionguard/facades/collections.c
     ${PROJECT_SOURCE_DIR}/src/electionguard/facades/discrete_log.cpp
     ${PROJECT_SOURCE_DIR}/src/electionguard/facades/election.cpp
@@ -19,6 +20,7 @@ set(FACADES_electionguard
     ${PROJECT_SOURCE_DIR}/src/electionguard/facades/nonces.cpp
     ${PROJECT_SOURCE_DIR}/src/electionguard/facades/polynomial.cpp
     ${PROJECT_SOURCE_DIR}/src/electionguard/facades/precompute_buffers.cpp
+    ${PROJECT_SOURCE_DIR}/src/electionguard/facades/tally.cpp
 )
 
 set(SOURCES_electionguard
@@ -27,6 +29,7 @@ set(SOURCES_electionguard
     ${PROJECT_SOURCE_DIR}/src/electionguard/ballot.cpp
     ${PROJECT_SOURCE_DIR}/src/electionguard/chaum_pedersen.cpp
     ${PROJECT_SOURCE_DIR}/src/electionguard/convert.cpp
+    ${PROJECT_SOURCE_DIR}/src/electionguard/decrypt.cpp
     ${PROJECT_SOURCE_DIR}/src/electionguard/discrete_log.cpp
     ${PROJECT_SOURCE_DIR}/src/electionguard/election.cpp
     ${PROJECT_SOURCE_DIR}/src/electionguard/elgamal.cpp
@@ -36,13 +39,17 @@ set(SOURCES_electionguard
     ${PROJECT_SOURCE_DIR}/src/electionguard/hmac.cpp
     ${PROJECT_SOURCE_DIR}/src/electionguard/log.hpp
     ${PROJECT_SOURCE_DIR}/src/electionguard/log.cpp
+    ${PROJECT_SOURCE_DIR}/src/electionguard/lookup_table.cpp
     ${PROJECT_SOURCE_DIR}/src/electionguard/lookup_table.hpp
     ${PROJECT_SOURCE_DIR}/src/electionguard/manifest.cpp
     ${PROJECT_SOURCE_DIR}/src/electionguard/nonces.cpp
     ${PROJECT_SOURCE_DIR}/src/electionguard/precompute_buffers.cpp
+    ${PROJECT_SOURCE_DIR}/src/electionguard/precompute_file.cpp
+    ${PROJECT_SOURCE_DIR}/src/electionguard/precompute_file.hpp
     ${PROJECT_SOURCE_DIR}/src/electionguard/convert.hpp
     ${PROJECT_SOURCE_DIR}/src/electionguard/random.cpp
     ${PROJECT_SOURCE_DIR}/src/electionguard/random.hpp
+    ${PROJECT_SOURCE_DIR}/src/electionguard/tally.cpp
     ${PROJECT_SOURCE_DIR}/src/electionguard/utils.hpp
     ${PROJECT_SOURCE_DIR}/src/electionguard/variant_cast.hpp
 )
@@ -57,6 +64,7 @@ set(INCLUDES_electionguard_h
     ${PROJECT_SOURCE_DIR}/include/electionguard/chaum_pedersen.h
     ${PROJECT_SOURCE_DIR}/include/electionguard/constants.h
     ${PROJECT_SOURCE_DIR}/include/electionguard/collections.h
+    ${PROJECT_SOURCE_DIR}/include/electionguard/decrypt.h
     ${PROJECT_SOURCE_DIR}/include/electionguard/discrete_log.h
     ${PROJECT_SOURCE_DIR}/include/electionguard/election.h
     ${PROJECT_SOURCE_DIR}/include/electionguard/elgamal.h
@@ -69,6 +77,7 @@ set(INCLUDES_electionguard_h
     ${PROJECT_SOURCE_DIR}/include/electionguard/polynomial.h
     ${PROJECT_SOURCE_DIR}/include/electionguard/precompute_buffers.h
     ${PROJECT_SOURCE_DIR}/include/electionguard/status.h
+    ${PROJECT_SOURCE_DIR}/include/electionguard/tally.h
 )
 
 set(INCLUDES_electionguard_hpp
@@ -78,6 +87,7 @@ set(INCLUDES_electionguard_hpp
     ${PROJECT_SOURCE_DIR}/include/electionguard/ballot.hpp
     ${PROJECT_SOURCE_DIR}/include/electionguard/chaum_pedersen.hpp
     ${PROJECT_SOURCE_DIR}/include/electionguard/crypto_hashable.hpp
+    ${PROJECT_SOURCE_DIR}/include/electionguard/decrypt.hpp
     ${PROJECT_SOURCE_DIR}/include/electionguard/discrete_log.hpp
     ${PROJECT_SOURCE_DIR}/include/electionguard/election_object_base.hpp
     ${PROJECT_SOURCE_DIR}/include/electionguard/election.hpp
@@ -89,4 +99,5 @@ set(INCLUDES_electionguard_hpp
     ${PROJECT_SOURCE_DIR}/include/electionguard/nonces.hpp
     ${PROJECT_SOURCE_DIR}/include/electionguard/precompute_buffers.hpp
     ${PROJECT_SOURCE_DIR}/include/electionguard/polynomial.hpp
+    ${PROJECT_SOURCE_DIR}/include/electionguard/tally.hpp
 )
@@ -0,0 +1,1260 @@
+#include "electionguard/tally.hpp"
+
+#include "electionguard/async.hpp"
+#include "facades/bignum4096.hpp"
+#include "log.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+using electionguard::facades::CONTEXT_P;
+using nlohmann::json;
+using std::future;
+using std::invalid_argument;
+using std::lock_guard;
+using std::make_unique;
+using std::move;
+using std::mutex;
+using std::pair;
+using std::reference_wrapper;
+using std::runtime_error;
+using std::string;
+using std::unique_ptr;
+using std::unordered_map;
+using std::unordered_set;
+using std::vector;
+
+namespace electionguard
+{
+#pragma region CiphertextTallySelection
+
+    class CiphertextTallySelection::Impl
+    {
+      public:
+        string objectId;
+        string contestId;
+        uint64_t sequenceOrder;
+        unique_ptr<ElementModQ> descriptionHash;
+        unique_ptr<ElGamalCiphertext> ciphertext;
+
+        Impl(const string &objectId, const string &contestId, uint64_t sequenceOrder,
+             unique_ptr<ElementModQ> descriptionHash, unique_ptr<ElGamalCiphertext> ciphertext)
+            : objectId(objectId), contestId(contestId), sequenceOrder(sequenceOrder),
+              descriptionHash(move(descriptionHash)), ciphertext(move(ciphertext))
+        {
+        }
+
+        [[nodiscard]] unique_ptr<CiphertextTallySelection::Impl> clone() const
+        {
+            return make_unique<CiphertextTallySelection::Impl>(
+              objectId, contestId, sequenceOrder, descriptionHash->clone(), ciphertext->clone());
+        }
+    };
+
+    // Lifecycle Methods
+
+    CiphertextTallySelection::CiphertextTallySelection(const CiphertextTallySelection &other)
+        : pimpl(other.pimpl->clone())
+    {
+    }
+
+    CiphertextTallySelection::CiphertextTallySelection(CiphertextTallySelection &&other)
+        : pimpl(move(other.pimpl))
+    {
+    }
+
+    CiphertextTallySelection::CiphertextTallySelection(const string &objectId,
+                                                       const string &contestId,
+                                                       uint64_t sequenceOrder,
+                                                       const ElementModQ &descriptionHash,
+                                                       unique_ptr<ElGamalCiphertext> ciphertext)
+        : pimpl(new Impl(objectId, contestId, sequenceOrder, descriptionHash.clone(),
+                         move(ciphertext)))
+    {
+    }
+
+    CiphertextTallySelection::~CiphertextTallySelection() = default;
+
+    // Operator Overloads
+
+    CiphertextTallySelection &CiphertextTallySelection::operator=(CiphertextTallySelection other)
+    {
+        swap(pimpl, other.pimpl);
+        return *this;
+    }
+
+    CiphertextTallySelection &CiphertextTallySelection::operator=(CiphertextTallySelection &&other)
+    {
+        swap(pimpl, other.pimpl);
+        return *this;
+    }
+
+    // Property Getters
+
+    string CiphertextTallySelection::getObjectId() const { return pimpl->objectId; }
+    string CiphertextTallySelection::getContestId() const { return pimpl->contestId; }
+    uint64_t CiphertextTallySelection::getSequenceOrder() const { return pimpl->sequenceOrder; }
+    ElementModQ *CiphertextTallySelection::getDescriptionHash() const
+    {
+        return pimpl->descriptionHash.get();
+    }
+    ElGamalCiphertext *CiphertextTallySelection::getCiphertext() const
+    {
+        return pimpl->ciphertext.get();
+    }
+
+#pragma endregion
+
+#pragma region CiphertextTally
+
+    /// <summary>
+    /// The montgomery form of one, which is R mod p, as a plain element
+    /// </summary>
+    static const ElementModP &MONTGOMERY_R()
+    {
+        static const ElementModP instance = []() {
+            MontgomeryElementModP one;
+            uint64_t limbs[MAX_P_LEN] = {};
+            memcpy(static_cast<uint64_t *>(limbs), one.get(), MAX_P_SIZE);
+            return ElementModP(limbs, true);
+        }();
+        return instance;
+    }
+
+    /// <summary>
+    /// A running product of ciphertext elements.
+    ///
+    /// Each element is folded in with a single montgomery multiplication by
+    /// treating its plain limbs as if they were already in montgomery form.
+    /// That leaves a factor of R^-1 per element in the product, which is
+    /// removed once with a single exponentiation when the total is read,
+    /// instead of converting every element into montgomery form.
+    /// </summary>
+    struct MontgomeryProduct {
+        MontgomeryElementModP value;
+        uint64_t count = 0;
+
+        void multiply(const ElementModP &element)
+        {
+            uint64_t product[MAX_P_LEN] = {};
+            CONTEXT_P().montgomery_mod_mul_stay_in_mont_form(
+              value.get(), const_cast<uint64_t *>(element.get()), static_cast<uint64_t *>(product));
+            memcpy(value.get(), static_cast<uint64_t *>(product), MAX_P_SIZE);
+            count++;
+        }
+
+        void multiply(const MontgomeryProduct &other)
+        {
+            value *= other.value;
+            count += other.count;
+        }
+
+        [[nodiscard]] unique_ptr<ElementModP> toElementModP() const
+        {
+            auto product = value.toElementModP();
+            if (count == 0) {
+                return product;
+            }
+            // the count is an integer exponent rather than an element of the group
+            auto exponent = ElementModQ::fromUint64(count, true);
+            return mul_mod_p(*product, *pow_mod_p(MONTGOMERY_R(), *exponent));
+        }
+    };
+
+    /// <summary>
+    /// The running pad and data products of every selection in the tally
+    /// </summary>
+    struct TallyTotals {
+        vector<MontgomeryProduct> pads;
+        vector<MontgomeryProduct> data;
+
+        explicit TallyTotals(size_t size) : pads(size), data(size) {}
+
+        void multiply(size_t index, const ElGamalCiphertext &ciphertext)
+        {
+            pads[index].multiply(*ciphertext.getPad());
+            data[index].multiply(*ciphertext.getData());
+        }
+
+        void multiply(const TallyTotals &other)
+        {
+            for (size_t i = 0; i < pads.size(); i++) {
+                pads[i].multiply(other.pads[i]);
+                data[i].multiply(other.data[i]);
+            }
+        }
+    };
+
+    // the fewest ballots worth handing to a separate task
+    static const size_t MIN_BALLOTS_PER_TASK = 8;
+
+#pragma region Ballot Streams
+
+    /// <summary>
+    /// The fields of a serialized ballot selection that are needed to accumulate it
+    /// </summary>
+    class StreamedSelection
+    {
+      public:
+        string objectId;
+        bool isPlaceholder = false;
+        unique_ptr<ElementModQ> descriptionHash;
+        unique_ptr<ElementModP> pad;
+        unique_ptr<ElementModP> data;
+        unique_ptr<ElGamalCiphertext> ciphertext;
+
+        [[nodiscard]] const string &getObjectId() const { return objectId; }
+        [[nodiscard]] bool getIsPlaceholder() const { return isPlaceholder; }
+        [[nodiscard]] ElementModQ *getDescriptionHash() const { return descriptionHash.get(); }
+        [[nodiscard]] ElGamalCiphertext *getCiphertext() const { return ciphertext.get(); }
+    };
+
+    /// <summary>
+    /// The fields of a serialized ballot contest that are needed to accumulate it
+    /// </summary>
+    class StreamedContest
+    {
+      public:
+        string objectId;
+        vector<StreamedSelection> selections;
+
+        [[nodiscard]] const string &getObjectId() const { return objectId; }
+        [[nodiscard]] const vector<StreamedSelection> &getSelections() const { return selections; }
+    };
+
+    /// <summary>
+    /// The fields of a serialized ballot that are needed to accumulate it
+    /// </summary>
+    class StreamedBallot
+    {
+      public:
+        string objectId;
+        BallotBoxState state = BallotBoxState::unknown;
+        vector<StreamedContest> contests;
+
+        [[nodiscard]] const string &getObjectId() const { return objectId; }
+        [[nodiscard]] BallotBoxState getState() const { return state; }
+        [[nodiscard]] const vector<StreamedContest> &getContests() const { return contests; }
+    };
+
+    template <typename T> static const T &deref(const reference_wrapper<T> &value)
+    {
+        return value.get();
+    }
+    template <typename T> static const T &deref(const T &value) { return value; }
+
+    /// <summary>
+    /// Decode big endian hex into little endian limbs, skipping the
+    /// intermediate strings and byte vectors of fromHex
+    /// <returns>false if the value is not hex or does not fit</returns>
+    /// </summary>
+    template <size_t L> static bool hexToLimbs(const string &hex, uint64_t (&limbs)[L])
+    {
+        memset(static_cast<uint64_t *>(limbs), 0, sizeof(limbs));
+        size_t limb = 0;
+        uint32_t shift = 0;
+        for (auto it = hex.rbegin(); it != hex.rend(); it++) {
+            uint64_t digit = 0;
+            if (*it >= '0' && *it <= '9') {
+                digit = static_cast<uint64_t>(*it - '0');
+            } else if (*it >= 'A' && *it <= 'F') {
+                digit = static_cast<uint64_t>(*it - 'A' + 10);
+            } else if (*it >= 'a' && *it <= 'f') {
+                digit = static_cast<uint64_t>(*it - 'a' + 10);
+            } else {
+                return false;
+            }
+
+            if (digit != 0) {
+                if (limb >= L) {
+                    return false;
+                }
+                limbs[limb] |= digit << shift;
+            }
+
+            shift += 4;
+            if (shift == 64) {
+                shift = 0;
+                limb++;
+            }
+        }
+        return true;
+    }
+
+    template <typename T, size_t L> static unique_ptr<T> elementFromHex(const string &hex)
+    {
+        uint64_t limbs[L];
+        if (!hexToLimbs(hex, limbs)) {
+            throw invalid_argument("CiphertextTally: invalid hex value");
+        }
+        return make_unique<T>(limbs);
+    }
+
+    /// <summary>
+    /// Reads a serialized ballot as it is parsed and keeps only the fields
+    /// needed to accumulate it, without building a json document.
+    /// The proofs, hashes and contest accumulations are skipped.
+    /// </summary>
+    class StreamedBallotParser : public nlohmann::json_sax<json>
+    {
+      public:
+        explicit StreamedBallotParser(StreamedBallot &ballot) : ballot(ballot) {}
+
+        bool null() override { return true; }
+
+        bool boolean(bool value) override
+        {
+            if (scope() == Scope::Selection && lastKey == "is_placeholder_selection") {
+                ballot.contests.back().selections.back().isPlaceholder = value;
+            }
+            return true;
+        }
+
+        bool number_integer(number_integer_t value) override
+        {
+            return value < 0 || number_unsigned(static_cast<number_unsigned_t>(value));
+        }
+
+        bool number_unsigned(number_unsigned_t value) override
+        {
+            if (scope() == Scope::Ballot && lastKey == "state") {
+                ballot.state = static_cast<BallotBoxState>(value);
+            }
+            return true;
+        }
+
+        bool number_float(number_float_t /* value */, const string_t & /* text */) override
+        {
+            return true;
+        }
+
+        bool string(string_t &value) override
+        {
+            switch (scope()) {
+                case Scope::Ballot:
+                    if (lastKey == "object_id") {
+                        ballot.objectId = move(value);
+                    }
+                    break;
+                case Scope::Contest:
+                    if (lastKey == "object_id") {
+                        ballot.contests.back().objectId = move(value);
+                    }
+                    break;
+                case Scope::Selection: {
+                    auto &selection = ballot.contests.back().selections.back();
+                    if (lastKey == "object_id") {
+                        selection.objectId = move(value);
+                    } else if (lastKey == "description_hash") {
+                        selection.descriptionHash = elementFromHex<ElementModQ, MAX_Q_LEN>(value);
+                    }
+                    break;
+                }
+                case Scope::Ciphertext: {
+                    auto &selection = ballot.contests.back().selections.back();
+                    if (lastKey == "pad") {
+                        selection.pad = elementFromHex<ElementModP, MAX_P_LEN>(value);
+                    } else if (lastKey == "data") {
+                        selection.data = elementFromHex<ElementModP, MAX_P_LEN>(value);
+                    }
+                    break;
+                }
+                default:
+                    break;
+            }
+            return true;
+        }
+
+        bool binary(binary_t & /* value */) override { return true; }
+
+        bool start_object(std::size_t /* elements */) override
+        {
+            auto current = scope();
+            if (current == Scope::Root) {
+                scopes.push_back(Scope::Ballot);
+            } else if (current == Scope::Contests) {
+                ballot.contests.emplace_back();
+                scopes.push_back(Scope::Contest);
+            } else if (current == Scope::Selections) {
+                ballot.contests.back().selections.emplace_back();
+                scopes.push_back(Scope::Selection);
+            } else if (current == Scope::Selection && lastKey == "ciphertext") {
+                scopes.push_back(Scope::Ciphertext);
+            } else {
+                scopes.push_back(Scope::Skip);
+            }
+            return true;
+        }
+
+        bool end_object() override
+        {
+            if (scope() == Scope::Selection) {
+                auto &selection = ballot.contests.back().selections.back();
+                if (selection.pad != nullptr && selection.data != nullptr) {
+                    selection.ciphertext =
+                      make_unique<ElGamalCiphertext>(move(selection.pad), move(selection.data));
+                }
+            }
+            scopes.pop_back();
+            return true;
+        }
+
+        bool start_array(std::size_t /* elements */) override
+        {
+            auto current = scope();
+            if (current == Scope::Ballot && lastKey == "contests") {
+                scopes.push_back(Scope::Contests);
+            } else if (current == Scope::Contest && lastKey == "ballot_selections") {
+                scopes.push_back(Scope::Selections);
+            } else {
+                scopes.push_back(Scope::Skip);
+            }
+            return true;
+        }
+
+        bool end_array() override
+        {
+            scopes.pop_back();
+            return true;
+        }
+
+        bool key(string_t &value) override
+        {
+            lastKey = move(value);
+            return true;
+        }
+
+        bool parse_error(std::size_t /* position */, const std::string & /* token */,
+                         const nlohmann::detail::exception &e) override
+        {
+            throw invalid_argument(e.what());
+        }
+
+      private:
+        enum class Scope {
+            Root,
+            Ballot,
+            Contests,
+            Contest,
+            Selections,
+            Selection,
+            Ciphertext,
+            Skip
+        };
+
+        [[nodiscard]] Scope scope() const { return scopes.empty() ? Scope::Root : scopes.back(); }
+
+        StreamedBallot &ballot;
+        vector<Scope> scopes;
+        std::string lastKey;
+    };
+
+    /// <summary>
+    /// A serialized ballot waiting to be parsed
+    /// </summary>
+    struct BallotRecord {
+        std::string bytes;
+        bool isMsgPack = false;
+    };
+
+    /// <summary>
+    /// A queue between the reader and the parsers that holds at most a fixed
+    /// number of bytes of ballot data. A record larger than the limit is
+    /// only let through once the queue is empty.
+    /// </summary>
+    class BallotRecordQueue
+    {
+      public:
+        explicit BallotRecordQueue(uint64_t maxBytes) : maxBytes(maxBytes) {}
+
+        uint64_t getMaxBytes() const { return maxBytes; }
+
+        /// <summary>
+        /// Wait for room and add a record.
+        /// <returns>false if the queue was closed and the record was dropped</returns>
+        /// </summary>
+        bool push(BallotRecord record)
+        {
+            std::unique_lock<mutex> guard(lock);
+            notFull.wait(guard, [this, &record]() {
+                return closed || bytes == 0 || bytes + record.bytes.size() <= maxBytes;
+            });
+            if (closed) {
+                return false;
+            }
+            bytes += record.bytes.size();
+            records.push_back(move(record));
+            notEmpty.notify_one();
+            return true;
+        }
+
+        /// <summary>
+        /// Wait for a record.
+        /// <returns>false once the queue is closed and empty</returns>
+        /// </summary>
+        bool pop(BallotRecord &record)
+        {
+            std::unique_lock<mutex> guard(lock);
+            notEmpty.wait(guard, [this]() { return closed || !records.empty(); });
+            if (records.empty()) {
+                return false;
+            }
+            record = move(records.front());
+            records.pop_front();
+            bytes -= record.bytes.size();
+            notFull.notify_one();
+            return true;
+        }
+
+        /// <summary>
+        /// Stop accepting records. The records already queued can still be popped.
+        /// </summary>
+        void close()
+        {
+            lock_guard<mutex> guard(lock);
+            closed = true;
+            notFull.notify_all();
+            notEmpty.notify_all();
+        }
+
+      private:
+        uint64_t maxBytes;
+        uint64_t bytes = 0;
+        bool closed = false;
+        std::deque<BallotRecord> records;
+        mutex lock;
+        std::condition_variable notFull;
+        std::condition_variable notEmpty;
+    };
+
+    static void readMsgPackBytes(std::istream &stream, std::string &out, uint64_t count,
+                                 uint64_t maxBytes)
+    {
+        // the lengths come from the input, so check them before allocating anything
+        auto start = out.size();
+        if (count > maxBytes || start > maxBytes - count) {
+            throw invalid_argument("CiphertextTally: msgpack value is larger than the buffer");
+        }
+        out.resize(start + count);
+        if (count > 0 && !stream.read(&out[start], static_cast<std::streamsize>(count))) {
+            throw invalid_argument("CiphertextTally: truncated msgpack value");
+        }
+    }
+
+    static uint64_t readMsgPackLength(std::istream &stream, std::string &out, uint32_t size,
+                                      uint64_t maxBytes)
+    {
+        auto start = out.size();
+        readMsgPackBytes(stream, out, size, maxBytes);
+        uint64_t length = 0;
+        for (uint32_t i = 0; i < size; i++) {
+            length = (length << 8) | static_cast<uint8_t>(out[start + i]);
+        }
+        return length;
+    }
+
+    /// <summary>
+    /// Copy the bytes of the next msgpack value in a stream, so the stream can be
+    /// split into ballots without parsing them.
+    /// Throws if the value is longer than `maxBytes`.
+    /// <returns>false if the stream ended before the value</returns>
+    /// </summary>
+    static bool readMsgPackValue(std::istream &stream, std::string &out, uint64_t maxBytes)
+    {
+        out.clear();
+        uint64_t remaining = 1;
+        while (remaining > 0) {
+            auto next = stream.get();
+            if (next == std::char_traits<char>::eof()) {
+                if (out.empty()) {
+                    return false;
+                }
+                throw invalid_argument("CiphertextTally: truncated msgpack value");
+            }
+            remaining--;
+
+            auto type = static_cast<uint8_t>(next);
+            if (out.size() >= maxBytes) {
+                throw invalid_argument("CiphertextTally: msgpack value is larger than the buffer");
+            }
+            out.push_back(static_cast<char>(type));
+            if (type <= 0x7F || type >= 0xE0 || type == 0xC0 || type == 0xC2 || type == 0xC3) {
+                // fixint, nil and bool have no payload
+            } else if (type <= 0x8F) {
+                remaining += 2 * static_cast<uint64_t>(type & 0x0F);
+            } else if (type <= 0x9F) {
+                remaining += type & 0x0F;
+            } else if (type <= 0xBF) {
+                readMsgPackBytes(stream, out, type & 0x1F, maxBytes);
+            } else {
+                switch (type) {
+                    case 0xC4: // bin 8
+                    case 0xD9: // str 8
+                        readMsgPackBytes(stream, out, readMsgPackLength(stream, out, 1, maxBytes),
+                                         maxBytes);
+                        break;
+                    case 0xC5: // bin 16
+                    case 0xDA: // str 16
+                        readMsgPackBytes(stream, out, readMsgPackLength(stream, out, 2, maxBytes),
+                                         maxBytes);
+                        break;
+                    case 0xC6: // bin 32
+                    case 0xDB: // str 32
+                        readMsgPackBytes(stream, out, readMsgPackLength(stream, out, 4, maxBytes),
+                                         maxBytes);
+                        break;
+                    case 0xC7: // ext 8
+                        readMsgPackBytes(
+                          stream, out, readMsgPackLength(stream, out, 1, maxBytes) + 1, maxBytes);
+                        break;
+                    case 0xC8: // ext 16
+                        readMsgPackBytes(
+                          stream, out, readMsgPackLength(stream, out, 2, maxBytes) + 1, maxBytes);
+                        break;
+                    case 0xC9: // ext 32
+                        readMsgPackBytes(
+                          stream, out, readMsgPackLength(stream, out, 4, maxBytes) + 1, maxBytes);
+                        break;
+                    case 0xCC: // uint 8
+                    case 0xD0: // int 8
+                        readMsgPackBytes(stream, out, 1, maxBytes);
+                        break;
+                    case 0xCD: // uint 16
+                    case 0xD1: // int 16
+                        readMsgPackBytes(stream, out, 2, maxBytes);
+                        break;
+                    case 0xCA: // float 32
+                    case 0xCE: // uint 32
+                    case 0xD2: // int 32
+                        readMsgPackBytes(stream, out, 4, maxBytes);
+                        break;
+                    case 0xCB: // float 64
+                    case 0xCF: // uint 64
+                    case 0xD3: // int 64
+                        readMsgPackBytes(stream, out, 8, maxBytes);
+                        break;
+                    case 0xD4: // fixext 1
+                    case 0xD5: // fixext 2
+                    case 0xD6: // fixext 4
+                    case 0xD7: // fixext 8
+                    case 0xD8: // fixext 16
+                        readMsgPackBytes(stream, out, (1ULL << (type - 0xD4)) + 1, maxBytes);
+                        break;
+                    case 0xDC: // array 16
+                        remaining += readMsgPackLength(stream, out, 2, maxBytes);
+                        break;
+                    case 0xDD: // array 32
+                        remaining += readMsgPackLength(stream, out, 4, maxBytes);
+                        break;
+                    case 0xDE: // map 16
+                        remaining += 2 * readMsgPackLength(stream, out, 2, maxBytes);
+                        break;
+                    case 0xDF: // map 32
+                        remaining += 2 * readMsgPackLength(stream, out, 4, maxBytes);
+                        break;
+                    default:
+                        throw invalid_argument("CiphertextTally: invalid msgpack type");
+                }
+            }
+        }
+        return true;
+    }
+
+    /// <returns>false if the queue was closed</returns>
+    static bool readJsonLines(std::istream &stream, BallotRecordQueue &queue)
+    {
+        std::string line;
+        while (std::getline(stream, line)) {
+            if (line.find_first_not_of(" \t\r") == std::string::npos) {
+                continue;
+            }
+            if (!queue.push({move(line), false})) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// <returns>false if the queue was closed</returns>
+    static bool readMsgPack(std::istream &stream, BallotRecordQueue &queue)
+    {
+        BallotRecord record{{}, true};
+        while (readMsgPackValue(stream, record.bytes, queue.getMaxBytes())) {
+            if (!queue.push(move(record))) {
+                return false;
+            }
+            record = {{}, true};
+        }
+        return true;
+    }
+
+    /// <summary>
+    /// Read a ballot file by its extension: a single json ballot (.json),
+    /// newline delimited json ballots (.jsonl, .ndjson) or a stream of
+    /// msgpack ballots (.msgpack, .mpk). Other files are ignored.
+    /// <returns>false if the queue was closed</returns>
+    /// </summary>
+    static bool readBallotFile(const std::filesystem::path &path, BallotRecordQueue &queue)
+    {
+        auto extension = path.extension().string();
+        transform(extension.begin(), extension.end(), extension.begin(),
+                  [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        if (extension != ".json" && extension != ".jsonl" && extension != ".ndjson" &&
+            extension != ".msgpack" && extension != ".mpk") {
+            return true;
+        }
+
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            throw runtime_error("CiphertextTally: could not open " + path.string());
+        }
+
+        if (extension == ".json") {
+            std::string bytes((std::istreambuf_iterator<char>(file)),
+                              std::istreambuf_iterator<char>());
+            return queue.push({move(bytes), false});
+        }
+        if (extension == ".msgpack" || extension == ".mpk") {
+            return readMsgPack(file, queue);
+        }
+        return readJsonLines(file, queue);
+    }
+
+    static void readBallotFiles(const std::string &path, BallotRecordQueue &queue)
+    {
+        if (!std::filesystem::is_directory(path)) {
+            readBallotFile(path, queue);
+            return;
+        }
+
+        vector<std::filesystem::path> files;
+        for (const auto &entry : std::filesystem::directory_iterator(path)) {
+            if (entry.is_regular_file()) {
+                files.push_back(entry.path());
+            }
+        }
+        sort(files.begin(), files.end());
+
+        for (const auto &file : files) {
+            if (!readBallotFile(file, queue)) {
+                return;
+            }
+        }
+    }
+
+#pragma endregion
+
+    static bool isTallyState(BallotBoxState state)
+    {
+        return state == BallotBoxState::cast || state == BallotBoxState::challenged ||
+               state == BallotBoxState::spoiled;
+    }
+
+    class CiphertextTally::Impl
+    {
+      public:
+        struct Selection {
+            string objectId;
+            string contestId;
+            uint64_t sequenceOrder;
+            unique_ptr<ElementModQ> descriptionHash;
+        };
+
+        struct Contest {
+            // the selections of a contest occupy [first, first + count) in the totals
+            size_t first;
+            size_t count;
+            unordered_map<string, size_t> selections;
+        };
+
+        // the totals index and ciphertext of each selection on a ballot
+        typedef vector<pair<size_t, const ElGamalCiphertext *>> ResolvedSelections;
+
+        string objectId;
+        ElementModQ manifestHash;
+        ElementModP elgamalPublicKey;
+        ElementModQ cryptoExtendedBaseHash;
+
+        vector<Selection> selections;
+        unordered_map<string, Contest> contests;
+        TallyTotals totals;
+
+        unordered_set<string> castBallotIds;
+        unordered_set<string> challengedBallotIds;
+        unordered_set<string> spoiledBallotIds;
+
+        mutable mutex lock;
+
+        Impl(const string &objectId, const InternalManifest &manifest,
+             const CiphertextElectionContext &context)
+            : objectId(objectId), manifestHash(*context.getManifestHash()),
+              elgamalPublicKey(*context.getElGamalPublicKey()),
+              cryptoExtendedBaseHash(*context.getCryptoExtendedBaseHash()), totals(0)
+        {
+            auto descriptions = manifest.getContests();
+            stable_sort(descriptions.begin(), descriptions.end(),
+                        [](const reference_wrapper<ContestDescriptionWithPlaceholders> left,
+                           const reference_wrapper<ContestDescriptionWithPlaceholders> right) {
+                            return left.get().getSequenceOrder() < right.get().getSequenceOrder();
+                        });
+
+            for (const auto &description : descriptions) {
+                auto selectionDescriptions = description.get().getSelections();
+                stable_sort(selectionDescriptions.begin(), selectionDescriptions.end(),
+                            [](const reference_wrapper<SelectionDescription> left,
+                               const reference_wrapper<SelectionDescription> right) {
+                                return left.get().getSequenceOrder() <
+                                       right.get().getSequenceOrder();
+                            });
+
+                Contest contest{selections.size(), 0, {}};
+                for (const auto &selection : selectionDescriptions) {
+                    contest.selections.emplace(selection.get().getObjectId(), selections.size());
+                    selections.push_back({selection.get().getObjectId(),
+                                          description.get().getObjectId(),
+                                          selection.get().getSequenceOrder(),
+                                          selection.get().crypto_hash()});
+                }
+                contest.count = selections.size() - contest.first;
+                contests.emplace(description.get().getObjectId(), move(contest));
+            }
+            totals = TallyTotals(selections.size());
+        }
+
+        bool hasBallot(const string &ballotId) const
+        {
+            return castBallotIds.count(ballotId) > 0 || challengedBallotIds.count(ballotId) > 0 ||
+                   spoiledBallotIds.count(ballotId) > 0;
+        }
+
+        void addBallotId(const string &ballotId, BallotBoxState state)
+        {
+            switch (state) {
+                case BallotBoxState::cast:
+                    castBallotIds.insert(ballotId);
+                    break;
+                case BallotBoxState::challenged:
+                    challengedBallotIds.insert(ballotId);
+                    break;
+                default:
+                    spoiledBallotIds.insert(ballotId);
+                    break;
+            }
+        }
+
+        /// <summary>
+        /// Find the totals index of every selection on a cast ballot.
+        /// Works with both a `CiphertextBallot` and a `StreamedBallot`.
+        /// <returns>false if the ballot does not match the manifest</returns>
+        /// </summary>
+        template <typename Ballot>
+        bool resolve(const Ballot &ballot, ResolvedSelections &resolved) const
+        {
+            resolved.clear();
+            for (const auto &item : ballot.getContests()) {
+                const auto &ballotContest = deref(item);
+                auto contest = contests.find(ballotContest.getObjectId());
+                if (contest == contests.end()) {
+                    return false;
+                }
+
+                // every selection of the contest must appear exactly once
+                vector<bool> seen(contest->second.count, false);
+                size_t seenCount = 0;
+                for (const auto &selectionItem : ballotContest.getSelections()) {
+                    const auto &ballotSelection = deref(selectionItem);
+                    if (ballotSelection.getIsPlaceholder()) {
+                        continue;
+                    }
+
+                    auto index = contest->second.selections.find(ballotSelection.getObjectId());
+                    if (index == contest->second.selections.end()) {
+                        return false;
+                    }
+                    const auto *descriptionHash = ballotSelection.getDescriptionHash();
+                    const auto *ciphertext = ballotSelection.getCiphertext();
+                    if (descriptionHash == nullptr || ciphertext == nullptr ||
+                        *descriptionHash != *selections[index->second].descriptionHash) {
+                        return false;
+                    }
+
+                    auto offset = index->second - contest->second.first;
+                    if (seen[offset]) {
+                        return false;
+                    }
+                    seen[offset] = true;
+                    seenCount++;
+
+                    resolved.emplace_back(index->second, ciphertext);
+                }
+
+                if (seenCount != contest->second.count) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /// <summary>
+        /// Check a ballot and fold it into the totals if it is cast.
+        /// <returns>true if the ballot can be added to the tally</returns>
+        /// </summary>
+        bool add(const CiphertextBallot &ballot, bool skipValidation, TallyTotals &into,
+                 ResolvedSelections &resolved) const
+        {
+            auto state = ballot.getState();
+            if (!isTallyState(state)) {
+                Log::info("CiphertextTally: incorrect ballot state for " + ballot.getObjectId());
+                return false;
+            }
+
+            if (!skipValidation &&
+                !const_cast<CiphertextBallot &>(ballot).isValidEncryption(
+                  manifestHash, elgamalPublicKey, cryptoExtendedBaseHash)) {
+                Log::info("CiphertextTally: ballot " + ballot.getObjectId() + " is not valid");
+                return false;
+            }
+
+            if (state != BallotBoxState::cast) {
+                return true;
+            }
+
+            if (!resolve(ballot, resolved)) {
+                Log::info("CiphertextTally: ballot " + ballot.getObjectId() +
+                          " does not match the manifest");
+                return false;
+            }
+
+            for (const auto &[index, ciphertext] : resolved) {
+                into.multiply(index, *ciphertext);
+            }
+            return true;
+        }
+
+        /// <summary>
+        /// Parse a serialized ballot, record its id and fold it into the totals if it is cast.
+        /// <returns>true if the ballot was added to the tally</returns>
+        /// </summary>
+        bool add(const BallotRecord &record, mutex &idsLock, TallyTotals &into,
+                 ResolvedSelections &resolved)
+        {
+            StreamedBallot ballot;
+            try {
+                StreamedBallotParser parser(ballot);
+                nlohmann::json::sax_parse(record.bytes.begin(), record.bytes.end(), &parser,
+                                          record.isMsgPack
+                                            ? nlohmann::json::input_format_t::msgpack
+                                            : nlohmann::json::input_format_t::json);
+            } catch (const std::exception &e) {
+                Log::info("CiphertextTally: could not read ballot: " + std::string(e.what()));
+                return false;
+            }
+
+            auto state = ballot.getState();
+            if (ballot.getObjectId().empty() || !isTallyState(state)) {
+                Log::info("CiphertextTally: incorrect ballot state for " + ballot.getObjectId());
+                return false;
+            }
+
+            if (state == BallotBoxState::cast && !resolve(ballot, resolved)) {
+                Log::info("CiphertextTally: ballot " + ballot.getObjectId() +
+                          " does not match the manifest");
+                return false;
+            }
+
+            {
+                lock_guard<mutex> guard(idsLock);
+                if (hasBallot(ballot.getObjectId())) {
+                    Log::info("CiphertextTally: ballot " + ballot.getObjectId() +
+                              " already added");
+                    return false;
+                }
+                addBallotId(ballot.getObjectId(), state);
+            }
+
+            if (state == BallotBoxState::cast) {
+                for (const auto &[index, ciphertext] : resolved) {
+                    into.multiply(index, *ciphertext);
+                }
+            }
+            return true;
+        }
+
+        /// <summary>
+        /// Multiply the partial totals together pairwise in parallel until one remains
+        /// </summary>
+        static TallyTotals reduce(vector<TallyTotals> partials)
+        {
+            while (partials.size() > 1) {
+                auto half = partials.size() / 2;
+                vector<future<void>> tasks;
+                tasks.reserve(half);
+                for (size_t i = 0; i < half; i++) {
+                    tasks.push_back(Scheduler::submit(
+                      [&partials, i, half]() { partials[i].multiply(partials[i + half]); }));
+                }
+                when_all(tasks);
+
+                // an odd partial out stays in the middle and moves down with the survivors
+                partials.erase(partials.begin() + static_cast<std::ptrdiff_t>(half),
+                               partials.begin() + static_cast<std::ptrdiff_t>(half * 2));
+            }
+            return move(partials.front());
+        }
+
+        vector<bool> accumulate(const vector<reference_wrapper<const CiphertextBallot>> &ballots,
+                                bool skipValidation)
+        {
+            lock_guard<mutex> guard(lock);
+
+            // a ballot can only be added once, including within the same batch
+            vector<size_t> candidates;
+            unordered_set<string> batchIds;
+            for (size_t i = 0; i < ballots.size(); i++) {
+                auto ballotId = ballots[i].get().getObjectId();
+                if (hasBallot(ballotId) || !batchIds.insert(ballotId).second) {
+                    Log::info("CiphertextTally: ballot " + ballotId + " already added");
+                    continue;
+                }
+                candidates.push_back(i);
+            }
+
+            vector<uint8_t> added(ballots.size(), 0);
+            auto threads = std::max<size_t>(1, Scheduler::getThreadCount());
+            auto taskCount = std::min(threads, (candidates.size() + MIN_BALLOTS_PER_TASK - 1) /
+                                                 MIN_BALLOTS_PER_TASK);
+
+            if (taskCount <= 1) {
+                // fold straight into the running totals
+                ResolvedSelections resolved;
+                for (auto i : candidates) {
+                    added[i] = add(ballots[i].get(), skipValidation, totals, resolved) ? 1 : 0;
+                }
+            } else {
+                // each task folds a contiguous chunk of ballots into its own partial totals
+                auto chunk = (candidates.size() + taskCount - 1) / taskCount;
+                vector<future<TallyTotals>> tasks;
+                tasks.reserve(taskCount);
+                for (size_t begin = 0; begin < candidates.size(); begin += chunk) {
+                    auto end = std::min(begin + chunk, candidates.size());
+                    tasks.push_back(Scheduler::submit([this, &ballots, &candidates, &added,
+                                                       skipValidation, begin, end]() {
+                        TallyTotals partial(selections.size());
+                        ResolvedSelections resolved;
+                        for (auto c = begin; c < end; c++) {
+                            auto i = candidates[c];
+                            added[i] =
+                              add(ballots[i].get(), skipValidation, partial, resolved) ? 1 : 0;
+                        }
+                        return partial;
+                    }));
+                }
+                totals.multiply(reduce(when_all(tasks)));
+            }
+
+            vector<bool> results(ballots.size(), false);
+            for (auto i : candidates) {
+                if (added[i] == 0) {
+                    continue;
+                }
+                results[i] = true;
+                addBallotId(ballots[i].get().getObjectId(), ballots[i].get().getState());
+            }
+            return results;
+        }
+
+        /// <summary>
+        /// Run the reader on the calling thread and parse and accumulate the records
+        /// it queues on a pool of parser threads, each folding into its own partial totals.
+        /// At most `maxBufferedBytes` of serialized ballots wait between the stages.
+        /// </summary>
+        uint64_t accumulate(const std::function<void(BallotRecordQueue &)> &reader,
+                            uint64_t maxBufferedBytes)
+        {
+            lock_guard<mutex> guard(lock);
+
+            BallotRecordQueue queue(maxBufferedBytes);
+            mutex idsLock;
+            auto workerCount = std::max<size_t>(1, Scheduler::getThreadCount());
+            vector<TallyTotals> partials(workerCount, TallyTotals(selections.size()));
+            vector<uint64_t> added(workerCount, 0);
+            vector<std::exception_ptr> errors(workerCount, nullptr);
+
+            // the parsers block on the queue for the whole stream, so they get
+            // their own threads instead of holding on to scheduler tasks
+            vector<std::thread> workers;
+            workers.reserve(workerCount);
+            for (size_t w = 0; w < workerCount; w++) {
+                workers.emplace_back([this, &queue, &idsLock, &partials, &added, &errors, w]() {
+                    try {
+                        BallotRecord record;
+                        ResolvedSelections resolved;
+                        while (queue.pop(record)) {
+                            if (add(record, idsLock, partials[w], resolved)) {
+                                added[w]++;
+                            }
+                        }
+                    } catch (...) {
+                        errors[w] = std::current_exception();
+                        queue.close();
+                    }
+                });
+            }
+
+            std::exception_ptr error = nullptr;
+            try {
+                reader(queue);
+            } catch (...) {
+                error = std::current_exception();
+            }
+            queue.close();
+            for (auto &worker : workers) {
+                worker.join();
+            }
+
+            // keep the ballots that were added before any failure so the totals match the ids
+            totals.multiply(reduce(move(partials)));
+
+            for (const auto &workerError : errors) {
+                if (error == nullptr) {
+                    error = workerError;
+                }
+            }
+            if (error != nullptr) {
+                std::rethrow_exception(error);
+            }
+
+            uint64_t count = 0;
+            for (auto workerAdded : added) {
+                count += workerAdded;
+            }
+            return count;
+        }
+    };
+
+    // Lifecycle Methods
+
+    CiphertextTally::CiphertextTally(CiphertextTally &&other) : pimpl(move(other.pimpl)) {}
+
+    CiphertextTally::CiphertextTally(const string &objectId, const InternalManifest &manifest,
+                                     const CiphertextElectionContext &context)
+        : pimpl(new Impl(objectId, manifest, context))
+    {
+    }
+
+    CiphertextTally::~CiphertextTally() = default;
+
+    // Operator Overloads
+
+    CiphertextTally &CiphertextTally::operator=(CiphertextTally &&other)
+    {
+        swap(pimpl, other.pimpl);
+        return *this;
+    }
+
+    // Property Getters
+
+    string CiphertextTally::getObjectId() const { return pimpl->objectId; }
+
+    vector<string> CiphertextTally::getCastBallotIds() const
+    {
+        lock_guard<mutex> guard(pimpl->lock);
+        return vector<string>(pimpl->castBallotIds.begin(), pimpl->castBallotIds.end());
+    }
+
+    vector<string> CiphertextTally::getChallengedBallotIds() const
+    {
+        lock_guard<mutex> guard(pimpl->lock);
+        return vector<string>(pimpl->challengedBallotIds.begin(),
+                              pimpl->challengedBallotIds.end());
+    }
+
+    vector<string> CiphertextTally::getSpoiledBallotIds() const
+    {
+        lock_guard<mutex> guard(pimpl->lock);
+        return vector<string>(pimpl->spoiledBallotIds.begin(), pimpl->spoiledBallotIds.end());
+    }
+
+    // Public Members
+
+    bool CiphertextTally::hasBallot(const string &ballotId) const
+    {
+        lock_guard<mutex> guard(pimpl->lock);
+        return pimpl->hasBallot(ballotId);
+    }
+
+    bool CiphertextTally::accumulate(const CiphertextBallot &ballot,
+                                     bool skipValidation /* = false */)
+    {
+        return pimpl->accumulate({std::cref(ballot)}, skipValidation).front();
+    }
+
+    vector<bool>
+    CiphertextTally::accumulate(const vector<reference_wrapper<const CiphertextBallot>> &ballots,
+                                bool skipValidation /* = false */)
+    {
+        return pimpl->accumulate(ballots, skipValidation);
+    }
+
+    vector<unique_ptr<CiphertextTallySelection>> CiphertextTally::getSelections() const
+    {
+        lock_guard<mutex> guard(pimpl->lock);
+
+        vector<unique_ptr<CiphertextTallySelection>> results;
+        results.reserve(pimpl->selections.size());
+        for (size_t i = 0; i < pimpl->selections.size(); i++) {
+            const auto &selection = pimpl->selections[i];
+            auto ciphertext = make_unique<ElGamalCiphertext>(pimpl->totals.pads[i].toElementModP(),
+                                                             pimpl->totals.data[i].toElementModP());
+            results.push_back(make_unique<CiphertextTallySelection>(
+              selection.objectId, selection.contestId, selection.sequenceOrder,
+              *selection.descriptionHash, move(ciphertext)));
+        }
+        return results;
+    }
+
+    uint64_t CiphertextTally::accumulateJsonLines(std::istream &stream, uint64_t maxBufferedBytes)
+    {
+        return pimpl->accumulate(
+          [&stream](BallotRecordQueue &queue) { readJsonLines(stream, queue); }, maxBufferedBytes);
+    }
+
+    uint64_t CiphertextTally::accumulateMsgPack(std::istream &stream, uint64_t maxBufferedBytes)
+    {
+        return pimpl->accumulate(
+          [&stream](BallotRecordQueue &queue) { readMsgPack(stream, queue); }, maxBufferedBytes);
+    }
+
+    uint64_t CiphertextTally::accumulateFiles(const string &path, uint64_t maxBufferedBytes)
+    {
+        return pimpl->accumulate(
+          [&path](BallotRecordQueue &queue) { readBallotFiles(path, queue); }, maxBufferedBytes);
+    }
+
+    vector<string> CiphertextTally::getSelectionIds() const
+    {
+        vector<string> results;
+        results.reserve(pimpl->selections.size());
+        for (const auto &selection : pimpl->selections) {
+            results.push_back(selection.objectId);
+        }
+        return results;
+    }
+
+#pragma endregion
+} // namespace electionguard
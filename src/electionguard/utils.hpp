@@ -62,6 +62,21 @@ namespace electionguard
         return true;
     }
 
+    /// <summary>
+    /// A cheap 64-bit digest of the limbs of an element mod p, used to key lookups
+    /// that confirm a match by comparing the limbs, so it only needs to spread the values.
+    /// </summary>
+    inline uint64_t digestLimbs(const uint64_t *limbs)
+    {
+        uint64_t hash = 0xCBF29CE484222325UL;
+        for (uint32_t i = 0; i < MAX_P_LEN; i++) {
+            hash ^= limbs[i];
+            hash *= 0x9E3779B97F4A7C15UL;
+            hash ^= hash >> 32;
+        }
+        return hash;
+    }
+
     inline uint64_t getSystemTimestamp()
     {
         auto now = system_clock::now();
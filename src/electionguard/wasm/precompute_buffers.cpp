@@ -12,16 +12,31 @@ using namespace std;
 // a marker class since the PrecomputeBufferContext is a singleton
 class PrecomputeBufferContextFacade
 {
+  public:
+    // embind does not apply default arguments
+    static void initialize(const ElementModP &publicKey, uint32_t maxQueueSize)
+    {
+        PrecomputeBufferContext::initialize(publicKey, maxQueueSize);
+    }
 };
 
 EMSCRIPTEN_BINDINGS(electionguard)
 {
+    // embind overloads by argument count, so the keyed overloads share the js name
+    // and the public key is passed as an ElementModP, e.g. ElementModP.fromHex(key)
     class_<PrecomputeBufferContextFacade>("PrecomputeBufferContext")
-      .class_function("clear", &PrecomputeBufferContext::clear)
+      .class_function("clear", select_overload<void()>(&PrecomputeBufferContext::clear))
+      .class_function("clear",
+                      select_overload<void(const ElementModP &)>(&PrecomputeBufferContext::clear))
+      .class_function("initialize", &PrecomputeBufferContextFacade::initialize)
       .class_function("initialize", &PrecomputeBufferContext::initialize)
       .class_function("start", select_overload<void()>(&PrecomputeBufferContext::start))
+      .class_function("start",
+                      select_overload<void(const ElementModP &)>(&PrecomputeBufferContext::start))
       .class_function("startAsync", &PrecomputeBufferContext::startAsync)
-      .class_function("stop", &PrecomputeBufferContext::stop)
+      .class_function("stop", select_overload<void()>(&PrecomputeBufferContext::stop))
+      .class_function("stop",
+                      select_overload<void(const ElementModP &)>(&PrecomputeBufferContext::stop))
       .class_function("getMaxQueueSize", &PrecomputeBufferContext::getMaxQueueSize)
       .class_function("getCurrentQueueSize", &PrecomputeBufferContext::getCurrentQueueSize);
 }
\ No newline at end of file
@@ -91,6 +91,26 @@ BENCHMARK_DEFINE_F(ChaumPedersenFixture, CheckDisjunctiveChaumPedersen)(benchmar
 BENCHMARK_REGISTER_F(ChaumPedersenFixture, CheckDisjunctiveChaumPedersen)
   ->Unit(benchmark::kMillisecond);
 
+BENCHMARK_DEFINE_F(ChaumPedersenFixture, CheckDisjunctiveChaumPedersenBatch)
+(benchmark::State &state)
+{
+    vector<reference_wrapper<const ElGamalCiphertext>> messages;
+    vector<reference_wrapper<DisjunctiveChaumPedersenProof>> proofs;
+    for (int64_t i = 0; i < state.range(0); i++) {
+        messages.push_back(*message);
+        proofs.push_back(*disjunctive);
+    }
+    while (state.KeepRunning()) {
+        DisjunctiveChaumPedersenProof::isValidBatch(messages, proofs, *keypair->getPublicKey(),
+                                                    ONE_MOD_Q());
+    }
+}
+
+BENCHMARK_REGISTER_F(ChaumPedersenFixture, CheckDisjunctiveChaumPedersenBatch)
+  ->Arg(1)
+  ->Arg(16)
+  ->Unit(benchmark::kMillisecond);
+
 BENCHMARK_DEFINE_F(ChaumPedersenFixture, CloneDisjunctiveChaumPedersen)(benchmark::State &state)
 {
     while (state.KeepRunning()) {
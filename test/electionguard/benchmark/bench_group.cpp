@@ -130,6 +130,43 @@ BENCHMARK_DEFINE_F(GroupElementFixture, mul_mod_p)(benchmark::State &state)
 
 BENCHMARK_REGISTER_F(GroupElementFixture, mul_mod_p)->Unit(benchmark::kMillisecond);
 
+BENCHMARK_DEFINE_F(GroupElementFixture, mul_mod_p_chain)(benchmark::State &state)
+{
+    vector<unique_ptr<ElementModP>> elements;
+    for (int64_t i = 0; i < state.range(0); i++) {
+        elements.push_back(rand_p());
+    }
+    for (auto _ : state) {
+        auto product = ElementModP::fromUint64(1UL);
+        for (const auto &element : elements) {
+            product = mul_mod_p(*product, *element);
+        }
+    }
+}
+
+BENCHMARK_REGISTER_F(GroupElementFixture, mul_mod_p_chain)
+  ->Arg(64)
+  ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(GroupElementFixture, montgomery_mul_mod_p_chain)(benchmark::State &state)
+{
+    vector<MontgomeryElementModP> elements;
+    for (int64_t i = 0; i < state.range(0); i++) {
+        elements.emplace_back(*rand_p());
+    }
+    for (auto _ : state) {
+        MontgomeryElementModP product;
+        for (const auto &element : elements) {
+            product *= element;
+        }
+        auto result = product.toElementModP();
+    }
+}
+
+BENCHMARK_REGISTER_F(GroupElementFixture, montgomery_mul_mod_p_chain)
+  ->Arg(64)
+  ->Unit(benchmark::kMillisecond);
+
 #ifdef USE_STANDARD_PRIMES
 
 // only run when using standard prime
@@ -147,6 +184,68 @@ BENCHMARK_DEFINE_F(GroupElementFixture, pow_mod_p_with_q)(benchmark::State &stat
 
 BENCHMARK_REGISTER_F(GroupElementFixture, pow_mod_p_with_q)->Unit(benchmark::kMillisecond);
 
+BENCHMARK_DEFINE_F(GroupElementFixture, pow_mod_p_two_bases)(benchmark::State &state)
+{
+    auto rand_p1 = rand_p();
+    auto rand_p2 = rand_p();
+    for (auto _ : state) {
+        auto exp = mul_mod_p(*pow_mod_p(*rand_p1, *a), *pow_mod_p(*rand_p2, *b));
+    }
+}
+
+BENCHMARK_REGISTER_F(GroupElementFixture, pow_mod_p_two_bases)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(GroupElementFixture, multi_pow_mod_p_two_bases)(benchmark::State &state)
+{
+    auto rand_p1 = rand_p();
+    auto rand_p2 = rand_p();
+    for (auto _ : state) {
+        auto exp = multi_pow_mod_p({*rand_p1, *rand_p2}, {*a, *b});
+    }
+}
+
+BENCHMARK_REGISTER_F(GroupElementFixture, multi_pow_mod_p_two_bases)
+  ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(GroupElementFixture, isValidResidue)(benchmark::State &state)
+{
+    vector<unique_ptr<ElementModP>> elements;
+    for (int64_t i = 0; i < state.range(0); i++) {
+        elements.push_back(g_pow_p(*rand_q()));
+    }
+    for (auto _ : state) {
+        for (const auto &element : elements) {
+            // copy the limbs so the element is not already flagged as valid
+            auto valid = ElementModP(element->ref(), true).isValidResidue();
+        }
+    }
+}
+
+BENCHMARK_REGISTER_F(GroupElementFixture, isValidResidue)
+  ->Arg(16)
+  ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(GroupElementFixture, isValidResidueBatch)(benchmark::State &state)
+{
+    vector<unique_ptr<ElementModP>> elements;
+    for (int64_t i = 0; i < state.range(0); i++) {
+        elements.push_back(g_pow_p(*rand_q()));
+    }
+    for (auto _ : state) {
+        vector<ElementModP> copies;
+        copies.reserve(elements.size());
+        for (const auto &element : elements) {
+            copies.emplace_back(element->ref(), true);
+        }
+        vector<reference_wrapper<const ElementModP>> refs(copies.begin(), copies.end());
+        auto valid = ElementModP::isValidResidueBatch(refs);
+    }
+}
+
+BENCHMARK_REGISTER_F(GroupElementFixture, isValidResidueBatch)
+  ->Arg(16)
+  ->Unit(benchmark::kMillisecond);
+
 BENCHMARK_DEFINE_F(GroupElementFixture, pow_mod_p_fixed_base)(benchmark::State &state)
 {
     auto rand_p1 = rand_p();
@@ -38,12 +38,13 @@ class HaclBignum4096Fixture : public benchmark::Fixture
 
 BENCHMARK_DEFINE_F(HaclBignum4096Fixture, mod_p)(benchmark::State &state)
 {
-    auto p = P().get();
-    auto g = G().get();
-    auto e = rand_q()->toElementModP()->get();
+    auto *p = const_cast<uint64_t *>(P().get());
+    auto *g = const_cast<uint64_t *>(G().get());
+    auto exponent = rand_q()->toElementModP();
+    auto *e = exponent->getMutable();
 
     uint64_t mul_result[MAX_P_LEN_DOUBLE] = {};
-    Bignum4096::mul(p1->get(), p2->get(), mul_result);
+    Bignum4096::mul(p1->getMutable(), p2->getMutable(), mul_result);
 
     uint64_t result[MAX_P_LEN] = {};
     for (auto _ : state) {
@@ -55,12 +56,13 @@ BENCHMARK_REGISTER_F(HaclBignum4096Fixture, mod_p)->Unit(benchmark::kMillisecond
 
 BENCHMARK_DEFINE_F(HaclBignum4096Fixture, mod_p_mont)(benchmark::State &state)
 {
-    auto p = P().get();
-    auto g = G().get();
-    auto e = rand_q()->toElementModP()->get();
+    auto *p = const_cast<uint64_t *>(P().get());
+    auto *g = const_cast<uint64_t *>(G().get());
+    auto exponent = rand_q()->toElementModP();
+    auto *e = exponent->getMutable();
 
     uint64_t mul_result[MAX_P_LEN_DOUBLE] = {};
-    Bignum4096::mul(p1->get(), p2->get(), mul_result);
+    Bignum4096::mul(p1->getMutable(), p2->getMutable(), mul_result);
 
     uint64_t result[MAX_P_LEN] = {};
     for (auto _ : state) {
@@ -72,9 +74,10 @@ BENCHMARK_REGISTER_F(HaclBignum4096Fixture, mod_p_mont)->Unit(benchmark::kMillis
 
 BENCHMARK_DEFINE_F(HaclBignum4096Fixture, pow_mod_p_var_time)(benchmark::State &state)
 {
-    auto p = P().get();
-    auto g = G().get();
-    auto e = rand_q()->toElementModP()->get();
+    auto *p = const_cast<uint64_t *>(P().get());
+    auto *g = const_cast<uint64_t *>(G().get());
+    auto exponent = rand_q()->toElementModP();
+    auto *e = exponent->getMutable();
     uint64_t result[MAX_P_LEN] = {};
     for (auto _ : state) {
         auto success =
@@ -86,9 +89,10 @@ BENCHMARK_REGISTER_F(HaclBignum4096Fixture, pow_mod_p_var_time)->Unit(benchmark:
 
 BENCHMARK_DEFINE_F(HaclBignum4096Fixture, pow_mod_p_const_time)(benchmark::State &state)
 {
-    auto p = P().get();
-    auto g = G().get();
-    auto e = rand_q()->toElementModP()->get();
+    auto *p = const_cast<uint64_t *>(P().get());
+    auto *g = const_cast<uint64_t *>(G().get());
+    auto exponent = rand_q()->toElementModP();
+    auto *e = exponent->getMutable();
     uint64_t result[MAX_P_LEN] = {};
     for (auto _ : state) {
         auto success =
@@ -100,9 +104,10 @@ BENCHMARK_REGISTER_F(HaclBignum4096Fixture, pow_mod_p_const_time)->Unit(benchmar
 
 BENCHMARK_DEFINE_F(HaclBignum4096Fixture, pow_mod_p_var_time_mont)(benchmark::State &state)
 {
-    auto p = P().get();
-    auto g = G().get();
-    auto e = rand_q()->toElementModP()->get();
+    auto *p = const_cast<uint64_t *>(P().get());
+    auto *g = const_cast<uint64_t *>(G().get());
+    auto exponent = rand_q()->toElementModP();
+    auto *e = exponent->getMutable();
 
     uint64_t result[MAX_P_LEN] = {};
     for (auto _ : state) {
@@ -114,9 +119,10 @@ BENCHMARK_REGISTER_F(HaclBignum4096Fixture, pow_mod_p_var_time_mont)->Unit(bench
 
 BENCHMARK_DEFINE_F(HaclBignum4096Fixture, pow_mod_p_const_time_mont)(benchmark::State &state)
 {
-    auto p = P().get();
-    auto g = G().get();
-    auto e = rand_q()->toElementModP()->get();
+    auto *p = const_cast<uint64_t *>(P().get());
+    auto *g = const_cast<uint64_t *>(G().get());
+    auto exponent = rand_q()->toElementModP();
+    auto *e = exponent->getMutable();
 
     uint64_t result[MAX_P_LEN] = {};
     for (auto _ : state) {
@@ -0,0 +1,42 @@
+#include "../../../src/electionguard/lookup_table.hpp"
+
+#include <benchmark/benchmark.h>
+#include <electionguard/constants.h>
+#include <electionguard/group.hpp>
+
+using namespace electionguard;
+using namespace std;
+
+#ifdef USE_STANDARD_PRIMES
+
+// Reports the cost of a fixed base exponentiation for each supported
+// window size alongside the memory used by the table for one base.
+
+template <uint64_t WindowSize> static void LookupTable_pow_mod_p(benchmark::State &state)
+{
+    auto base = g_pow_p(*rand_q());
+    auto exponent = rand_q();
+    auto table = make_unique<LookupTable<WindowSize>>(base->get());
+
+    for (auto _ : state) {
+        auto result = table->pow_mod_p(exponent->ref());
+        benchmark::DoNotOptimize(result);
+    }
+
+    state.counters["window_bits"] = static_cast<double>(WindowSize);
+    state.counters["table_bytes"] = static_cast<double>(LookupTable<WindowSize>::TableSize);
+    state.counters["multiplications"] =
+      static_cast<double>(LookupTable<WindowSize>::TableLength);
+}
+
+BENCHMARK_TEMPLATE(LookupTable_pow_mod_p, 4)->Unit(benchmark::kNanosecond);
+BENCHMARK_TEMPLATE(LookupTable_pow_mod_p, 5)->Unit(benchmark::kNanosecond);
+BENCHMARK_TEMPLATE(LookupTable_pow_mod_p, 6)->Unit(benchmark::kNanosecond);
+BENCHMARK_TEMPLATE(LookupTable_pow_mod_p, 7)->Unit(benchmark::kNanosecond);
+BENCHMARK_TEMPLATE(LookupTable_pow_mod_p, 8)->Unit(benchmark::kNanosecond);
+BENCHMARK_TEMPLATE(LookupTable_pow_mod_p, 9)->Unit(benchmark::kNanosecond);
+BENCHMARK_TEMPLATE(LookupTable_pow_mod_p, 10)->Unit(benchmark::kNanosecond);
+BENCHMARK_TEMPLATE(LookupTable_pow_mod_p, 11)->Unit(benchmark::kNanosecond);
+BENCHMARK_TEMPLATE(LookupTable_pow_mod_p, 12)->Unit(benchmark::kNanosecond);
+
+#endif
@@ -24,17 +24,20 @@ set(SOURCES_electionguard_test_benchmark
     ${CMAKE_CURRENT_SOURCE_DIR}/electionguard/benchmark/bench_hacl.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/electionguard/benchmark/bench_hash.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/electionguard/benchmark/bench_hashed_elgamal.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/electionguard/benchmark/bench_lookup_table.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/electionguard/benchmark/bench_nonces.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/electionguard/benchmark/bench_precompute.cpp
 )
 
 set(SOURCES_electionguard_test_cpp_tests
     ${CMAKE_CURRENT_SOURCE_DIR}/main.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/electionguard/test_async.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/electionguard/test_ballot_code.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/electionguard/test_ballot_compact.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/electionguard/test_ballot.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/electionguard/test_chaum_pedersen.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/electionguard/test_constants.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/electionguard/test_decrypt.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/electionguard/test_discrete_log.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/electionguard/test_election.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/electionguard/test_elgamal.cpp
@@ -45,6 +48,8 @@ set(SOURCES_electionguard_test_cpp_tests
     ${CMAKE_CURRENT_SOURCE_DIR}/electionguard/test_hash.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/electionguard/test_nonces.cpp
     ${CMAKE_CURRENT_SOURCE_DIR}/electionguard/test_manifest.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/electionguard/test_precompute_buffers.cpp
+    ${CMAKE_CURRENT_SOURCE_DIR}/electionguard/test_tally.cpp
 )
 
 set(SOURCES_electionguard_test_c_tests
@@ -0,0 +1,120 @@
+#include <atomic>
+#include <chrono>
+#include <doctest/doctest.h>
+#include <electionguard/async.hpp>
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace electionguard;
+using namespace std;
+
+TEST_CASE("Scheduler when_all returns the results in the order of the tasks")
+{
+    // Arrange
+    vector<future<int>> tasks;
+    for (int i = 0; i < 100; i++) {
+        tasks.push_back(Scheduler::submit([i]() { return i * i; }));
+    }
+
+    // Act
+    auto results = when_all(tasks);
+
+    // Assert
+    REQUIRE(results.size() == 100);
+    for (int i = 0; i < 100; i++) {
+        CHECK(results[i] == i * i);
+    }
+}
+
+TEST_CASE("Scheduler tasks can wait on the tasks they submit")
+{
+    // Arrange
+    // submit more outer tasks than there are workers so every worker
+    // is waiting on nested tasks at the same time
+    auto outerCount = Scheduler::getThreadCount() * 4;
+    atomic<uint32_t> innerCount = 0;
+
+    // Act
+    vector<future<void>> tasks;
+    for (uint32_t i = 0; i < outerCount; i++) {
+        tasks.push_back(Scheduler::submit([&innerCount]() {
+            vector<future<void>> inner;
+            for (int j = 0; j < 8; j++) {
+                inner.push_back(Scheduler::submit([&innerCount]() { innerCount++; }));
+            }
+            when_all(inner);
+        }));
+    }
+    when_all(tasks);
+
+    // Assert
+    CHECK(innerCount == outerCount * 8);
+}
+
+TEST_CASE("Scheduler when_all rethrows after every task completes")
+{
+    // Arrange
+    atomic<int> completed = 0;
+    vector<future<void>> tasks;
+    tasks.push_back(Scheduler::submit([]() { throw runtime_error("task failed"); }));
+    for (int i = 0; i < 10; i++) {
+        tasks.push_back(Scheduler::submit([&completed]() { completed++; }));
+    }
+
+    // Act & Assert
+    CHECK_THROWS(when_all(tasks));
+    CHECK(completed == 10);
+}
+
+TEST_CASE("ThreadPool runs the submitted tasks before it is destroyed")
+{
+    // Arrange
+    atomic<int> completed = 0;
+    vector<future<void>> tasks;
+
+    // Act
+    {
+        ThreadPool pool(2);
+        for (int i = 0; i < 50; i++) {
+            tasks.push_back(pool.submit([&completed]() { completed++; }));
+        }
+    }
+
+    // Assert
+    CHECK(completed == 50);
+    for (auto &task : tasks) {
+        CHECK(isReady(task));
+    }
+}
+
+TEST_CASE("ThreadPool wait does not run tasks queued before the waiting task")
+{
+    // Arrange
+    ThreadPool pool(1);
+    promise<void> queued;
+    promise<void> release;
+    auto isQueued = queued.get_future().share();
+    auto isReleased = release.get_future();
+    atomic<bool> parentDone = false;
+    atomic<bool> otherRanFirst = false;
+
+    // hold the only worker until both tasks are queued so the parent runs first
+    auto gate = pool.submit([isQueued]() { isQueued.wait(); });
+    auto other = pool.submit([&]() { otherRanFirst = !parentDone; });
+    auto parent = pool.submit([&]() {
+        pool.wait(isReleased);
+        parentDone = true;
+    });
+
+    // Act
+    queued.set_value();
+    this_thread::sleep_for(chrono::milliseconds(50));
+    release.set_value();
+    parent.wait();
+    other.wait();
+
+    // Assert
+    CHECK_FALSE(otherRanFirst);
+}
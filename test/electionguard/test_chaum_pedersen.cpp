@@ -26,6 +26,13 @@ class DisjunctiveChaumPedersenProofHarness : DisjunctiveChaumPedersenProof
     {
         return DisjunctiveChaumPedersenProof::make_zero(message, r, k, q, seed);
     }
+    static bool
+    isValidCombined(const vector<reference_wrapper<const ElGamalCiphertext>> &messages,
+                    const vector<reference_wrapper<DisjunctiveChaumPedersenProof>> &proofs,
+                    const ElementModP &k)
+    {
+        return DisjunctiveChaumPedersenProof::isValidCombined(messages, proofs, k);
+    }
     static unique_ptr<DisjunctiveChaumPedersenProof> make_one(const ElGamalCiphertext &message,
                                                               const ElementModQ &r,
                                                               const ElementModP &k,
@@ -94,6 +101,57 @@ TEST_CASE("Disjunctive CP Proof simple valid inputs generate valid proofs")
           true);
 }
 
+TEST_CASE("Disjunctive CP Proof batch validation identifies the invalid proofs")
+{
+    // Arrange
+    auto keypair = ElGamalKeyPair::fromSecret(TWO_MOD_Q(), false);
+    const auto &publicKey = *keypair->getPublicKey();
+
+    vector<unique_ptr<ElGamalCiphertext>> messages;
+    vector<unique_ptr<DisjunctiveChaumPedersenProof>> proofs;
+    for (uint64_t i = 0; i < 5; i++) {
+        auto plaintext = i % 2;
+        auto nonce = rand_q();
+        auto message = elgamalEncrypt(plaintext, *nonce, publicKey);
+        proofs.push_back(
+          DisjunctiveChaumPedersenProof::make(*message, *nonce, publicKey, ONE_MOD_Q(), plaintext));
+        messages.push_back(move(message));
+    }
+
+    // a proof of one for an encryption of zero
+    auto invalidNonce = rand_q();
+    auto invalidMessage = elgamalEncrypt(0UL, *invalidNonce, publicKey);
+    auto invalidProof = DisjunctiveChaumPedersenProofHarness::make_one(
+      *invalidMessage, *invalidNonce, publicKey, ONE_MOD_Q());
+
+    vector<reference_wrapper<const ElGamalCiphertext>> batchMessages;
+    vector<reference_wrapper<DisjunctiveChaumPedersenProof>> batchProofs;
+    for (size_t i = 0; i < proofs.size(); i++) {
+        batchMessages.push_back(*messages[i]);
+        batchProofs.push_back(*proofs[i]);
+    }
+
+    // Act
+    auto validCombined =
+      DisjunctiveChaumPedersenProofHarness::isValidCombined(batchMessages, batchProofs, publicKey);
+    auto validResults =
+      DisjunctiveChaumPedersenProof::isValidBatch(batchMessages, batchProofs, publicKey, ONE_MOD_Q());
+
+    batchMessages.insert(batchMessages.begin() + 2, *invalidMessage);
+    batchProofs.insert(batchProofs.begin() + 2, *invalidProof);
+    auto invalidCombined =
+      DisjunctiveChaumPedersenProofHarness::isValidCombined(batchMessages, batchProofs, publicKey);
+    auto invalidResults =
+      DisjunctiveChaumPedersenProof::isValidBatch(batchMessages, batchProofs, publicKey, ONE_MOD_Q());
+
+    // Assert
+    CHECK(validCombined == true);
+    CHECK(invalidCombined == false);
+    CHECK(validResults == vector<bool>(5, true));
+    CHECK(invalidResults == vector<bool>{true, true, false, true, true, true});
+    CHECK(DisjunctiveChaumPedersenProof::isValidBatch({}, {}, publicKey, ONE_MOD_Q()).empty());
+}
+
 TEST_CASE("Constant CP Proof encryption of zero")
 {
     const auto &nonce = ONE_MOD_Q();
@@ -193,6 +251,24 @@ TEST_CASE("Disjunctive CP Proof simple valid inputs generate valid proofs")
     PrecomputeBufferContext::clear();
 }
 
+TEST_CASE("CP Proof of a partial decryption")
+{
+    auto keypair = ElGamalKeyPair::fromSecret(TWO_MOD_Q(), false);
+    const auto &nonce = ONE_MOD_Q();
+    const auto &seed = TWO_MOD_Q();
+
+    auto message = elgamalEncrypt(1UL, nonce, *keypair->getPublicKey());
+    auto share = message->partialDecrypt(*keypair->getSecretKey());
+    auto proof =
+      ChaumPedersenProof::make(*message, *keypair->getSecretKey(), *share, seed, ONE_MOD_Q());
+    auto badProof =
+      ChaumPedersenProof::make(*message, ONE_MOD_Q(), *share, seed, ONE_MOD_Q());
+
+    CHECK(proof->isValid(*message, *keypair->getPublicKey(), *share, ONE_MOD_Q()) == true);
+    CHECK(proof->isValid(*message, *keypair->getPublicKey(), *share, TWO_MOD_Q()) == false);
+    CHECK(badProof->isValid(*message, *keypair->getPublicKey(), *share, ONE_MOD_Q()) == false);
+}
+
 TEST_CASE("Disjunctive CP Proof encryption of zero with precomputed values")
 {
     const auto &nonce = ONE_MOD_Q();
@@ -86,7 +86,7 @@ TEST_CASE("Print Standard Constants")
 
     uint64_t p_inverse_offset[MAX_P_LEN_DOUBLE] = {};
     auto p_carry =
-      Bignum4096::sub(const_cast<uint64_t *>(MAX_4096), p_hacl->get(), p_inverse_offset);
+      Bignum4096::sub(const_cast<uint64_t *>(MAX_4096), p_hacl->getMutable(), p_inverse_offset);
     p_carry = Bignum4096::add(static_cast<uint64_t *>(p_inverse_offset),
                               const_cast<uint64_t *>(ONE_MOD_P_ARRAY),
                               static_cast<uint64_t *>(p_inverse_offset));
@@ -206,7 +206,7 @@ TEST_CASE("Print Test Constants")
 
     uint64_t p_inverse_offset[MAX_P_LEN_DOUBLE] = {};
     auto p_carry =
-      Bignum4096::sub(const_cast<uint64_t *>(MAX_4096), p_hacl->get(), p_inverse_offset);
+      Bignum4096::sub(const_cast<uint64_t *>(MAX_4096), p_hacl->getMutable(), p_inverse_offset);
     p_carry = Bignum4096::add(static_cast<uint64_t *>(p_inverse_offset),
                               const_cast<uint64_t *>(ONE_MOD_P_ARRAY),
                               static_cast<uint64_t *>(p_inverse_offset));
@@ -0,0 +1,272 @@
+#include <doctest/doctest.h>
+#include <electionguard/chaum_pedersen.hpp>
+#include <electionguard/decrypt.hpp>
+#include <electionguard/elgamal.hpp>
+#include <electionguard/group.hpp>
+#include <electionguard/nonces.hpp>
+#include <electionguard/polynomial.hpp>
+#include <memory>
+#include <vector>
+
+using namespace electionguard;
+using namespace std;
+
+TEST_CASE("Decryption shares of a batch match the shares and proofs made one at a time")
+{
+    // Arrange
+    auto keypair = ElGamalKeyPair::fromSecret(*rand_q(), false);
+    const auto &secretKey = *keypair->getSecretKey();
+    const auto &publicKey = *keypair->getPublicKey();
+    auto seed = rand_q();
+    auto extendedBaseHash = rand_q();
+
+    vector<unique_ptr<ElGamalCiphertext>> ciphertexts;
+    vector<reference_wrapper<const ElGamalCiphertext>> ciphertextRefs;
+    for (uint64_t i = 0; i < 11; i++) {
+        ciphertexts.push_back(elgamalEncrypt(i % 2, *rand_q(), publicKey));
+        ciphertextRefs.push_back(*ciphertexts.back());
+    }
+
+    // Act
+    auto shares = computeDecryptionShares(ciphertextRefs, secretKey, *seed, *extendedBaseHash);
+
+    // Assert
+    REQUIRE(shares.size() == ciphertexts.size());
+    Nonces seeds(*seed);
+    for (uint64_t i = 0; i < ciphertexts.size(); i++) {
+        auto *share = shares[i]->getShare();
+        auto *proof = shares[i]->getProof();
+        CHECK(*share == *ciphertexts[i]->partialDecrypt(secretKey));
+        CHECK(ciphertexts[i]->decrypt(*share) == i % 2);
+
+        auto expected = ChaumPedersenProof::make(*ciphertexts[i], secretKey, *share,
+                                                 *seeds.get(i), *extendedBaseHash);
+        CHECK(*proof->getPad() == *expected->getPad());
+        CHECK(*proof->getData() == *expected->getData());
+        CHECK(*proof->getChallenge() == *expected->getChallenge());
+        CHECK(*proof->getResponse() == *expected->getResponse());
+        CHECK(proof->isValid(*ciphertexts[i], publicKey, *share, *extendedBaseHash) == true);
+    }
+}
+
+TEST_CASE("Decryption share proofs do not validate against another share or key")
+{
+    // Arrange
+    auto keypair = ElGamalKeyPair::fromSecret(*rand_q(), false);
+    auto otherKeypair = ElGamalKeyPair::fromSecret(*rand_q(), false);
+    auto extendedBaseHash = rand_q();
+    auto ciphertext = elgamalEncrypt(1UL, *rand_q(), *keypair->getPublicKey());
+
+    // Act
+    auto shares = computeDecryptionShares({*ciphertext}, *keypair->getSecretKey(), TWO_MOD_Q(),
+                                          *extendedBaseHash);
+
+    // Assert
+    REQUIRE(shares.size() == 1);
+    auto *share = shares[0]->getShare();
+    auto *proof = shares[0]->getProof();
+    auto otherShare = ciphertext->partialDecrypt(*otherKeypair->getSecretKey());
+    CHECK(proof->isValid(*ciphertext, *keypair->getPublicKey(), *share, *extendedBaseHash) ==
+          true);
+    CHECK(proof->isValid(*ciphertext, *keypair->getPublicKey(), *otherShare, *extendedBaseHash) ==
+          false);
+    CHECK(proof->isValid(*ciphertext, *otherKeypair->getPublicKey(), *share, *extendedBaseHash) ==
+          false);
+    CHECK(proof->isValid(*ciphertext, *keypair->getPublicKey(), *share, ONE_MOD_Q()) == false);
+}
+
+TEST_CASE("Partial decryptions of elgamal and hashed elgamal pads match partialDecrypt")
+{
+    // Arrange
+    auto keypair = ElGamalKeyPair::fromSecret(*rand_q(), false);
+    const auto &publicKey = *keypair->getPublicKey();
+    auto ciphertext = elgamalEncrypt(1UL, *rand_q(), publicKey);
+    auto hashedCiphertext = hashedElgamalEncrypt({1, 2, 3}, *rand_q(), publicKey, ONE_MOD_Q(),
+                                                 BYTES_512, true);
+    vector<reference_wrapper<const ElementModP>> pads{
+      *ciphertext->getPad(), *hashedCiphertext->getPad(), G(), ONE_MOD_P()};
+
+    vector<const ElementModQ *> secretKeys{keypair->getSecretKey(), &ONE_MOD_Q(), &ZERO_MOD_Q()};
+    for (const auto *secretKey : secretKeys) {
+        // Act
+        auto partials = computePartialDecryptions(pads, *secretKey);
+
+        // Assert
+        REQUIRE(partials.size() == pads.size());
+        CHECK(*partials[0] == *ciphertext->partialDecrypt(*secretKey));
+        CHECK(*partials[1] == *hashedCiphertext->partialDecrypt(*secretKey));
+        CHECK(*partials[2] == *g_pow_p(*secretKey));
+        CHECK(*partials[3] == ONE_MOD_P());
+    }
+}
+
+TEST_CASE("Lagrange coefficients of a guardian set match Polynomial interpolate")
+{
+    // Arrange
+    LagrangeCoefficients::clear();
+    vector<uint64_t> sequenceOrders{4, 1, 3, 7};
+
+    // Act
+    auto coefficients = LagrangeCoefficients::get(sequenceOrders);
+    auto cached = LagrangeCoefficients::get(sequenceOrders);
+    auto reordered = LagrangeCoefficients::get({7, 3, 1, 4});
+
+    // Assert
+    REQUIRE(coefficients.size() == sequenceOrders.size());
+    for (size_t i = 0; i < sequenceOrders.size(); i++) {
+        vector<uint64_t> others;
+        for (auto order : sequenceOrders) {
+            if (order != sequenceOrders[i]) {
+                others.push_back(order);
+            }
+        }
+        CHECK(coefficients[i] == *Polynomial::interpolate(sequenceOrders[i], others));
+        CHECK(cached[i] == coefficients[i]);
+        CHECK(reordered[sequenceOrders.size() - 1 - i] == coefficients[i]);
+    }
+    CHECK(LagrangeCoefficients::get({2})[0] == ONE_MOD_Q());
+    CHECK_THROWS(LagrangeCoefficients::get({1, 3, 1}));
+    CHECK_THROWS(LagrangeCoefficients::get({0, 2}));
+}
+
+TEST_CASE("Combining the shares of a quorum of guardians decrypts every ciphertext")
+{
+    // Arrange
+    // the guardians hold the points 𝑓(𝑖) of the line 𝑓(𝑥) = 𝑎0 + 𝑎1𝑥
+    // and any two of them can decrypt under the joint key 𝑔^𝑎0
+    auto a0 = rand_q();
+    auto a1 = rand_q();
+    auto publicKey = g_pow_p(*a0);
+
+    vector<unique_ptr<ElGamalCiphertext>> ciphertexts;
+    vector<reference_wrapper<const ElGamalCiphertext>> ciphertextRefs;
+    for (uint64_t i = 0; i < 9; i++) {
+        ciphertexts.push_back(elgamalEncrypt(i % 2, *rand_q(), *publicKey));
+        ciphertextRefs.push_back(*ciphertexts.back());
+    }
+
+    vector<uint64_t> sequenceOrders{3, 1};
+    vector<vector<unique_ptr<DecryptionShare>>> guardianShares;
+    vector<vector<reference_wrapper<const ElementModP>>> shares;
+    for (auto order : sequenceOrders) {
+        auto secret = a_plus_bc_mod_q(*a0, *a1, *ElementModQ::fromUint64(order));
+        guardianShares.push_back(
+          computeDecryptionShares(ciphertextRefs, *secret, *rand_q(), ONE_MOD_Q()));
+        shares.emplace_back();
+        for (const auto &share : guardianShares.back()) {
+            shares.back().push_back(*share->getShare());
+        }
+    }
+
+    // Act
+    auto products = combineDecryptionShares(sequenceOrders, shares);
+
+    // Assert
+    REQUIRE(products.size() == ciphertexts.size());
+    for (uint64_t i = 0; i < ciphertexts.size(); i++) {
+        CHECK(*products[i] == *ciphertexts[i]->partialDecrypt(*a0));
+        CHECK(ciphertexts[i]->decrypt(*products[i]) == i % 2);
+    }
+    CHECK_THROWS(combineDecryptionShares({1}, shares));
+}
+
+TEST_CASE("Compensated shares of a missing guardian recover its share of every ciphertext")
+{
+    // Arrange
+    // three guardians with a quorum of two, each holding the polynomial 𝑃𝑖(𝑥) = 𝑎𝑖0 + 𝑎𝑖1𝑥
+    // and publishing the commitments 𝐾𝑖𝑗 = 𝑔^𝑎𝑖𝑗
+    const uint64_t guardians = 3;
+    vector<vector<unique_ptr<ElementModQ>>> coefficients;
+    vector<vector<unique_ptr<ElementModP>>> commitments;
+    auto jointKey = make_unique<ElementModP>(ONE_MOD_P());
+    for (uint64_t i = 0; i < guardians; i++) {
+        coefficients.emplace_back();
+        commitments.emplace_back();
+        for (uint64_t j = 0; j < 2; j++) {
+            coefficients[i].push_back(rand_q());
+            commitments[i].push_back(g_pow_p(*coefficients[i][j]));
+        }
+        jointKey = mul_mod_p(*jointKey, *commitments[i][0]);
+    }
+    auto backup = [&coefficients](uint64_t guardian, uint64_t order) {
+        return a_plus_bc_mod_q(*coefficients[guardian][0], *coefficients[guardian][1],
+                               *ElementModQ::fromUint64(order));
+    };
+
+    vector<unique_ptr<ElGamalCiphertext>> ciphertexts;
+    vector<reference_wrapper<const ElGamalCiphertext>> ciphertextRefs;
+    for (uint64_t i = 0; i < 7; i++) {
+        ciphertexts.push_back(elgamalEncrypt(i % 2, *rand_q(), *jointKey));
+        ciphertextRefs.push_back(*ciphertexts.back());
+    }
+
+    // the guardian with sequence order 2 is missing
+    const uint64_t missing = 1;
+    vector<uint64_t> available{1, 3};
+    vector<reference_wrapper<const ElementModP>> missingCommitments{*commitments[missing][0],
+                                                                    *commitments[missing][1]};
+    auto extendedBaseHash = rand_q();
+    auto seed = rand_q();
+
+    // Act
+    auto recoveryKeys = computeRecoveryPublicKeys({missingCommitments}, available);
+
+    vector<vector<unique_ptr<DecryptionShare>>> compensated;
+    for (auto order : available) {
+        // a second backup shares the tables of the pads with the first
+        auto missingBackup = backup(missing, order);
+        auto otherBackup = backup(0, order);
+        auto shares = computeCompensatedDecryptionShares(
+          ciphertextRefs, {*missingBackup, *otherBackup}, *seed, *extendedBaseHash);
+        REQUIRE(shares.size() == 2);
+        auto otherExpected = computeDecryptionShares(ciphertextRefs, *otherBackup,
+                                                     *Nonces(*seed).get(1), *extendedBaseHash);
+        for (size_t i = 0; i < ciphertexts.size(); i++) {
+            CHECK(*shares[1][i]->getShare() == *otherExpected[i]->getShare());
+            CHECK(*shares[1][i]->getProof()->getResponse() ==
+                  *otherExpected[i]->getProof()->getResponse());
+        }
+        compensated.push_back(move(shares[0]));
+    }
+
+    vector<vector<reference_wrapper<const ElementModP>>> compensatedShares(available.size());
+    for (size_t a = 0; a < available.size(); a++) {
+        for (const auto &share : compensated[a]) {
+            compensatedShares[a].push_back(*share->getShare());
+        }
+    }
+    auto recovered = combineDecryptionShares(available, compensatedShares);
+
+    // Assert
+    REQUIRE(recoveryKeys.size() == 1);
+    REQUIRE(recoveryKeys[0].size() == available.size());
+    for (size_t a = 0; a < available.size(); a++) {
+        CHECK(*recoveryKeys[0][a] == *g_pow_p(*backup(missing, available[a])));
+
+        auto expected = computeDecryptionShares(ciphertextRefs, *backup(missing, available[a]),
+                                                *Nonces(*seed).get(0), *extendedBaseHash);
+        for (size_t i = 0; i < ciphertexts.size(); i++) {
+            auto *share = compensated[a][i]->getShare();
+            auto *proof = compensated[a][i]->getProof();
+            CHECK(*share == *expected[i]->getShare());
+            CHECK(*proof->getChallenge() == *expected[i]->getProof()->getChallenge());
+            CHECK(*proof->getResponse() == *expected[i]->getProof()->getResponse());
+            CHECK(proof->isValid(*ciphertexts[i], *recoveryKeys[0][a], *share,
+                                 *extendedBaseHash) == true);
+        }
+    }
+
+    for (size_t i = 0; i < ciphertexts.size(); i++) {
+        CHECK(*recovered[i] == *ciphertexts[i]->partialDecrypt(*coefficients[missing][0]));
+
+        // the available guardians' own shares with the recovered share decrypt the ciphertext
+        auto product = make_unique<ElementModP>(*recovered[i]);
+        for (auto order : available) {
+            auto share = ciphertexts[i]->partialDecrypt(*coefficients[order - 1][0]);
+            product = mul_mod_p(*product, *share);
+        }
+        CHECK(ciphertexts[i]->decrypt(*product) == i % 2);
+    }
+    CHECK_THROWS(computeRecoveryPublicKeys({{}}, available));
+    CHECK_THROWS(computeRecoveryPublicKeys({missingCommitments}, {0, 1}));
+}
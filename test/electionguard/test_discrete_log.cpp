@@ -4,7 +4,9 @@
 #include <electionguard/discrete_log.hpp>
 #include <electionguard/elgamal.hpp>
 #include <electionguard/group.hpp>
+#include <future>
 #include <unordered_map>
+#include <vector>
 
 using namespace electionguard;
 using namespace std;
@@ -21,3 +23,60 @@ TEST_CASE("Can find discrete log valid value")
     // Assert
     CHECK(result == 100UL);
 }
+
+TEST_CASE("Can find discrete log values across the whole range")
+{
+    // Arrange
+    vector<uint64_t> exponents = {0UL, 1UL, 999UL, 1000UL, 1001UL, 123456UL, DLOG_MAX_SIZE};
+
+    for (auto exponent : exponents) {
+        auto element = g_pow_p(*ElementModQ::fromUint64(exponent));
+
+        // Act
+        auto result = DiscreteLog::getAsync(*element);
+
+        // Assert
+        CHECK(result == exponent);
+    }
+}
+
+TEST_CASE("Discrete log respects the configured max exponent")
+{
+    // Arrange
+    auto beyondDefault = g_pow_p(*ElementModQ::fromUint64(DLOG_MAX_SIZE + 1));
+
+    // Act & Assert
+    CHECK_THROWS(DiscreteLog::getAsync(*beyondDefault));
+
+    DiscreteLog::setMaxExponent(DLOG_MAX_SIZE * 4);
+    CHECK(DiscreteLog::getMaxExponent() == DLOG_MAX_SIZE * 4);
+    CHECK(DiscreteLog::getAsync(*beyondDefault) == DLOG_MAX_SIZE + 1);
+
+    DiscreteLog::setMaxExponent(DLOG_MAX_SIZE);
+    CHECK(DiscreteLog::getMaxExponent() == DLOG_MAX_SIZE);
+    CHECK_THROWS(DiscreteLog::getAsync(*beyondDefault));
+
+    CHECK_THROWS(DiscreteLog::setMaxExponent(DLOG_MAX_SIZE_LIMIT + 1));
+    CHECK(DiscreteLog::getMaxExponent() == DLOG_MAX_SIZE);
+}
+
+TEST_CASE("Can find discrete log values from multiple threads")
+{
+    // Arrange
+    vector<unique_ptr<ElementModP>> elements;
+    for (uint64_t i = 0; i < 8; i++) {
+        elements.push_back(g_pow_p(*ElementModQ::fromUint64(i * 7919UL + 3UL)));
+    }
+
+    // Act
+    vector<future<uint64_t>> results;
+    for (const auto &element : elements) {
+        const auto *pointer = element.get();
+        results.push_back(async(launch::async, [pointer]() { return DiscreteLog::getAsync(*pointer); }));
+    }
+
+    // Assert
+    for (uint64_t i = 0; i < results.size(); i++) {
+        CHECK(results[i].get() == i * 7919UL + 3UL);
+    }
+}
@@ -203,6 +203,94 @@ TEST_CASE("Encrypt PlaintextBallot overvote")
                  ",\"john-adams-selection\"]}"));
 }
 
+TEST_CASE("Encrypt PlaintextBallot in parallel matches the serial encryption")
+{
+    // Arrange
+    auto secret = ElementModQ::fromHex(a_fixed_secret);
+    auto keypair = ElGamalKeyPair::fromSecret(*secret);
+    auto manifest = ManifestGenerator::getJeffersonCountyManifest_Minimal();
+    auto internal = make_unique<InternalManifest>(*manifest);
+    auto context = ElectionGenerator::getFakeContext(*internal, *keypair->getPublicKey());
+    auto codeSeed = TWO_MOD_Q();
+    auto nonce = rand_q();
+    uint64_t timestamp = 12345UL;
+
+    // undervote and overvote ballots
+    for (uint64_t index : {0UL, 2UL}) {
+        auto plaintext = BallotGenerator::getFakeBallot(*internal, index);
+
+        // Act
+        auto serial = encryptBallot(*plaintext, *internal, *context, codeSeed, nonce->clone(),
+                                    timestamp, true, false, false);
+        auto parallel = encryptBallot(*plaintext, *internal, *context, codeSeed,
+                                      nonce->clone(), timestamp, true, false, true);
+
+        // Assert
+        // the proofs use random commitments, everything else is deterministic
+        CHECK(*serial->getBallotCode() == *parallel->getBallotCode());
+        auto serialContests = serial->getContests();
+        auto parallelContests = parallel->getContests();
+        REQUIRE(serialContests.size() == parallelContests.size());
+        for (size_t i = 0; i < serialContests.size(); i++) {
+            const auto &serialContest = serialContests[i].get();
+            const auto &parallelContest = parallelContests[i].get();
+            CHECK(serialContest.getObjectId() == parallelContest.getObjectId());
+            CHECK(*serialContest.getNonce() == *parallelContest.getNonce());
+            CHECK(*serialContest.getCryptoHash() == *parallelContest.getCryptoHash());
+            auto serialSelections = serialContest.getSelections();
+            auto parallelSelections = parallelContest.getSelections();
+            REQUIRE(serialSelections.size() == parallelSelections.size());
+            for (size_t j = 0; j < serialSelections.size(); j++) {
+                const auto &serialSelection = serialSelections[j].get();
+                const auto &parallelSelection = parallelSelections[j].get();
+                CHECK(serialSelection.getObjectId() == parallelSelection.getObjectId());
+                CHECK(*serialSelection.getNonce() == *parallelSelection.getNonce());
+                CHECK(*serialSelection.getCiphertext() == *parallelSelection.getCiphertext());
+                CHECK(*serialSelection.getCryptoHash() == *parallelSelection.getCryptoHash());
+            }
+        }
+    }
+}
+
+TEST_CASE("Encrypt batch of PlaintextBallots returns chained ballots in input order")
+{
+    // Arrange
+    auto secret = ElementModQ::fromHex(a_fixed_secret);
+    auto keypair = ElGamalKeyPair::fromSecret(*secret);
+    auto manifest = ManifestGenerator::getJeffersonCountyManifest_Minimal();
+    auto internal = make_unique<InternalManifest>(*manifest);
+    auto context = ElectionGenerator::getFakeContext(*internal, *keypair->getPublicKey());
+    auto device = make_unique<EncryptionDevice>(12345UL, 23456UL, 34567UL, "Location");
+    auto mediator = make_unique<EncryptionMediator>(*internal, *context, *device);
+
+    vector<unique_ptr<PlaintextBallot>> plaintexts;
+    vector<reference_wrapper<const PlaintextBallot>> batch;
+    for (uint64_t index : {0UL, 1UL, 2UL, 0UL}) {
+        plaintexts.push_back(BallotGenerator::getFakeBallot(*internal, index));
+        batch.push_back(*plaintexts.back());
+    }
+
+    // Act
+    auto first = mediator->encrypt(*plaintexts.front());
+    auto ciphertexts = mediator->encrypt(batch);
+    auto last = mediator->encrypt(*plaintexts.back());
+
+    // Assert
+    REQUIRE(ciphertexts.size() == plaintexts.size());
+    for (size_t i = 0; i < ciphertexts.size(); i++) {
+        CHECK(ciphertexts[i]->getObjectId() == plaintexts[i]->getObjectId());
+        const auto &expectedSeed = i == 0 ? *first->getBallotCode()
+                                          : *ciphertexts[i - 1]->getBallotCode();
+        CHECK(*ciphertexts[i]->getBallotCodeSeed() == expectedSeed);
+        CHECK(ciphertexts[i]->isValidEncryption(*context->getManifestHash(),
+                                                *keypair->getPublicKey(),
+                                                *context->getCryptoExtendedBaseHash()));
+    }
+    // the mediator continues the chain after the batch
+    CHECK(*last->getBallotCodeSeed() == *ciphertexts.back()->getBallotCode());
+    CHECK(encryptBallots({}, *internal, *context, TWO_MOD_Q()).empty());
+}
+
 TEST_CASE("Encrypt simple PlaintextBallot with EncryptionMediator succeeds")
 {
     auto secret = ElementModQ::fromHex(a_fixed_secret);
@@ -2,6 +2,7 @@
 #include "../../src/electionguard/convert.hpp"
 #include "../../src/electionguard/facades/bignum4096.hpp"
 #include "../../src/electionguard/log.hpp"
+#include "../../src/electionguard/lookup_table.hpp"
 #include "../../src/electionguard/utils.hpp"
 #include "utils/byte_logger.hpp"
 #include "utils/constants.hpp"
@@ -14,6 +15,7 @@
 #include <exception>
 #include <iostream>
 #include <string>
+#include <thread>
 
 using namespace electionguard;
 using namespace electionguard::facades;
@@ -502,7 +504,8 @@ TEST_CASE("add_mod_p (MAX_4096 + 1) % P = offset + 1")
     auto max = make_unique<ElementModP>(MAX_4096, true);
     auto one = ElementModP::fromUint64(1UL);
     auto offset = make_unique<ElementModP>(P_ARRAY_INVERSE_OFFSET, true);
-    auto _ = Bignum4096::add(offset->get(), ONE_MOD_P().get(), offset->get());
+    auto _ = Bignum4096::add(offset->getMutable(), const_cast<uint64_t *>(ONE_MOD_P().get()),
+                             offset->getMutable());
 
     // Act
     auto result = add_mod_p(*max, *one);
@@ -598,10 +601,182 @@ TEST_CASE("pow_mod_p 2 ^ 3 = 8 and 3 ^ 2 = 9")
     CHECK((*result9 == *nine));
 }
 
+TEST_CASE("multi_pow_mod_p matches the product of each pow_mod_p")
+{
+    // Arrange
+    vector<unique_ptr<ElementModP>> bases;
+    vector<unique_ptr<ElementModQ>> exponents;
+    for (uint64_t i = 0; i < 70; i++) {
+        bases.push_back(g_pow_p(*rand_q()));
+        exponents.push_back(i % 3 == 0 ? ElementModQ::fromUint64(i * 7919) : rand_q());
+    }
+    exponents[1] = ZERO_MOD_Q().clone();
+
+    vector<reference_wrapper<const ElementModP>> baseRefs;
+    vector<reference_wrapper<const ElementModQ>> exponentRefs;
+    auto expected = ElementModP::fromUint64(1UL);
+    for (size_t i = 0; i < bases.size(); i++) {
+        baseRefs.push_back(*bases[i]);
+        exponentRefs.push_back(*exponents[i]);
+        expected = mul_mod_p(*expected, *pow_mod_p(*bases[i], *exponents[i]));
+    }
+
+    // Act
+    auto actual = multi_pow_mod_p(baseRefs, exponentRefs);
+    auto withFixedBase = multi_pow_mod_p({G(), *bases[0]}, {*exponents[2], *exponents[3]});
+    auto empty = multi_pow_mod_p({}, {});
+
+    // Assert
+    CHECK((*actual == *expected));
+    CHECK((*withFixedBase ==
+           *mul_mod_p(*g_pow_p(*exponents[2]), *pow_mod_p(*bases[0], *exponents[3]))));
+    CHECK((*empty == ONE_MOD_P()));
+    CHECK_THROWS(multi_pow_mod_p({G()}, {}));
+}
+
+TEST_CASE("In place operations match the allocating operations when the output aliases an input")
+{
+    // Arrange
+    auto p1 = rand_p();
+    auto p2 = rand_p();
+    auto q1 = rand_q();
+    auto q2 = rand_q();
+    auto q3 = rand_q();
+
+    ElementModP product = *p1;
+    ElementModP power = *p1;
+    ElementModP gPower;
+    ElementModQ sum = *q1;
+    ElementModQ difference = *q1;
+    ElementModQ qProduct = *q1;
+    ElementModQ aPlusBc = *q1;
+
+    // Act
+    mul_mod_p_into(product, product, *p2);
+    pow_mod_p_into(power, power, *q2);
+    g_pow_p_into(gPower, *q2);
+    add_mod_q_into(sum, sum, *q2);
+    sub_mod_q_into(difference, difference, *q2);
+    mul_mod_q_into(qProduct, qProduct, *q2);
+    a_plus_bc_mod_q_into(aPlusBc, aPlusBc, *q2, *q3);
+
+    // Assert
+    CHECK((product == *mul_mod_p(*p1, *p2)));
+    CHECK((power == *pow_mod_p(*p1, *q2)));
+    CHECK((gPower == *g_pow_p(*q2)));
+    CHECK(!gPower.isFixedBase());
+    CHECK((sum == *add_mod_q(*q1, *q2)));
+    CHECK((difference == *sub_mod_q(*q1, *q2)));
+    CHECK((qProduct == *mul_mod_q(*q1, *q2)));
+    CHECK((aPlusBc == *a_plus_bc_mod_q(*q1, *q2, *q3)));
+    CHECK((ElementModP() == ZERO_MOD_P()));
+    CHECK((ElementModQ() == ZERO_MOD_Q()));
+}
+
+TEST_CASE("MontgomeryElementModP chains match mul_mod_p and pow_mod_p")
+{
+    // Arrange
+    vector<unique_ptr<ElementModP>> elements;
+    auto expected = ElementModP::fromUint64(1UL);
+    for (uint64_t i = 0; i < 10; i++) {
+        elements.push_back(rand_p());
+        expected = mul_mod_p(*expected, *elements.back());
+    }
+    auto exponent = rand_q();
+
+    // Act
+    MontgomeryElementModP product;
+    for (const auto &element : elements) {
+        product *= *element;
+    }
+    auto power = MontgomeryElementModP(*elements[0]).pow(*exponent);
+    auto zeroPower = MontgomeryElementModP(*elements[0]).pow(ZERO_MOD_Q());
+    auto square = MontgomeryElementModP(*elements[1]) * MontgomeryElementModP(*elements[1]);
+
+    // Assert
+    CHECK((*product.toElementModP() == *expected));
+    CHECK((*power.toElementModP() == *pow_mod_p(*elements[0], *exponent)));
+    CHECK((zeroPower == MontgomeryElementModP()));
+    CHECK((*square.toElementModP() == *mul_mod_p(*elements[1], *elements[1])));
+    CHECK((*MontgomeryElementModP(*elements[2]).toElementModP() == *elements[2]));
+    CHECK((MontgomeryElementModP(*elements[2]) != MontgomeryElementModP(*elements[3])));
+}
+
 #pragma endregion
 
 #pragma region g_pow_p
 
+TEST_CASE("ElementModP forgets it is a valid residue once its limbs are written")
+{
+    // Arrange
+    auto element = g_pow_p(*rand_q());
+    auto base = G();
+    REQUIRE(element->isValidResidue());
+    base.setIsFixedBase(true);
+
+    // Act
+    element->getMutable()[0] ^= 1;
+    base.getMutable();
+
+    // Assert
+    CHECK_FALSE(element->isValidResidue());
+    CHECK_FALSE(base.isFixedBase());
+}
+
+TEST_CASE("isValidResidueBatch matches isValidResidue for each element")
+{
+    // Arrange
+    uint64_t pMinusOne[MAX_P_LEN] = {};
+    memcpy(pMinusOne, P().get(), MAX_P_SIZE);
+    pMinusOne[0] -= 1;
+
+    // an element of order (p - 1) / 2q is a quadratic residue outside of Z^r_p
+    auto twoQ = add_mod_p(*Q().toElementModP(), *Q().toElementModP());
+    auto cofactorElement = pow_mod_p(*rand_p(), *twoQ);
+
+    vector<unique_ptr<ElementModP>> elements;
+    for (uint64_t i = 0; i < 4; i++) {
+        elements.push_back(g_pow_p(*rand_q()));
+    }
+    elements.push_back(make_unique<ElementModP>(pMinusOne, true));
+    elements.push_back(mul_mod_p(*elements[0], *cofactorElement));
+    elements.push_back(rand_p());
+    elements.push_back(ZERO_MOD_P().clone());
+    elements.push_back(g_pow_p(*rand_q()));
+
+    vector<reference_wrapper<const ElementModP>> refs;
+    for (const auto &element : elements) {
+        refs.push_back(*element);
+    }
+
+    // Act
+    auto results = ElementModP::isValidResidueBatch(refs);
+    auto fresh1 = g_pow_p(*rand_q());
+    auto fresh2 = g_pow_p(*rand_q());
+    auto fresh3 = g_pow_p(*rand_q());
+    auto residues = ElementModP::isValidResidueBatch({*fresh1, *fresh2, *fresh3});
+
+    // the order two components cancel out in the product of the negated elements
+    auto negated1 = mul_mod_p(*elements[4], *fresh1);
+    auto negated2 = mul_mod_p(*elements[4], *fresh2);
+    auto negated = ElementModP::isValidResidueBatch({*negated1, *negated2});
+
+    // Assert
+    REQUIRE(results.size() == elements.size());
+    for (size_t i = 0; i < elements.size(); i++) {
+        auto copy = *elements[i];
+        CHECK(results[i] == ElementModP(elements[i]->ref(), true).isValidResidue());
+        CHECK(results[i] == copy.isValidResidue());
+    }
+    CHECK(results[0]);
+    CHECK(!results[4]);
+    CHECK(!results[5]);
+    CHECK(!results[7]);
+    CHECK(residues == vector<bool>{true, true, true});
+    CHECK(negated == vector<bool>{false, false});
+    CHECK(ElementModP::isValidResidueBatch({}).empty());
+}
+
 TEST_CASE("g_pow_p with hex conversion")
 {
     // Arrange
@@ -615,6 +790,113 @@ TEST_CASE("g_pow_p with hex conversion")
     CHECK(test2->toHex() == result->toHex());
 }
 
+template <uint64_t WindowSize> void checkLookupTableWindow()
+{
+    auto base = g_pow_p(*rand_q());
+    auto exponent = rand_q();
+    auto expected = pow_mod_p(*base, *exponent);
+
+    auto table = make_unique<LookupTable<WindowSize>>(base->get());
+    auto actual = ElementModP(table->pow_mod_p(exponent->ref()), true);
+
+    CHECK((actual == *expected));
+}
+
+TEST_CASE("LookupTable windows that are not byte aligned match pow_mod_p")
+{
+    checkLookupTableWindow<4>();
+    checkLookupTableWindow<5>();
+    checkLookupTableWindow<7>();
+}
+
+TEST_CASE("Registered fixed base matches pow_mod_p without a lookup table")
+{
+    // Arrange
+    auto base = g_pow_p(*rand_q());
+    auto copy = make_unique<ElementModP>(*base);
+    auto exponent = rand_q();
+    auto expected = pow_mod_p(*base, *exponent);
+
+    // Act
+    registerFixedBase(*base);
+    registerFixedBase(*copy);
+    auto actual = pow_mod_p(*base, *exponent);
+    auto firstRelease = releaseFixedBase(*base);
+    auto stillFixed = base->isFixedBase();
+    auto fromCopy = pow_mod_p(*copy, *exponent);
+    auto secondRelease = releaseFixedBase(*copy);
+    // the base is still flagged so this generates a table that was never registered
+    auto fromLazyTable = pow_mod_p(*base, *exponent);
+    auto neverRegistered = releaseFixedBase(*base);
+
+    // Assert
+    CHECK((*actual == *expected));
+    CHECK((*fromCopy == *expected));
+    CHECK(firstRelease == false);
+    CHECK(stillFixed == true);
+    CHECK(secondRelease == true);
+    CHECK(copy->isFixedBase() == false);
+    CHECK((*fromLazyTable == *expected));
+    CHECK(neverRegistered == false);
+    CHECK(LookupTableContext::getFixedBase(base->ref()) != nullptr);
+}
+
+TEST_CASE("Concurrent exponentiations of a new fixed base share one lookup table")
+{
+    // Arrange
+    auto base = g_pow_p(*rand_q());
+    auto exponent = rand_q();
+    auto expected = pow_mod_p(*base, *exponent);
+    base->setIsFixedBase(true);
+
+    // Act
+    vector<unique_ptr<ElementModP>> actual(4);
+    vector<shared_ptr<const LookupTableType>> tables(actual.size());
+    vector<thread> threads;
+    for (size_t i = 0; i < actual.size(); i++) {
+        threads.emplace_back([&, i]() {
+            actual[i] = pow_mod_p(*base, *exponent);
+            tables[i] = LookupTableContext::getFixedBase(base->ref());
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    // Assert
+    for (size_t i = 0; i < actual.size(); i++) {
+        CHECK((*actual[i] == *expected));
+        CHECK(tables[i] != nullptr);
+        CHECK(tables[i] == tables[0]);
+    }
+}
+
+TEST_CASE("Saved fixed base lookup table loads and matches pow_mod_p")
+{
+    // Arrange
+    const auto *path = "fixed_base_test_table.bin";
+    auto base = g_pow_p(*rand_q());
+    auto otherBase = g_pow_p(*rand_q());
+    auto exponent = rand_q();
+    auto expected = pow_mod_p(*base, *exponent);
+
+    // drop the table generated by the save so the load maps the file
+    saveFixedBase(*base, path);
+    registerFixedBase(*base);
+    releaseFixedBase(*base);
+
+    // Act
+    loadFixedBase(*base, path);
+    auto actual = pow_mod_p(*base, *exponent);
+
+    // Assert
+    CHECK(base->isFixedBase() == true);
+    CHECK((*actual == *expected));
+    CHECK_THROWS(loadFixedBase(*otherBase, path));
+    CHECK(releaseFixedBase(*base) == true);
+    std::remove(path);
+}
+
 TEST_CASE("Test g_pow_p with 0, 1, and 2")
 {
     // Arrange
@@ -657,7 +939,8 @@ TEST_CASE("Test bignum 32-bit g_pow_p with random using context")
 
     // Act
     uint64_t result[MAX_P_LEN] = {};
-    CONTEXT_P().modExp(G().get(), MAX_P_SIZE, e->get(), static_cast<uint64_t *>(result));
+    CONTEXT_P().modExp(const_cast<uint64_t *>(G().get()), MAX_P_SIZE, e->getMutable(),
+                       static_cast<uint64_t *>(result));
     auto actual = make_unique<ElementModP>(result, true);
     auto expected = g_pow_p(*e);
 
@@ -676,7 +959,7 @@ TEST_CASE("Test bignum 32-bit g_pow_p with random")
 
     // Act
     uint64_t result[MAX_P_LEN] = {};
-    instance.modExp(g.get(), MAX_P_SIZE, e->get(), static_cast<uint64_t *>(result));
+    instance.modExp(g.getMutable(), MAX_P_SIZE, e->getMutable(), static_cast<uint64_t *>(result));
     auto expected = g_pow_p(*e);
     auto actual = make_unique<ElementModP>(result, true);
 
@@ -702,6 +985,28 @@ TEST_CASE("Max of Q + 1 throws")
                       "Value for ElementModQ is greater than allowed");
 }
 
+TEST_CASE("fromUint64 checks the value against the modulus unless unchecked")
+{
+    // Arrange
+    const uint64_t max = 0xffffffffffffffff;
+
+    // Act
+    auto uncheckedP = ElementModP::fromUint64(max, true);
+    auto uncheckedQ = ElementModQ::fromUint64(max, true);
+
+    // Assert
+    CHECK(uncheckedP->get()[0] == max);
+    CHECK(uncheckedQ->get()[0] == max);
+#ifdef USE_TEST_PRIMES
+    // the test primes fit in a single limb
+    CHECK_THROWS(ElementModP::fromUint64(max));
+    CHECK_THROWS(ElementModQ::fromUint64(max));
+#else
+    CHECK(*ElementModP::fromUint64(max) == *uncheckedP);
+    CHECK(*ElementModQ::fromUint64(max) == *uncheckedQ);
+#endif
+}
+
 TEST_CASE("Hex string converted to Q matches original hex when converted back toHex")
 {
     // Arrange
@@ -114,3 +114,41 @@ TEST_CASE("Same Hash Value from nested-list and result of hashed list by hashing
     // but different addresses
     CHECK(&nestedHash != &nonNestedHash2);
 }
+
+class FixedHashable : public CryptoHashable
+{
+  public:
+    unique_ptr<ElementModQ> crypto_hash() override { return ElementModQ::fromUint64(1UL); }
+    unique_ptr<ElementModQ> crypto_hash() const override { return ElementModQ::fromUint64(2UL); }
+};
+
+TEST_CASE("Hash of every hashable type matches the known digest")
+{
+    // Arrange
+    FixedHashable hashable;
+    const FixedHashable &constHashable = hashable;
+    auto small = ElementModP::fromUint64(255UL);
+    auto smallQ = ElementModQ::fromUint64(0x1234UL);
+    vector<ElementModP *> elements = {const_cast<ElementModP *>(&G()), small.get()};
+    vector<reference_wrapper<const ElementModQ>> qs = {*smallQ, ZERO_MOD_Q()};
+    vector<uint64_t> numbers = {0UL, 7UL, 18446744073709551615UL};
+    vector<string> strings = {"", "abc"};
+    vector<uint8_t> bytes = {0, 0, 1, 171};
+
+    // Act
+    auto result = hash_elems({nullptr, &const_cast<ElementModP &>(P()), small.get(), smallQ.get(),
+                              ZERO_MOD_Q(), 0UL, 12345UL, string(""), string("value"), elements,
+                              qs, numbers, strings, vector<uint64_t>{}, bytes,
+                              vector<uint8_t>{0, 0}, &hashable, constHashable,
+                              vector<CryptoHashable *>{&hashable}});
+    auto single = hash_elems(G());
+    auto empty = hash_elems(vector<CryptoHashableType>{});
+
+    // Assert
+    CHECK(result->toHex() ==
+          "B4782904136DFB71FB6636C49A494C97483A6DD2A10BC45D1A9A35EF568DFD05");
+    CHECK(single->toHex() ==
+          "CEE16D85143BB76739CA780A96CCB54462D58C04664F4166F28A5361442D4B17");
+    CHECK(empty->toHex() ==
+          "4B9729549DA6FBF91219C4D2D4878F0D9F443F92D013C6C768F96BA81C7CCAEE");
+}
@@ -5,6 +5,7 @@
 #include <doctest/doctest.h>
 #include <electionguard/election.hpp>
 #include <electionguard/elgamal.hpp>
+#include <electionguard/hash.hpp>
 #include <electionguard/manifest.hpp>
 
 using namespace electionguard;
@@ -48,6 +49,62 @@ TEST_CASE("Can construct InternalManifest from Sample Manifest")
     CHECK(data->getContests().size() == result->getContests().size());
 }
 
+TEST_CASE("InternalManifest description hashes match freshly computed hashes")
+{
+    // Arrange
+    auto data = ManifestGenerator::getJeffersonCountyManifest_Minimal();
+
+    // Act
+    auto result = make_unique<InternalManifest>(*data);
+
+    // Assert
+    for (const auto &contest : result->getContests()) {
+        const ContestDescription fresh(contest.get());
+        CHECK(*contest.get().crypto_hash() == *fresh.crypto_hash());
+        CHECK(*contest.get().crypto_hash() == *contest.get().crypto_hash());
+
+        for (const auto &selection : contest.get().getSelections()) {
+            auto expected = hash_elems({selection.get().getObjectId(),
+                                        selection.get().getSequenceOrder(),
+                                        selection.get().getCandidateId()});
+            CHECK(*selection.get().crypto_hash() == *expected);
+        }
+    }
+}
+
+TEST_CASE("InternalManifest indexed lookups match the manifest contents")
+{
+    // Arrange
+    auto data = ManifestGenerator::getJeffersonCountyManifest_Minimal();
+
+    // Act
+    auto result = make_unique<InternalManifest>(*data);
+
+    // Assert
+    for (const auto &style : result->getBallotStyles()) {
+        CHECK(result->getBallotStyle(style.get().getObjectId()) == &style.get());
+
+        auto gpUnitIds = style.get().getGeopoliticalUnitIds();
+        uint64_t previousSequenceOrder = 0;
+        for (const auto &contest : result->getContestsFor(style.get().getObjectId())) {
+            CHECK(find(gpUnitIds.begin(), gpUnitIds.end(),
+                       contest.get().getElectoralDistrictId()) != gpUnitIds.end());
+            CHECK(contest.get().getSequenceOrder() >= previousSequenceOrder);
+            previousSequenceOrder = contest.get().getSequenceOrder();
+        }
+    }
+    for (const auto &contest : result->getContests()) {
+        CHECK(result->getContest(contest.get().getObjectId()) == &contest.get());
+    }
+    for (const auto &candidate : result->getCandidates()) {
+        CHECK(result->getCandidate(candidate.get().getObjectId()) == &candidate.get());
+    }
+    CHECK(result->getBallotStyle("not-a-style") == nullptr);
+    CHECK(result->getContest("not-a-contest") == nullptr);
+    CHECK(result->getCandidate("not-a-candidate") == nullptr);
+    CHECK_THROWS(result->getContestsFor("not-a-style"));
+}
+
 TEST_CASE("Can serialize InternalManifest")
 {
     // Arrange
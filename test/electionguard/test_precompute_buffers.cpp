@@ -0,0 +1,414 @@
+#include "../../src/electionguard/log.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <doctest/doctest.h>
+#include <electionguard/async.hpp>
+#include <electionguard/constants.h>
+#include <electionguard/elgamal.hpp>
+#include <electionguard/group.hpp>
+#include <electionguard/precompute_buffers.hpp>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+using namespace electionguard;
+using namespace std;
+
+TEST_CASE("PrecomputeBuffer startAsync fills the queue to the max size")
+{
+    // Arrange
+    const auto &secret = TWO_MOD_Q();
+    auto keypair = ElGamalKeyPair::fromSecret(secret, false);
+    const uint32_t maxQueueSize = 8;
+    PrecomputeBuffer buffer(*keypair->getPublicKey(), maxQueueSize);
+
+    // Act
+    buffer.startAsync();
+    auto deadline = chrono::steady_clock::now() + chrono::seconds(60);
+    while (buffer.getCurrentQueueSize() < maxQueueSize && chrono::steady_clock::now() < deadline) {
+        this_thread::sleep_for(chrono::milliseconds(10));
+    }
+    buffer.stop();
+
+    // Assert
+    CHECK(buffer.getCurrentQueueSize() == maxQueueSize);
+    for (uint32_t i = 0; i < maxQueueSize; i++) {
+        auto result = buffer.popTwoTriplesAndAQuadruple();
+        REQUIRE((result.has_value() && result.value() != nullptr));
+        auto triple = result.value()->get_triple1();
+        CHECK((*triple->get_g_to_exp() == *g_pow_p(*triple->get_exp())));
+        CHECK((*triple->get_pubkey_to_exp() ==
+               *pow_mod_p(*keypair->getPublicKey(), *triple->get_exp())));
+    }
+    CHECK(buffer.getCurrentQueueSize() == 0);
+}
+
+TEST_CASE("PrecomputeBuffer stop cancels the background producers")
+{
+    // Arrange
+    const auto &secret = TWO_MOD_Q();
+    auto keypair = ElGamalKeyPair::fromSecret(secret, false);
+    PrecomputeBuffer buffer(*keypair->getPublicKey(), DEFAULT_PRECOMPUTE_SIZE);
+
+    // Act
+    buffer.startAsync();
+    buffer.stop();
+    auto stoppedSize = buffer.getCurrentQueueSize();
+    this_thread::sleep_for(chrono::milliseconds(100));
+
+    // Assert
+    CHECK(stoppedSize < DEFAULT_PRECOMPUTE_SIZE);
+    CHECK(buffer.getCurrentQueueSize() == stoppedSize);
+}
+
+TEST_CASE("PrecomputeBuffer startAsync does not delay scheduled tasks")
+{
+    // Arrange
+    const auto &secret = TWO_MOD_Q();
+    auto keypair = ElGamalKeyPair::fromSecret(secret, false);
+    PrecomputeBuffer buffer(*keypair->getPublicKey(), DEFAULT_PRECOMPUTE_SIZE);
+    buffer.startAsync();
+
+    // Act
+    vector<future<uint32_t>> tasks;
+    for (uint32_t i = 0; i < Scheduler::getThreadCount() * 2; i++) {
+        tasks.push_back(Scheduler::submit([i]() { return i; }));
+    }
+    auto results = when_all(tasks);
+    auto sizeWhenDone = buffer.getCurrentQueueSize();
+    buffer.stop();
+
+    // Assert
+    CHECK(results.size() == Scheduler::getThreadCount() * 2);
+    CHECK(sizeWhenDone < DEFAULT_PRECOMPUTE_SIZE);
+}
+
+TEST_CASE("PrecomputeBufferContext startAsync can be stopped and cleared")
+{
+    // Arrange
+    const auto &secret = TWO_MOD_Q();
+    auto keypair = ElGamalKeyPair::fromSecret(secret, false);
+
+    // Act
+    PrecomputeBufferContext::startAsync(*keypair->getPublicKey());
+    PrecomputeBufferContext::stop();
+    auto quad = PrecomputeBufferContext::getTwoTriplesAndAQuadruple();
+    PrecomputeBufferContext::clear();
+
+    // Assert
+    CHECK(quad != nullptr);
+}
+
+TEST_CASE("TwoTriplesAndAQuadruple round trips through a precomputed record")
+{
+    // Arrange
+    const auto &secret = TWO_MOD_Q();
+    auto keypair = ElGamalKeyPair::fromSecret(secret, false);
+    PrecomputeBuffer buffer(*keypair->getPublicKey(), 1);
+    auto expected = buffer.getTwoTriplesAndAQuadruple();
+
+    // Act
+    PrecomputedSelectionRecord record;
+    expected->toRecord(record);
+    auto actual = TwoTriplesAndAQuadruple::fromRecord(record);
+
+    // Assert
+    CHECK((*actual->get_triple1()->get_exp() == *expected->get_triple1()->get_exp()));
+    CHECK((*actual->get_triple2()->get_pubkey_to_exp() ==
+           *expected->get_triple2()->get_pubkey_to_exp()));
+    CHECK((*actual->get_quad()->get_exp2() == *expected->get_quad()->get_exp2()));
+    CHECK((*actual->get_quad()->get_g_to_exp2_mult_by_pubkey_to_exp1() ==
+           *expected->get_quad()->get_g_to_exp2_mult_by_pubkey_to_exp1()));
+}
+
+TEST_CASE("AsyncRingBuffer is bounded and delivers every item once across threads")
+{
+    // Arrange
+    const uint64_t itemCount = 10000;
+    AsyncRingBuffer<uint64_t> ring(64);
+    std::atomic<uint64_t> sum = 0;
+    std::atomic<uint64_t> popped = 0;
+
+    // Act
+    vector<thread> threads;
+    for (uint64_t p = 0; p < 4; p++) {
+        threads.emplace_back([&ring, p, itemCount]() {
+            for (uint64_t i = p; i < itemCount; i += 4) {
+                while (!ring.push(i + 1)) {
+                    this_thread::yield();
+                }
+            }
+        });
+        threads.emplace_back([&ring, &sum, &popped, itemCount]() {
+            uint64_t value = 0;
+            while (popped < itemCount) {
+                if (ring.pop(value)) {
+                    sum += value;
+                    popped++;
+                } else {
+                    this_thread::yield();
+                }
+            }
+        });
+    }
+    for (auto &t : threads) {
+        t.join();
+    }
+
+    // Assert
+    CHECK(popped == itemCount);
+    CHECK(sum == itemCount * (itemCount + 1) / 2);
+    CHECK(ring.empty());
+    for (uint64_t i = 0; i < ring.capacity(); i++) {
+        CHECK(ring.push(i));
+    }
+    CHECK_FALSE(ring.push(0));
+}
+
+TEST_CASE("AsyncRingBuffer pop clears the cell after copying the value out")
+{
+    // Arrange
+    AsyncRingBuffer<uint64_t> ring(2);
+    REQUIRE(ring.push(7));
+    uint64_t value = 0;
+    uint64_t cleared = 0;
+
+    // Act
+    auto result = ring.pop(value, [&cleared](uint64_t &cell) {
+        cleared = cell;
+        cell = 0;
+    });
+
+    // Assert
+    CHECK(result);
+    CHECK(value == 7);
+    CHECK(cleared == 7);
+    CHECK_FALSE(ring.pop(value, [&cleared](uint64_t &) { cleared = 0; }));
+    CHECK(cleared == 7);
+}
+
+TEST_CASE("PrecomputeBuffer auto populate refills below the low watermark")
+{
+    // Arrange
+    const auto &secret = TWO_MOD_Q();
+    auto keypair = ElGamalKeyPair::fromSecret(secret, false);
+    const uint32_t maxQueueSize = 8;
+    PrecomputeBuffer buffer(*keypair->getPublicKey(), maxQueueSize, true);
+    buffer.setWatermarks(4, maxQueueSize);
+    buffer.start();
+    CHECK(buffer.getCurrentQueueSize() == maxQueueSize);
+
+    // Act
+    for (uint32_t i = 0; i < 5; i++) {
+        auto result = buffer.popTwoTriplesAndAQuadruple();
+        CHECK((result.has_value() && result.value() != nullptr));
+    }
+    auto deadline = chrono::steady_clock::now() + chrono::seconds(60);
+    while (buffer.getCurrentQueueSize() < maxQueueSize && chrono::steady_clock::now() < deadline) {
+        this_thread::sleep_for(chrono::milliseconds(10));
+    }
+    buffer.stop();
+
+    // Assert
+    CHECK(buffer.getCurrentQueueSize() == maxQueueSize);
+}
+
+TEST_CASE("PrecomputeBuffer auto populate refill does not delay scheduled tasks")
+{
+    // Arrange
+    const auto &secret = TWO_MOD_Q();
+    auto keypair = ElGamalKeyPair::fromSecret(secret, false);
+    PrecomputeBuffer buffer(*keypair->getPublicKey(), DEFAULT_PRECOMPUTE_SIZE, true);
+    buffer.setWatermarks(4, 8);
+    buffer.start();
+    buffer.setWatermarks(4, DEFAULT_PRECOMPUTE_SIZE);
+
+    // Act
+    for (uint32_t i = 0; i < 5; i++) {
+        buffer.popTwoTriplesAndAQuadruple();
+    }
+    vector<future<uint32_t>> tasks;
+    for (uint32_t i = 0; i < Scheduler::getThreadCount() * 2; i++) {
+        tasks.push_back(Scheduler::submit([i]() { return i; }));
+    }
+    auto results = when_all(tasks);
+    auto sizeWhenDone = buffer.getCurrentQueueSize();
+    buffer.stop();
+
+    // Assert
+    CHECK(results.size() == Scheduler::getThreadCount() * 2);
+    CHECK(sizeWhenDone < DEFAULT_PRECOMPUTE_SIZE);
+}
+
+TEST_CASE("PrecomputeBuffer triple watermarks follow the observed demand")
+{
+    // Arrange
+    const auto &secret = TWO_MOD_Q();
+    auto keypair = ElGamalKeyPair::fromSecret(secret, false);
+    PrecomputeBuffer tripleHeavy(*keypair->getPublicKey(), 30);
+    PrecomputeBuffer quadHeavy(*keypair->getPublicKey(), 30);
+
+    // two triples for every three quadruples until there is demand
+    CHECK(tripleHeavy.getTripleHighWatermark() == 20);
+
+    // Act
+    for (uint32_t i = 0; i < 30; i++) {
+        tripleHeavy.popTriple();
+        quadHeavy.popTwoTriplesAndAQuadruple();
+    }
+
+    // Assert
+    CHECK(tripleHeavy.getTripleHighWatermark() == 30);
+    CHECK(quadHeavy.getTripleHighWatermark() == 2);
+    CHECK(quadHeavy.getTripleLowWatermark() == 1);
+}
+
+TEST_CASE("PrecomputeBuffer rejects invalid watermarks")
+{
+    const auto &secret = TWO_MOD_Q();
+    auto keypair = ElGamalKeyPair::fromSecret(secret, false);
+    PrecomputeBuffer buffer(*keypair->getPublicKey(), 8);
+
+    CHECK_THROWS(buffer.setWatermarks(2, 9));
+    CHECK_THROWS(buffer.setWatermarks(5, 4));
+    CHECK_THROWS(buffer.setWatermarks(0, 0));
+    CHECK_NOTHROW(buffer.setWatermarks(0, 8));
+}
+
+TEST_CASE("PrecomputeBuffer save and load uses each pooled value at most once")
+{
+    // Arrange
+    const auto &secret = TWO_MOD_Q();
+    auto keypair = ElGamalKeyPair::fromSecret(secret, false);
+    const auto *path = "precompute_buffer_test_pool.bin";
+    const uint32_t maxQueueSize = 4;
+    {
+        PrecomputeBuffer generator(*keypair->getPublicKey(), maxQueueSize);
+        generator.start();
+        generator.stop();
+        generator.save(path);
+        CHECK(generator.getCurrentQueueSize() == 0);
+    }
+
+    // Act
+    uint32_t loadedCount = 0;
+    {
+        PrecomputeBuffer first(*keypair->getPublicKey(), 2);
+        first.load(path);
+        CHECK(first.getCurrentQueueSize() == 2);
+
+        // the pool can only be consumed by one owner at a time
+        PrecomputeBuffer concurrent(*keypair->getPublicKey(), 2);
+        CHECK_THROWS(concurrent.load(path));
+
+        auto quad = first.popTwoTriplesAndAQuadruple();
+        REQUIRE((quad.has_value() && quad.value() != nullptr));
+        auto triple = quad.value()->get_triple1();
+        CHECK((*triple->get_g_to_exp() == *g_pow_p(*triple->get_exp())));
+        loadedCount += 1 + first.getCurrentQueueSize();
+    }
+    {
+        // the values loaded into the first buffer are consumed,
+        // the ones it did not load are still in the pool
+        PrecomputeBuffer second(*keypair->getPublicKey(), maxQueueSize);
+        second.load(path);
+        loadedCount += second.getCurrentQueueSize();
+        CHECK(second.getCurrentQueueSize() == maxQueueSize - 2);
+    }
+
+    // Assert
+    CHECK(loadedCount == maxQueueSize);
+    auto otherKeypair = ElGamalKeyPair::fromSecret(*rand_q(), false);
+    PrecomputeBuffer other(*otherKeypair->getPublicKey(), maxQueueSize);
+    CHECK_THROWS(other.load(path));
+    std::remove(path);
+}
+
+TEST_CASE("PrecomputeBuffer load rejects a pool header with impossible counts")
+{
+    // Arrange
+    const auto &secret = TWO_MOD_Q();
+    auto keypair = ElGamalKeyPair::fromSecret(secret, false);
+    const auto *path = "precompute_buffer_test_corrupt_pool.bin";
+    {
+        PrecomputeBuffer generator(*keypair->getPublicKey(), 2);
+        generator.start();
+        generator.stop();
+        generator.save(path);
+    }
+
+    // the triple count follows the magic and four 32-bit fields of the header
+    // and the triple cursor follows the counts and the public key hash
+    const streamoff tripleCountOffset = 8 + 4 * 4;
+    const streamoff tripleCursorOffset = tripleCountOffset + 2 * 8 + MAX_Q_SIZE;
+    auto overwrite = [path](streamoff offset, uint64_t value) {
+        fstream file(path, ios::binary | ios::in | ios::out);
+        file.seekp(offset);
+        file.write(reinterpret_cast<const char *>(&value), sizeof(value));
+    };
+    auto read = [path](streamoff offset) {
+        uint64_t value = 0;
+        ifstream file(path, ios::binary);
+        file.seekg(offset);
+        file.read(reinterpret_cast<char *>(&value), sizeof(value));
+        return value;
+    };
+    auto tripleCount = read(tripleCountOffset);
+    PrecomputeBuffer buffer(*keypair->getPublicKey(), 2);
+
+    // Act & Assert
+    overwrite(tripleCursorOffset, tripleCount + 1);
+    CHECK_THROWS(buffer.load(path));
+
+    overwrite(tripleCursorOffset, 0);
+    overwrite(tripleCountOffset, 0xffffffffffffffff);
+    CHECK_THROWS(buffer.load(path));
+
+    overwrite(tripleCountOffset, tripleCount);
+    buffer.load(path);
+    CHECK(buffer.getCurrentQueueSize() == 2);
+    std::remove(path);
+}
+
+TEST_CASE("PrecomputeBufferContext keeps a buffer for each election public key")
+{
+    // Arrange
+    auto keypair1 = ElGamalKeyPair::fromSecret(TWO_MOD_Q(), false);
+    auto keypair2 = ElGamalKeyPair::fromSecret(*rand_q(), false);
+    const auto &key1 = *keypair1->getPublicKey();
+    const auto &key2 = *keypair2->getPublicKey();
+    PrecomputeBufferContext::initialize(key1, 2);
+    PrecomputeBufferContext::start();
+    PrecomputeBufferContext::initialize(key2, 1);
+    PrecomputeBufferContext::start();
+
+    // Act
+    // initializing the second election does not evict the first
+    auto buffer1 = PrecomputeBufferContext::getBuffer(key1);
+    auto buffer2 = PrecomputeBufferContext::getBuffer(key2);
+    REQUIRE(buffer1 != nullptr);
+    REQUIRE(buffer2 != nullptr);
+    CHECK(buffer1->getCurrentQueueSize() == 2);
+    CHECK(buffer2->getCurrentQueueSize() == 1);
+
+    // Assert
+    // values are only popped from the buffer of the requested key
+    auto quad = PrecomputeBufferContext::popTwoTriplesAndAQuadruple(key2);
+    REQUIRE((quad.has_value() && quad.value() != nullptr));
+    auto triple = quad.value()->get_triple1();
+    CHECK((*triple->get_pubkey_to_exp() == *pow_mod_p(key2, *triple->get_exp())));
+    auto empty = PrecomputeBufferContext::popTwoTriplesAndAQuadruple(key2);
+    CHECK((!empty.has_value() || empty.value() == nullptr));
+    CHECK(buffer1->getCurrentQueueSize() == 2);
+
+    auto unknown = ElGamalKeyPair::fromSecret(*rand_q(), false);
+    CHECK(PrecomputeBufferContext::getBuffer(*unknown->getPublicKey()) == nullptr);
+    CHECK(!PrecomputeBufferContext::popTriple(*unknown->getPublicKey()).has_value());
+
+    PrecomputeBufferContext::clear(key2);
+    CHECK(PrecomputeBufferContext::getBuffer(key2) == nullptr);
+    CHECK(PrecomputeBufferContext::getBuffer(key1) != nullptr);
+    PrecomputeBufferContext::clear();
+    CHECK(PrecomputeBufferContext::getBuffer(key1) == nullptr);
+}
@@ -0,0 +1,325 @@
+#include "generators/ballot.hpp"
+#include "generators/election.hpp"
+#include "generators/manifest.hpp"
+#include "utils/constants.hpp"
+
+#include <doctest/doctest.h>
+#include <electionguard/ballot.hpp>
+#include <electionguard/election.hpp>
+#include <electionguard/encrypt.hpp>
+#include <electionguard/manifest.hpp>
+#include <electionguard/tally.hpp>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <sstream>
+
+using namespace electionguard;
+using namespace electionguard::tools::generators;
+using namespace std;
+
+static vector<unique_ptr<PlaintextBallot>> getPlaintextBallots(const InternalManifest &manifest,
+                                                               uint64_t count)
+{
+    vector<unique_ptr<PlaintextBallot>> ballots;
+    for (uint64_t i = 0; i < count; i++) {
+        vector<unique_ptr<PlaintextBallotContest>> contests;
+        for (const auto &contest : manifest.getContests()) {
+            contests.push_back(BallotGenerator::contestFrom(contest.get(), i % 2));
+        }
+        ballots.push_back(make_unique<PlaintextBallot>(
+          "ballot-" + to_string(i), manifest.getBallotStyles().at(0).get().getObjectId(),
+          move(contests)));
+    }
+    return ballots;
+}
+
+static vector<unique_ptr<CiphertextBallot>>
+getCiphertextBallots(const vector<unique_ptr<PlaintextBallot>> &plaintexts,
+                     const InternalManifest &manifest, const CiphertextElectionContext &context)
+{
+    vector<reference_wrapper<const PlaintextBallot>> batch;
+    for (const auto &plaintext : plaintexts) {
+        batch.push_back(*plaintext);
+    }
+    return encryptBallots(batch, manifest, context, TWO_MOD_Q(), 0UL, false);
+}
+
+TEST_CASE("CiphertextTally accumulates the votes of the cast ballots")
+{
+    // Arrange
+    auto secret = ElementModQ::fromHex(a_fixed_secret);
+    auto keypair = ElGamalKeyPair::fromSecret(*secret);
+    auto manifest = ManifestGenerator::getJeffersonCountyManifest_Minimal();
+    auto internal = make_unique<InternalManifest>(*manifest);
+    auto context = ElectionGenerator::getFakeContext(*internal, *keypair->getPublicKey());
+
+    auto plaintexts = getPlaintextBallots(*internal, 20);
+    auto ciphertexts = getCiphertextBallots(plaintexts, *internal, *context);
+
+    // spoil the last ballot so its votes are not counted
+    map<string, uint64_t> expected;
+    vector<reference_wrapper<const CiphertextBallot>> batch;
+    for (size_t i = 0; i < ciphertexts.size(); i++) {
+        if (i + 1 == ciphertexts.size()) {
+            ciphertexts[i]->spoil();
+        } else {
+            ciphertexts[i]->cast();
+            for (const auto &contest : plaintexts[i]->getContests()) {
+                for (const auto &selection : contest.get().getSelections()) {
+                    expected[selection.get().getObjectId()] += selection.get().getVote();
+                }
+            }
+        }
+        batch.push_back(*ciphertexts[i]);
+    }
+
+    CiphertextTally tally("tally", *internal, *context);
+
+    // Act
+    auto results = tally.accumulate(batch);
+
+    // Assert
+    for (auto result : results) {
+        CHECK(result == true);
+    }
+    CHECK(tally.getCastBallotIds().size() == ciphertexts.size() - 1);
+    CHECK(tally.getSpoiledBallotIds().size() == 1);
+    CHECK(tally.hasBallot(ciphertexts.back()->getObjectId()));
+
+    auto selections = tally.getSelections();
+    auto selectionIds = tally.getSelectionIds();
+    REQUIRE(selections.size() == selectionIds.size());
+    REQUIRE(!selections.empty());
+    for (size_t i = 0; i < selections.size(); i++) {
+        const auto &selection = *selections[i];
+        CHECK(selection.getObjectId() == selectionIds[i]);
+        CHECK(selection.getCiphertext()->decrypt(*secret) == expected[selection.getObjectId()]);
+        if (i > 0 && selections[i - 1]->getContestId() == selection.getContestId()) {
+            CHECK(selections[i - 1]->getSequenceOrder() < selection.getSequenceOrder());
+        }
+    }
+}
+
+TEST_CASE("CiphertextTally batch accumulation matches adding the ciphertexts one by one")
+{
+    // Arrange
+    auto secret = ElementModQ::fromHex(a_fixed_secret);
+    auto keypair = ElGamalKeyPair::fromSecret(*secret);
+    auto manifest = ManifestGenerator::getJeffersonCountyManifest_Minimal();
+    auto internal = make_unique<InternalManifest>(*manifest);
+    auto context = ElectionGenerator::getFakeContext(*internal, *keypair->getPublicKey());
+
+    auto plaintexts = getPlaintextBallots(*internal, 6);
+    auto ciphertexts = getCiphertextBallots(plaintexts, *internal, *context);
+
+    vector<reference_wrapper<const CiphertextBallot>> batch;
+    for (const auto &ciphertext : ciphertexts) {
+        ciphertext->cast();
+        batch.push_back(*ciphertext);
+    }
+
+    CiphertextTally batched("batched", *internal, *context);
+    CiphertextTally single("single", *internal, *context);
+
+    // Act
+    batched.accumulate(batch, true);
+    for (const auto &ciphertext : ciphertexts) {
+        CHECK(single.accumulate(*ciphertext, true));
+    }
+
+    // Assert
+    map<string, unique_ptr<ElGamalCiphertext>> sums;
+    for (const auto &ciphertext : ciphertexts) {
+        for (const auto &contest : ciphertext->getContests()) {
+            for (const auto &selection : contest.get().getSelections()) {
+                if (selection.get().getIsPlaceholder()) {
+                    continue;
+                }
+                auto &sum = sums[selection.get().getObjectId()];
+                sum = sum == nullptr ? selection.get().getCiphertext()->clone()
+                                     : sum->elgamalAdd(*selection.get().getCiphertext());
+            }
+        }
+    }
+
+    auto batchedSelections = batched.getSelections();
+    auto singleSelections = single.getSelections();
+    REQUIRE(batchedSelections.size() == singleSelections.size());
+    for (size_t i = 0; i < batchedSelections.size(); i++) {
+        const auto &sum = sums[batchedSelections[i]->getObjectId()];
+        REQUIRE(sum != nullptr);
+        CHECK(*batchedSelections[i]->getCiphertext()->getPad() == *sum->getPad());
+        CHECK(*batchedSelections[i]->getCiphertext()->getData() == *sum->getData());
+        CHECK(*singleSelections[i]->getCiphertext()->getPad() == *sum->getPad());
+        CHECK(*singleSelections[i]->getCiphertext()->getData() == *sum->getData());
+    }
+}
+
+TEST_CASE("CiphertextTally rejects duplicate and unknown ballots")
+{
+    // Arrange
+    auto secret = ElementModQ::fromHex(a_fixed_secret);
+    auto keypair = ElGamalKeyPair::fromSecret(*secret);
+    auto manifest = ManifestGenerator::getJeffersonCountyManifest_Minimal();
+    auto internal = make_unique<InternalManifest>(*manifest);
+    auto context = ElectionGenerator::getFakeContext(*internal, *keypair->getPublicKey());
+
+    auto plaintexts = getPlaintextBallots(*internal, 2);
+    auto ciphertexts = getCiphertextBallots(plaintexts, *internal, *context);
+    ciphertexts[0]->cast();
+
+    CiphertextTally tally("tally", *internal, *context);
+
+    // Act
+    auto results = tally.accumulate({*ciphertexts[0], *ciphertexts[0], *ciphertexts[1]});
+
+    // Assert
+    // the repeated ballot is rejected and a ballot that is not cast, spoiled
+    // or challenged is never added
+    CHECK(results == vector<bool>{true, false, false});
+    CHECK(tally.accumulate(*ciphertexts[0]) == false);
+    CHECK(tally.hasBallot(ciphertexts[0]->getObjectId()));
+    CHECK(tally.hasBallot(ciphertexts[1]->getObjectId()) == false);
+    CHECK(tally.getCastBallotIds().size() == 1);
+}
+
+static void checkSameTotals(const CiphertextTally &expected, const CiphertextTally &actual)
+{
+    auto expectedSelections = expected.getSelections();
+    auto actualSelections = actual.getSelections();
+    REQUIRE(expectedSelections.size() == actualSelections.size());
+    for (size_t i = 0; i < expectedSelections.size(); i++) {
+        CHECK(actualSelections[i]->getObjectId() == expectedSelections[i]->getObjectId());
+        CHECK(*actualSelections[i]->getCiphertext()->getPad() ==
+              *expectedSelections[i]->getCiphertext()->getPad());
+        CHECK(*actualSelections[i]->getCiphertext()->getData() ==
+              *expectedSelections[i]->getCiphertext()->getData());
+    }
+}
+
+TEST_CASE("CiphertextTally streamed from json lines matches the in memory tally")
+{
+    // Arrange
+    auto secret = ElementModQ::fromHex(a_fixed_secret);
+    auto keypair = ElGamalKeyPair::fromSecret(*secret);
+    auto manifest = ManifestGenerator::getJeffersonCountyManifest_Minimal();
+    auto internal = make_unique<InternalManifest>(*manifest);
+    auto context = ElectionGenerator::getFakeContext(*internal, *keypair->getPublicKey());
+
+    auto plaintexts = getPlaintextBallots(*internal, 6);
+    auto ciphertexts = getCiphertextBallots(plaintexts, *internal, *context);
+
+    vector<reference_wrapper<const CiphertextBallot>> batch;
+    stringstream lines;
+    for (size_t i = 0; i < ciphertexts.size(); i++) {
+        if (i == 1) {
+            ciphertexts[i]->challenge();
+        } else {
+            ciphertexts[i]->cast();
+        }
+        batch.push_back(*ciphertexts[i]);
+        lines << ciphertexts[i]->toJson() << "\n";
+    }
+    // a repeated ballot, a blank line and a line that is not a ballot are skipped
+    lines << ciphertexts[0]->toJson() << "\n\n{\"object_id\": \n";
+
+    CiphertextTally expected("expected", *internal, *context);
+    expected.accumulate(batch, true);
+    CiphertextTally streamed("streamed", *internal, *context);
+
+    // Act
+    // a tiny buffer holds a single ballot at a time
+    auto added = streamed.accumulateJsonLines(lines, 1UL);
+
+    // Assert
+    CHECK(added == ciphertexts.size());
+    CHECK(streamed.getCastBallotIds().size() == ciphertexts.size() - 1);
+    CHECK(streamed.getChallengedBallotIds().size() == 1);
+    checkSameTotals(expected, streamed);
+}
+
+TEST_CASE("CiphertextTally streamed from msgpack and ballot files matches the in memory tally")
+{
+    // Arrange
+    auto secret = ElementModQ::fromHex(a_fixed_secret);
+    auto keypair = ElGamalKeyPair::fromSecret(*secret);
+    auto manifest = ManifestGenerator::getJeffersonCountyManifest_Minimal();
+    auto internal = make_unique<InternalManifest>(*manifest);
+    auto context = ElectionGenerator::getFakeContext(*internal, *keypair->getPublicKey());
+
+    auto plaintexts = getPlaintextBallots(*internal, 4);
+    auto ciphertexts = getCiphertextBallots(plaintexts, *internal, *context);
+
+    vector<reference_wrapper<const CiphertextBallot>> batch;
+    for (const auto &ciphertext : ciphertexts) {
+        ciphertext->cast();
+        batch.push_back(*ciphertext);
+    }
+
+    CiphertextTally expected("expected", *internal, *context);
+    expected.accumulate(batch, true);
+
+    stringstream msgpack;
+    for (const auto &ciphertext : ciphertexts) {
+        auto bytes = ciphertext->toMsgPack();
+        msgpack.write(reinterpret_cast<const char *>(bytes.data()),
+                      static_cast<streamsize>(bytes.size()));
+    }
+
+    auto directory = filesystem::temp_directory_path() / "electionguard_test_tally_files";
+    filesystem::remove_all(directory);
+    filesystem::create_directories(directory);
+    ofstream(directory / "ballot-0.json") << ciphertexts[0]->toJson();
+    {
+        ofstream file(directory / "ballots-1.msgpack", ios::binary);
+        auto bytes = ciphertexts[1]->toMsgPack();
+        file.write(reinterpret_cast<const char *>(bytes.data()),
+                   static_cast<streamsize>(bytes.size()));
+    }
+    ofstream(directory / "ballots-2.jsonl")
+      << ciphertexts[2]->toJson() << "\n"
+      << ciphertexts[3]->toJson() << "\n";
+    ofstream(directory / "readme.txt") << "not a ballot";
+
+    CiphertextTally fromMsgPack("msgpack", *internal, *context);
+    CiphertextTally fromFiles("files", *internal, *context);
+
+    // Act
+    auto addedFromMsgPack = fromMsgPack.accumulateMsgPack(msgpack);
+    auto addedFromFiles = fromFiles.accumulateFiles(directory.string());
+    filesystem::remove_all(directory);
+
+    // Assert
+    CHECK(addedFromMsgPack == ciphertexts.size());
+    CHECK(addedFromFiles == ciphertexts.size());
+    checkSameTotals(expected, fromMsgPack);
+    checkSameTotals(expected, fromFiles);
+}
+
+TEST_CASE("CiphertextTally streamed from msgpack rejects a value larger than the buffer")
+{
+    // Arrange
+    auto secret = ElementModQ::fromHex(a_fixed_secret);
+    auto keypair = ElGamalKeyPair::fromSecret(*secret);
+    auto manifest = ManifestGenerator::getJeffersonCountyManifest_Minimal();
+    auto internal = make_unique<InternalManifest>(*manifest);
+    auto context = ElectionGenerator::getFakeContext(*internal, *keypair->getPublicKey());
+    CiphertextTally tally("oversized", *internal, *context);
+
+    // a str 32 header that claims a 4 GiB value followed by nothing
+    stringstream msgpack;
+    msgpack << '\xDB' << '\xFF' << '\xFF' << '\xFF' << '\xFF';
+
+    // Act
+    string error;
+    try {
+        tally.accumulateMsgPack(msgpack, 1024UL);
+    } catch (const invalid_argument &e) {
+        error = e.what();
+    }
+
+    // Assert
+    // the length is rejected before the value is allocated or read
+    CHECK(error.find("larger than the buffer") != string::npos);
+}
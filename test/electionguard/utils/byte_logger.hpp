@@ -12,7 +12,7 @@ using namespace std;
 class ByteLogger
 {
   public:
-    static void print(string msg, uint64_t *bignum, size_t size)
+    static void print(string msg, const uint64_t *bignum, size_t size)
     {
         cout << msg << endl;
         ios cout_state(nullptr);